@@ -9,6 +9,7 @@ class Component {
 private:
     GameObject* owner = nullptr;
     bool active = true;
+    bool tracked = false;   // Registered with the ComponentManager
 
 public:
     // Constructor  destructor
@@ -37,9 +38,13 @@ public:
     void SetOwner(GameObject* gameObject) { owner = gameObject; }
     GameObject* GetOwner() const { return owner; }
 
-    // Active state
+    // Active state (changes are reported to the owner's scene counters)
     bool IsActive() const { return active; }
-    void SetActive(bool isActive) { active = isActive; }
+    void SetActive(bool isActive);
+
+    // ComponentManager registration (called by ComponentManager)
+    bool IsTracked() const { return tracked; }
+    void SetTracked(bool isTracked) { tracked = isTracked; }
 
     // Virtual update method - override in derived components
     virtual void Update(float deltaTime) {}
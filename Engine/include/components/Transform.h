@@ -72,6 +72,13 @@ struct Vector3 {
     static const Vector3 Forward;
 };
 
+// Plain data image of a Transform's local state (used by ComponentSchema)
+struct TransformData {
+    Vector3 position;
+    Vector3 rotation;
+    Vector3 scale = Vector3::One;
+};
+
 class Transform : public Component {
 private:
     Vector3 position;
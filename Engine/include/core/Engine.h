@@ -1,15 +1,23 @@
 #pragma once
 
 #include "SceneManager.h"
+#include "FramePacer.h"
+#include "FramePipeline.h"
+#include "FrameTimeHistogram.h"
 #include "../systems/UpdateSystem.h"
 #include "../systems/ComponentManager.h"
 #include "../memory/MemoryManager.h"
 #include "../factories/ComponentFactory.h"
 #include "../factories/GameObjectFactory.h"
+#include "../factories/TemplateHotReloader.h"
+#include "../io/ParseCache.h"
+#include "../io/AssetArchive.h"
+#include "../io/SharedSceneView.h"
 #include <chrono>
 #include <thread>
 #include <atomic>
 #include <string>
+#include <memory>
 
 // Engine configuration
 struct EngineConfig {
@@ -26,11 +34,52 @@ struct EngineConfig {
     float fixedUpdateRate = 60.0f;
     bool enableVSync = true;
 
+    // Headless simulation (dedicated servers, batch runs): frames run back to
+    // back with a fixed delta time, without pacing, per-frame statistics or
+    // logging. Simulated time is then independent of the machine's speed.
+    bool headless = false;
+    float headlessDeltaTime = 0.0f;     // 0: 1 / fixedUpdateRate
+
     // Engine behavior
     bool pauseWhenUnfocused = true;
     bool enablePerformanceLogging = false;
     bool enableMemoryLogging = false;
 
+    // Content loading
+    bool useParseCache = false;
+    std::string parseCacheDirectory;    // Empty: entries are stored next to the sources
+
+    // Saved scene files are LZ-compressed (loading detects either form)
+    bool compressSceneFiles = false;
+
+    // Pack file opened at startup; its templates are registered right away
+    std::string assetArchivePath;
+
+    // Template hot reload (off while the directory is empty); live instances
+    // are patched at the end of the frame within this budget
+    std::string hotReloadDirectory;
+    size_t hotReloadObjectsPerFrame = 1024;
+    size_t hotReloadMicrosecondsPerFrame = 1000;
+
+    // Shared-memory mirror of the current scene for external tools (off while
+    // the name is empty); see SharedScenePublisher
+    std::string sharedSceneViewName;
+    size_t sharedSceneViewCapacity = 65536;
+    size_t sharedSceneViewIntervalFrames = 1;
+
+    // Pipelined frames: at the frame boundary the scene is captured into a
+    // snapshot and the downstream work (shared view, statistics, game-defined
+    // stages) runs on these workers while the next frame simulates. Results
+    // lag one frame.
+    bool pipelineFrames = false;
+    size_t pipelineWorkerCount = 2;
+
+    // Frame time histograms: length of the sliding window, and the frame
+    // time over which a frame counts as a spike (milliseconds, 0: one target
+    // frame period)
+    size_t frameTimeWindowFrames = 600;
+    float frameTimeBudget = 0.0f;
+
     // Debug configuration
     bool enableDebugOutput = true;
     bool enableStatistics = true;
@@ -38,6 +87,15 @@ struct EngineConfig {
     EngineConfig() = default;
 };
 
+// Phases with a frame time histogram (Engine::GetFrameTimes)
+enum class FramePhase {
+    Update,
+    LateUpdate,
+    FixedUpdate,
+    Frame,          // The whole frame's work, without pacing
+    Count
+};
+
 // Engine statistics
 struct EngineStats {
     // Frame timing
@@ -51,6 +109,24 @@ struct EngineStats {
     float lateUpdateTime = 0.0f;
     float fixedUpdateTime = 0.0f;
 
+    // Frame time percentiles over the sliding window, refreshed every 60
+    // frames (Engine::GetFrameTimes reads them current from any thread)
+    FrameTimeSummary frameTimes;
+    FrameTimeSummary updateTimes;
+    FrameTimeSummary lateUpdateTimes;
+    FrameTimeSummary fixedUpdateTimes;
+    size_t frameBudgetSpikes = 0;       // Frames over budget, whole run
+
+    // Frame pipeline (milliseconds; zero when not pipelined)
+    float snapshotExtractTime = 0.0f;
+    float pipelineWaitTime = 0.0f;
+
+    // Frame pacing error (microseconds late, recent frames)
+    float pacingErrorP50 = 0.0f;
+    float pacingErrorP99 = 0.0f;
+    float pacingErrorMax = 0.0f;
+    size_t missedFrameDeadlines = 0;
+
     // System statistics
     size_t totalGameObjects = 0;
     size_t activeGameObjects = 0;
@@ -69,11 +145,24 @@ struct EngineStats {
     float totalRunTime = 0.0f;
     size_t totalFrames = 0;
 
+    // Simulated time (sum of frame delta times) and its rate in simulated
+    // seconds per wall-clock second since the run started
+    double simulatedTime = 0.0;
+    float simulationSpeed = 0.0f;
+
     void Reset() {
         *this = EngineStats();
     }
 };
 
+// Outcome of Engine::RunFrames
+struct HeadlessRunStats {
+    size_t frames = 0;
+    double simulatedSeconds = 0.0;
+    double wallSeconds = 0.0;
+    double simulatedSecondsPerWallSecond = 0.0;
+};
+
 enum class EngineState {
     Uninitialized,
     Initializing,
@@ -98,18 +187,38 @@ private:
     EngineConfig config;
     EngineStats stats;
 
+    // Template parse cache (when enabled in the config)
+    std::unique_ptr<ParseCache> parseCache;
+
+    // Template file watcher (when enabled in the config)
+    std::unique_ptr<TemplateHotReloader> hotReloader;
+
+    // Content pack (when set in the config)
+    std::unique_ptr<AssetArchive> assetArchive;
+
+    // Shared scene view (when named in the config)
+    std::unique_ptr<SharedScenePublisher> sharedSceneView;
+
+    // Downstream frame stages (when pipelined in the config); the statistics
+    // stage leaves its counts here, written while the next frame runs
+    std::unique_ptr<FramePipeline> framePipeline;
+    std::atomic<size_t> pipelinedObjectCount{ 0 };
+    std::atomic<size_t> pipelinedActiveCount{ 0 };
+
     // Timing
     std::chrono::high_resolution_clock::time_point startTime;
     std::chrono::high_resolution_clock::time_point lastFrameTime;
     float deltaTime = 0.0f;
     float fixedDeltaTime = 0.0f;
+    std::chrono::high_resolution_clock::time_point runStartTime;
 
     // Frame rate control
-    std::chrono::duration<float> targetFrameTime;
+    FramePacer framePacer;
 
     // Performance tracking
     std::vector<float> frameTimeHistory;
     size_t frameTimeHistorySize = 60; // Track last 60 frames
+    FrameTimeRecorder phaseTimes[static_cast<size_t>(FramePhase::Count)];
 
     // Singleton instance
     static Engine* instance;
@@ -135,6 +244,10 @@ public:
     void Resume();
     void Shutdown();
 
+    // Run 'frameCount' frames back to back (or until Stop) and return. Meant
+    // for headless configs; with pacing enabled the frames are paced as usual.
+    HeadlessRunStats RunFrames(size_t frameCount);
+
     // Engine state queries
     EngineState GetState() const { return state.load(); }
     bool IsRunning() const { return state.load() == EngineState::Running; }
@@ -151,6 +264,9 @@ public:
     MemoryManager& GetMemoryManager() { return memoryManager; }
     ComponentFactory& GetComponentFactory() { return componentFactory; }
     GameObjectFactory& GetGameObjectFactory() { return gameObjectFactory; }
+    AssetArchive* GetAssetArchive() { return assetArchive.get(); }
+    SharedScenePublisher* GetSharedSceneView() { return sharedSceneView.get(); }
+    FramePipeline* GetFramePipeline() { return framePipeline.get(); }
 
     // High-level game development API
     Scene* CreateScene(const std::string& sceneName);
@@ -175,6 +291,12 @@ public:
     float GetFPS() const { return stats.currentFPS; }
     float GetRunTime() const { return stats.totalRunTime; }
 
+    // Frame time histograms (window and whole run); safe to read from any
+    // thread while the engine runs (empty in headless mode)
+    const FrameTimeRecorder& GetFrameTimes(FramePhase phase = FramePhase::Frame) const {
+        return phaseTimes[static_cast<size_t>(phase)];
+    }
+
     // Debug and diagnostics
     void PrintEngineInfo() const;
     void PrintPerformanceStats() const;
@@ -191,6 +313,7 @@ public:
 private:
     // Main loop components
     void MainLoop();
+    void RunFrame();
     void UpdateFrame();
     void CalculateTiming();
     void UpdateStatistics();
@@ -208,6 +331,7 @@ private:
     // Performance tracking
     void TrackFrameTime(float frameTime);
     void CalculateAverages();
+    FrameTimeRecorder& GetPhaseTimes(FramePhase phase) { return phaseTimes[static_cast<size_t>(phase)]; }
 
     // Event handling
     std::vector<EngineEvent> startCallbacks;
@@ -252,6 +376,7 @@ namespace EngineUtils {
     EngineConfig GetHighPerformanceConfig();
     EngineConfig GetDebugConfig();
     EngineConfig GetLowMemoryConfig();
+    EngineConfig GetHeadlessConfig();
 
     // Convenience functions
     void RunFor(float seconds);
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <chrono>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Pacing error summary over the recent history (microseconds a frame
+// started after its deadline)
+struct FramePacingStats {
+    size_t frames = 0;
+    size_t missedDeadlines = 0;     // Frames that overran a whole period
+    float p50 = 0.0f;
+    float p95 = 0.0f;
+    float p99 = 0.0f;
+    float max = 0.0f;
+    float spinWindow = 0.0f;        // Current spin window (microseconds)
+};
+
+// FramePacer: Holds the frame loop to a target rate with absolute deadlines.
+// Each wait sleeps on the monotonic clock (clock_nanosleep TIMER_ABSTIME on
+// POSIX) until shortly before the deadline, then spins the rest. The spin
+// window tracks how late the OS wakes us, so it stays as short as the
+// machine allows. Deadlines advance by exactly one period, so small wake-up
+// errors don't accumulate; a frame that overruns by more than a period
+// restarts the schedule from now instead of bursting to catch up.
+class FramePacer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+private:
+    Clock::duration period{ 0 };
+    Clock::time_point deadline;
+    bool scheduled = false;
+
+    // Spin window, adapted to the observed sleep overshoot
+    Clock::duration minSpin = std::chrono::microseconds(50);
+    Clock::duration maxSpin = std::chrono::microseconds(2000);
+    double averageOvershoot = 200.0;    // Microseconds
+
+    // Pacing error history (microseconds, ring buffer)
+    std::vector<float> errors;
+    size_t errorCursor = 0;
+    size_t errorCount = 0;
+    size_t frameCount = 0;
+    size_t missedDeadlines = 0;
+
+public:
+    explicit FramePacer(size_t historySize = 600);
+
+    // Frames per second (0 or less disables pacing); restarts the schedule
+    void SetTargetFrameRate(float framesPerSecond);
+    float GetTargetFrameRate() const;
+
+    // Bounds of the adaptive spin window
+    void SetSpinWindow(std::chrono::microseconds minimum, std::chrono::microseconds maximum);
+
+    // Forget the schedule (after a pause); the next wait starts a new one
+    void Reset() { scheduled = false; }
+
+    // Block until the next frame's deadline
+    void WaitForNextFrame();
+
+    FramePacingStats GetStats() const;
+    void ClearStats();
+
+private:
+    void SleepUntil(Clock::time_point wakeTime);
+    void RecordError(float microseconds);
+};
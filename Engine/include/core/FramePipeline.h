@@ -0,0 +1,122 @@
+#pragma once
+
+#include "../components/Transform.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <future>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+// Forward declarations
+class Scene;
+class ThreadPool;
+
+// Per-object state of one finished frame, extracted at the frame boundary.
+// Downstream stages read it while the next frame simulates, so it owns
+// copies of everything (no pointers into the scene).
+struct FrameSnapshot {
+    uint64_t frame = 0;
+    float deltaTime = 0.0f;
+
+    // Object columns, in scene order
+    std::vector<uint64_t> ids;
+    std::vector<Vector3> positions;     // Local Transform position (zero without one)
+    std::vector<uint8_t> active;
+    std::vector<uint32_t> tagIndices;   // Into 'tags'
+    std::vector<std::string> tags;
+    size_t activeCount = 0;
+
+    size_t GetObjectCount() const { return ids.size(); }
+    const std::string& GetTag(size_t objectIndex) const { return tags[tagIndices[objectIndex]]; }
+
+    // Refill from 'scene' (keeps the column allocations). Large scenes are
+    // split across the pool, with the calling thread taking a share.
+    static constexpr size_t MinParallelObjects = 16384;
+    void Capture(const Scene& scene, uint64_t frameNumber, float frameDeltaTime, ThreadPool* pool = nullptr);
+
+private:
+    // Range of objects captured by one task, with its own tag table
+    struct CaptureChunk {
+        std::vector<std::string> tags;
+        std::unordered_map<std::string, uint32_t> tagLookup;
+        std::vector<uint32_t> remap;
+        size_t activeCount = 0;
+        size_t nullCount = 0;
+    };
+
+    std::unordered_map<std::string, uint32_t> tagLookup;
+    std::vector<CaptureChunk> chunks;
+};
+
+// Timing of the last submitted frame (milliseconds)
+struct FramePipelineStats {
+    float extractTime = 0.0f;       // Snapshot capture on the calling thread
+    float waitTime = 0.0f;          // Calling thread blocked on the previous frame's stages
+    float stageTime = 0.0f;         // Slowest stage of the previous frame
+    size_t framesSubmitted = 0;
+    size_t framesCompleted = 0;
+};
+
+// FramePipeline: Runs a frame's downstream work (publishing, statistics,
+// and whatever game code registers: culling, replication, ...) on worker
+// threads while the main thread simulates the next frame.
+//
+// SubmitFrame captures the scene into one of two snapshots, waits for the
+// stages still working on the previous frame, then hands the new snapshot to
+// every stage in parallel. At most one frame is in flight, so stage results
+// lag the simulation by one frame and the snapshot being written is never
+// one a stage is reading.
+class FramePipeline {
+public:
+    using Stage = std::function<void(const FrameSnapshot&)>;
+
+private:
+    struct StageEntry {
+        std::string name;
+        Stage function;
+        float runTime = 0.0f;       // Written by the worker
+        float lastTime = 0.0f;      // Copied from runTime once the frame completed
+    };
+
+    std::vector<StageEntry> stages;
+    FrameSnapshot snapshots[2];
+    size_t writeIndex = 0;
+
+    std::unique_ptr<ThreadPool> workers;
+    std::vector<std::future<void>> inFlight;
+    ThreadPool* extractPool = nullptr;
+
+    FramePipelineStats stats;
+
+public:
+    explicit FramePipeline(size_t workerCount = 2);
+    ~FramePipeline();
+
+    // Delete copy operations (owns worker threads)
+    FramePipeline(const FramePipeline&) = delete;
+    FramePipeline& operator=(const FramePipeline&) = delete;
+
+    // Stages run in parallel with each other and must only read the snapshot
+    // (or state they own). Adding or removing waits for the frame in flight.
+    void AddStage(const std::string& name, Stage stage);
+    bool RemoveStage(const std::string& name);
+    size_t GetStageCount() const { return stages.size(); }
+
+    // Pool for capturing snapshots (optional); it should be idle at the frame
+    // boundary, e.g. the update system's
+    void SetThreadPool(ThreadPool* pool) { extractPool = pool; }
+
+    // Call at the frame boundary, after the frame's last mutation
+    void SubmitFrame(const Scene& scene, uint64_t frameNumber, float deltaTime);
+
+    // Block until the frame in flight has gone through every stage
+    void Flush();
+
+    const FramePipelineStats& GetStats() const { return stats; }
+
+    // Milliseconds the named stage took on the last completed frame
+    float GetStageTime(const std::string& name) const;
+};
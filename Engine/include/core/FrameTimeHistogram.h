@@ -0,0 +1,122 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Percentiles of a set of recorded times (milliseconds)
+struct FrameTimeSummary {
+    size_t count = 0;
+    size_t spikes = 0;              // Samples over the recorder's spike threshold
+    float mean = 0.0f;
+    float p50 = 0.0f;
+    float p90 = 0.0f;
+    float p99 = 0.0f;
+    float p999 = 0.0f;
+    float max = 0.0f;
+};
+
+// FrameTimeHistogram: Log-linear (HDR-style) histogram of microsecond times.
+// Values below 128us get a bucket each; above that every power of two is
+// split into 64 buckets, so a reported percentile is within 1/64 (~1.6%) of
+// the recorded time. Times past MaxValue (~134s) land in the last bucket.
+// Plain values, the copy a FrameTimeRecorder hands to readers.
+class FrameTimeHistogram {
+public:
+    static constexpr uint64_t LinearBuckets = 128;
+    static constexpr uint64_t SubBuckets = 64;
+    static constexpr uint64_t MaxValue = (uint64_t(1) << 27) - 1;
+    static constexpr size_t BucketCount = 128 + 20 * 64;
+
+    static size_t GetBucketIndex(uint64_t microseconds);
+    static uint64_t GetBucketUpperBound(size_t index);
+
+private:
+    std::vector<uint64_t> counts;
+    uint64_t total = 0;
+    uint64_t spikes = 0;
+    uint64_t maxValue = 0;
+    uint64_t sum = 0;
+
+    friend class FrameTimeRecorder;
+
+public:
+    FrameTimeHistogram();
+
+    void Record(uint64_t microseconds);
+    void Merge(const FrameTimeHistogram& other);
+    void Clear();
+
+    uint64_t GetCount() const { return total; }
+    uint64_t GetMax() const { return maxValue; }
+
+    // Smallest recorded time (microseconds, bucket precision) that 'fraction'
+    // of the samples are at or below
+    uint64_t GetValueAtPercentile(double fraction) const;
+
+    FrameTimeSummary Summarize() const;
+};
+
+// FrameTimeRecorder: Frame times of one phase, recorded by the engine thread
+// and readable from any other without locks. Keeps a histogram over the
+// whole run and a sliding window made of Slices sub-histograms; when the
+// current slice is full the oldest one is cleared and reused, so the window
+// spans between (Slices - 1) and Slices slices' worth of frames.
+//
+// One writer only. Counters are atomics, and a sequence number (odd while
+// the writer is inside Record) lets a reader detect that its copy overlapped
+// a write and retry, so a copy is never torn.
+class FrameTimeRecorder {
+public:
+    static constexpr size_t Slices = 8;
+
+private:
+    // Per histogram: bucket counts, then total, spikes, max and sum
+    static constexpr size_t TotalCell = FrameTimeHistogram::BucketCount;
+    static constexpr size_t SpikesCell = TotalCell + 1;
+    static constexpr size_t MaxCell = TotalCell + 2;
+    static constexpr size_t SumCell = TotalCell + 3;
+    static constexpr size_t Stride = TotalCell + 4;
+
+    // Histogram 0 is the run, 1..Slices the window
+    std::vector<std::atomic<uint64_t>> cells;
+    std::atomic<uint64_t> sequence{ 0 };
+
+    // Writer state (settings are atomic so another thread may change them)
+    std::atomic<uint64_t> spikeThreshold{ 0 };     // Microseconds, 0: no spike counting
+    std::atomic<size_t> sliceFrames{ 75 };
+    size_t currentSlice = 0;
+    size_t sliceCount = 0;
+
+public:
+    FrameTimeRecorder();
+
+    // Delete copy operations (shared with reader threads)
+    FrameTimeRecorder(const FrameTimeRecorder&) = delete;
+    FrameTimeRecorder& operator=(const FrameTimeRecorder&) = delete;
+
+    // Sliding window length in frames (rounded to whole slices)
+    void SetWindowFrames(size_t frames);
+    size_t GetWindowFrames() const { return sliceFrames.load(std::memory_order_relaxed) * Slices; }
+
+    // Samples above this count as spikes (0 disables)
+    void SetSpikeThreshold(float milliseconds);
+
+    // Writer thread only
+    void Record(float milliseconds);
+    void Reset();
+
+    // Any thread. Fails (leaving 'out' cleared) only if the writer kept
+    // overlapping the copy for every attempt.
+    bool ReadRun(FrameTimeHistogram& out, int attempts = 64) const;
+    bool ReadWindow(FrameTimeHistogram& out, int attempts = 64) const;
+
+    FrameTimeSummary GetRunSummary() const;
+    FrameTimeSummary GetWindowSummary() const;
+
+private:
+    void Bump(size_t histogram, size_t bucket, uint64_t microseconds, bool spike);
+    void ClearHistogram(size_t histogram);
+    bool Read(FrameTimeHistogram& out, size_t first, size_t count, int attempts) const;
+};
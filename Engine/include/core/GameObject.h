@@ -4,27 +4,44 @@
 #include <memory>
 #include <string>
 #include <typeinfo>
+#include <typeindex>
 #include <algorithm>
+#include <atomic>
 #include <iostream>
 
 // Forward declaration to avoid circular dependency
 class Behavior;
 
+// Object and component counts of a scene, kept current by its GameObjects as
+// they are added, removed and toggled (atomic: behaviors may toggle objects
+// from update worker threads)
+struct SceneCounters {
+    std::atomic<size_t> objects{ 0 };
+    std::atomic<size_t> activeObjects{ 0 };
+    std::atomic<size_t> components{ 0 };
+    std::atomic<size_t> activeComponents{ 0 };     // Active components of active objects
+};
+
 class GameObject {
 private:
-    static size_t nextId;
+    static std::atomic<size_t> nextId;
     size_t id;
     std::string tag;
     std::string name;  // Added name field
     std::vector<std::unique_ptr<Component>> components;
     bool active = true;
+    size_t templateId = 0;  // Template this object was spawned from (0 = none)
+    SceneCounters* counters = nullptr;  // Owning scene's counters (not owned)
 
 public:
     // Constructor - added name parameter
     GameObject(const std::string& objectTag = "", const std::string& objectName = "");
 
+    // Constructor with a pre-reserved ID (see ReserveIds)
+    GameObject(size_t objectId, const std::string& objectTag, const std::string& objectName = "");
+
     // Destructor
-    ~GameObject() = default;
+    ~GameObject();
 
     // Move constructor and assignment (for efficiency)
     GameObject(GameObject&& other) noexcept;
@@ -37,6 +54,9 @@ public:
     // ===== ID, NAME, AND TAG MANAGEMENT =====
     size_t GetId() const { return id; }
 
+    // Reserve a block of consecutive IDs (thread-safe); returns the first one
+    static size_t ReserveIds(size_t count) { return nextId.fetch_add(count, std::memory_order_relaxed); }
+
     const std::string& GetTag() const { return tag; }
     void SetTag(const std::string& newTag) { tag = newTag; }
 
@@ -44,10 +64,21 @@ public:
     const std::string& GetName() const { return name; }
     void SetName(const std::string& newName) { name = newName; }
 
+    // Source template (set by GameObjectBlueprint, used by hot reload)
+    size_t GetTemplateId() const { return templateId; }
+    void SetTemplateId(size_t id) { templateId = id; }
+
     // Active state
     bool IsActive() const { return active; }
     void SetActive(bool isActive);  // Move implementation to .cpp for component notifications
 
+    // Counters this object reports to (set by its Scene; moves its share over)
+    void SetCounters(SceneCounters* sceneCounters);
+    SceneCounters* GetCounters() const { return counters; }
+
+    // Called by Component::SetActive
+    void OnComponentActiveChanged(bool isActive);
+
     // ===== ENHANCED COMPONENT MANAGEMENT =====
 
     template<typename T, typename... Args>
@@ -65,6 +96,7 @@ public:
         // Set the owner reference
         component->SetOwner(this);
         components.push_back(std::move(component));
+        CountComponent(*componentPtr, true);
 
         // Call OnEnable if GameObject is active
         if (active) {
@@ -74,6 +106,14 @@ public:
         return componentPtr;
     }
 
+    // Attach an already constructed component (e.g. from ComponentFactory).
+    // Like AddComponent, an existing component of the same type wins and the
+    // new one is discarded.
+    Component* AttachComponent(std::unique_ptr<Component> component);
+
+    // Component of exactly this dynamic type (for type-erased callers such as schemas)
+    Component* GetComponent(const std::type_index& type);
+
     // Enhanced with Component's RTTI helpers
     template<typename T>
     T* GetComponent() {
@@ -140,6 +180,7 @@ public:
 
         if (it != components.end()) {
             (*it)->OnDestroy();  // Proper cleanup
+            CountComponent(**it, false);
             components.erase(it);
             return true;
         }
@@ -155,6 +196,7 @@ public:
         while (it != components.end()) {
             if ((*it)->IsOfType<T>()) {
                 (*it)->OnDestroy();
+                CountComponent(**it, false);
                 it = components.erase(it);
                 removedCount++;
             }
@@ -168,7 +210,8 @@ public:
     // Remove component by pointer
     bool RemoveComponent(Component* component);
 
-    // Get all components (useful for data-oriented processing)
+    // Get all components (useful for data-oriented processing). Adding or
+    // removing through the mutable list bypasses the scene counters.
     const std::vector<std::unique_ptr<Component>>& GetAllComponents() const {
         return components;
     }
@@ -222,4 +265,24 @@ public:
     // Additional debug methods
     void PrintComponentHierarchy() const;
     void CheckForComponentConflicts() const;
+
+private:
+    // Scene counter bookkeeping
+    void CountComponent(const Component& component, bool added) {
+        if (!counters) return;
+        if (added) {
+            counters->components.fetch_add(1, std::memory_order_relaxed);
+            if (active && component.IsActive()) {
+                counters->activeComponents.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        else {
+            counters->components.fetch_sub(1, std::memory_order_relaxed);
+            if (active && component.IsActive()) {
+                counters->activeComponents.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    size_t CountActiveComponents() const;
 };
\ No newline at end of file
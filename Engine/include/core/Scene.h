@@ -8,9 +8,16 @@
 #include <functional>
 #include <components/Behavior.h>
 
+// Forward declarations
+class GameObjectBlueprint;
+
 class Scene {
 private:
     std::string name;
+
+    // Object and component counts, maintained by the objects themselves
+    // (declared before 'objects', which report to it while being destroyed)
+    SceneCounters counters;
     std::vector<std::unique_ptr<GameObject>> objects;
 
     // Fast lookup maps for performance (Data-Oriented Design)
@@ -53,6 +60,23 @@ public:
     // GameObject addition (for objects created elsewhere)
     void AddGameObject(std::unique_ptr<GameObject> gameObject);
 
+    // Bulk spawning: instantiates 'count' objects from a blueprint into one
+    // contiguous range of GetAllGameObjects(), runs the optional initializer on
+    // each (index 0..count-1), then updates lookups and caches once.
+    // Returns the index of the first spawned object.
+    using SpawnInitializer = std::function<void(GameObject&, size_t)>;
+    size_t SpawnBatch(const GameObjectBlueprint& blueprint, size_t count,
+        const SpawnInitializer& initializer = nullptr);
+
+    // Commit objects built elsewhere (e.g. on worker threads) in the given
+    // order, with the same single-pass indexing as SpawnBatch.
+    // Returns the index of the first added object.
+    size_t AddGameObjects(std::vector<std::unique_ptr<GameObject>> batch);
+
+    // Capacity hints for bulk loading
+    void Reserve(size_t objectCount);
+    void ReserveTag(const std::string& tag, size_t objectCount);
+
     // GameObject removal and destruction
     bool DestroyGameObject(GameObject* gameObject);
     bool DestroyGameObject(size_t id);
@@ -81,9 +105,11 @@ public:
     const std::vector<std::unique_ptr<GameObject>>& GetAllGameObjects() const;
     std::vector<GameObject*> GetActiveGameObjects() const;
 
-    // Scene statistics
+    // Scene statistics (O(1), see SceneCounters)
     size_t GetGameObjectCount() const { return objects.size(); }
-    size_t GetActiveGameObjectCount() const;
+    size_t GetActiveGameObjectCount() const { return counters.activeObjects.load(std::memory_order_relaxed); }
+    size_t GetComponentCount() const { return counters.components.load(std::memory_order_relaxed); }
+    size_t GetActiveComponentCount() const { return counters.activeComponents.load(std::memory_order_relaxed); }
     size_t GetGameObjectCountWithTag(const std::string& tag) const;
 
     // Scene update (called by Engine)
@@ -91,8 +117,8 @@ public:
     void LateUpdate(float deltaTime);
     void FixedUpdate(float fixedDeltaTime);
 
-    // Scene serialization (basic framework)
-    void SaveToFile(const std::string& filepath) const;
+    // Scene serialization (binary format, see serialization/SceneFormat.h)
+    bool SaveToFile(const std::string& filepath) const;
     bool LoadFromFile(const std::string& filepath);
 
     // Utility functions
@@ -109,6 +135,8 @@ private:
     void UpdateLookupMaps(GameObject* gameObject);
     void RemoveFromLookupMaps(GameObject* gameObject);
     void MarkComponentCachesDirty() { componentCachesDirty = true; }
+    void AppendToComponentCaches(GameObject* gameObject) const;
+    void IndexBatch(size_t first);
 
     // Event callbacks
     std::vector<GameObjectEvent> gameObjectCreatedCallbacks;
@@ -0,0 +1,167 @@
+#pragma once
+
+#include "../components/Transform.h"
+#include "../systems/ThreadPool.h"
+#include <unordered_map>
+#include <vector>
+#include <string>
+#include <memory>
+#include <future>
+#include <cstdint>
+
+// Forward declarations
+class Scene;
+class GameObjectFactory;
+struct IOResult;
+
+// Integer cell coordinate on the XZ plane
+struct WorldCellCoord {
+    int x = 0;
+    int z = 0;
+
+    WorldCellCoord() = default;
+    WorldCellCoord(int cellX, int cellZ) : x(cellX), z(cellZ) {}
+
+    bool operator==(const WorldCellCoord& other) const { return x == other.x && z == other.z; }
+    bool operator!=(const WorldCellCoord& other) const { return !(*this == other); }
+};
+
+struct WorldCellCoordHash {
+    size_t operator()(const WorldCellCoord& coord) const {
+        return std::hash<uint64_t>()((static_cast<uint64_t>(static_cast<uint32_t>(coord.x)) << 32) | static_cast<uint32_t>(coord.z));
+    }
+};
+
+// A template instance placed in the world (authoring input for baking)
+struct WorldPlacement {
+    std::string templateName;
+    Vector3 position;
+    Vector3 rotation;
+    Vector3 scale = Vector3::One;
+
+    WorldPlacement() = default;
+    WorldPlacement(const std::string& name, const Vector3& pos,
+        const Vector3& rot = Vector3::Zero, const Vector3& scl = Vector3::One)
+        : templateName(name), position(pos), rotation(rot), scale(scl) {
+    }
+};
+
+// Baked contents of one cell (string table + fixed-size placement records)
+struct WorldCellData {
+    struct Entry {
+        uint32_t templateIndex = 0;
+        Vector3 position;
+        Vector3 rotation;
+        Vector3 scale = Vector3::One;
+    };
+
+    std::vector<std::string> templateNames;
+    std::vector<Entry> entries;
+    bool valid = false;
+};
+
+// Streaming configuration
+struct WorldStreamingConfig {
+    std::string cellDirectory = "world";
+    float cellSize = 64.0f;
+
+    // Cells closer than loadRadius are loaded, cells further than unloadRadius
+    // are unloaded; the band in between is the hysteresis zone.
+    float loadRadius = 128.0f;
+    float unloadRadius = 160.0f;
+
+    // Main-thread time per frame for instantiating/destroying cell objects
+    float integrationBudgetMs = 1.0f;
+
+    size_t maxConcurrentLoads = 4;
+    size_t loaderThreads = 2;
+};
+
+enum class WorldCellState {
+    Loading,      // File read/parse in flight on a loader thread
+    Integrating,  // Parsed, objects being instantiated on the main thread
+    Resident,     // Fully instantiated in the scene
+    Unloading     // Objects being destroyed on the main thread
+};
+
+// WorldStreamer: Partitions a world into cells and streams them in/out of a scene
+class WorldStreamer {
+private:
+    struct CellRecord {
+        WorldCellCoord coord;
+        WorldCellState state = WorldCellState::Loading;
+        std::future<WorldCellData> pendingLoad;
+        WorldCellData data;
+        size_t integratedCount = 0;
+        std::vector<size_t> objectIds;
+        bool cancelled = false;   // Went out of range while loading
+        float priority = 0.0f;    // Distance to the nearest focus point
+    };
+
+    Scene* scene;
+    GameObjectFactory& gameObjectFactory;
+    WorldStreamingConfig config;
+
+    std::unordered_map<int, Vector3> focusPoints;
+    std::unordered_map<WorldCellCoord, CellRecord, WorldCellCoordHash> cells;
+    std::unique_ptr<ThreadPool> loaderPool;
+
+    // Statistics
+    size_t loadsInFlight = 0;
+    size_t residentObjects = 0;
+    float lastIntegrationTime = 0.0f;
+
+public:
+    WorldStreamer(Scene* targetScene, const WorldStreamingConfig& streamingConfig);
+    ~WorldStreamer();
+
+    // Delete copy operations
+    WorldStreamer(const WorldStreamer&) = delete;
+    WorldStreamer& operator=(const WorldStreamer&) = delete;
+
+    // Focus points (players, cameras, ...)
+    void SetFocusPoint(int focusId, const Vector3& position);
+    void RemoveFocusPoint(int focusId);
+    size_t GetFocusPointCount() const { return focusPoints.size(); }
+
+    // Per-frame update (main thread)
+    void Update();
+
+    // Immediately destroy every streamed object
+    void UnloadAll();
+
+    // Configuration and state
+    const WorldStreamingConfig& GetConfig() const { return config; }
+    Scene* GetScene() const { return scene; }
+    size_t GetCellCount() const { return cells.size(); }
+    size_t GetResidentCellCount() const;
+    size_t GetResidentObjectCount() const { return residentObjects; }
+    size_t GetLoadsInFlight() const { return loadsInFlight; }
+    float GetLastIntegrationTime() const { return lastIntegrationTime; }
+    bool IsCellResident(const WorldCellCoord& coord) const;
+
+    // Cell math
+    static WorldCellCoord CellFromPosition(const Vector3& position, float cellSize);
+    static std::string GetCellPath(const std::string& directory, const WorldCellCoord& coord);
+
+    // Offline baking and cell file access; compressed cells are read transparently
+    static bool WriteCellFile(const std::string& filepath, const WorldCellData& data, bool compress = false);
+    static WorldCellData ReadCellFile(const std::string& filepath);
+    static size_t BakeWorld(const std::string& directory, float cellSize, const std::vector<WorldPlacement>& placements,
+        bool compress = false);
+
+    // Debug
+    void PrintStreamingInfo() const;
+
+private:
+    static std::vector<uint8_t> EncodeCell(const WorldCellData& data, bool compress);
+    static WorldCellData ParseCell(const IOResult& file);
+
+    float DistanceToNearestFocus(const WorldCellCoord& coord) const;
+    void CollectFinishedLoads();
+    void UnloadDistantCells();
+    void RequestNearbyCells();
+    void IntegrateWithinBudget();
+    bool IntegrateStep(CellRecord& cell);
+    bool UnloadStep(CellRecord& cell);
+};
@@ -1,12 +1,15 @@
 #pragma once
 
 #include "../components/Component.h"
+#include "ComponentSchema.h"
 #include <unordered_map>
 #include <memory>
 #include <string>
 #include <functional>
 #include <typeindex>
 #include <vector>
+#include <string_view>
+#include <cstdint>
 
 // Forward declarations
 class Transform;
@@ -15,7 +18,12 @@ class Behavior;
 // Component creation configuration
 struct ComponentConfig {
     std::string typeName;
-    std::unordered_map<std::string, std::string> properties;
+    std::unordered_map<std::string, PropertyValue> properties;
+
+    // Patches resolved against the type's schema (see Compile)
+    std::vector<FieldPatch> patches;
+    const ComponentSchema* compiledSchema = nullptr;
+    size_t compiledRevision = 0;
 
     // Default constructor
     ComponentConfig() = default;
@@ -24,75 +32,104 @@ struct ComponentConfig {
 
     // Helper methods for setting properties
     ComponentConfig& SetProperty(const std::string& key, const std::string& value) {
-        properties[key] = value;
-        return *this;
+        return SetValue(key, PropertyValue::FromString(value));
     }
 
     ComponentConfig& SetFloat(const std::string& key, float value) {
-        properties[key] = std::to_string(value);
-        return *this;
+        return SetValue(key, PropertyValue::FromFloat(value));
     }
 
     ComponentConfig& SetInt(const std::string& key, int value) {
-        properties[key] = std::to_string(value);
-        return *this;
+        return SetValue(key, PropertyValue::FromInt(value));
     }
 
     ComponentConfig& SetBool(const std::string& key, bool value) {
-        properties[key] = value ? "true" : "false";
+        return SetValue(key, PropertyValue::FromBool(value));
+    }
+
+    ComponentConfig& SetVector3(const std::string& key, const Vector3& value) {
+        return SetValue(key, PropertyValue::FromVector3(value));
+    }
+
+    ComponentConfig& SetValue(const std::string& key, const PropertyValue& value) {
+        properties[key] = value;
+        compiledSchema = nullptr; // Patches are stale
         return *this;
     }
 
     // Property getters
     std::string GetString(const std::string& key, const std::string& defaultValue = "") const {
         auto it = properties.find(key);
-        return (it != properties.end()) ? it->second : defaultValue;
+        return (it != properties.end()) ? it->second.ToString() : defaultValue;
     }
 
     float GetFloat(const std::string& key, float defaultValue = 0.0f) const {
         auto it = properties.find(key);
-        return (it != properties.end()) ? std::stof(it->second) : defaultValue;
+        return (it != properties.end()) ? it->second.AsFloat(defaultValue) : defaultValue;
     }
 
     int GetInt(const std::string& key, int defaultValue = 0) const {
         auto it = properties.find(key);
-        return (it != properties.end()) ? std::stoi(it->second) : defaultValue;
+        return (it != properties.end()) ? it->second.AsInt(defaultValue) : defaultValue;
     }
 
     bool GetBool(const std::string& key, bool defaultValue = false) const {
         auto it = properties.find(key);
-        if (it != properties.end()) {
-            return it->second == "true" || it->second == "1";
-        }
-        return defaultValue;
+        return (it != properties.end()) ? it->second.AsBool(defaultValue) : defaultValue;
     }
+
+    Vector3 GetVector3(const std::string& key, const Vector3& defaultValue = Vector3::Zero) const {
+        auto it = properties.find(key);
+        return (it != properties.end()) ? it->second.AsVector3(defaultValue) : defaultValue;
+    }
+
+    // Resolve every property to a typed field patch; unknown or unconvertible
+    // properties are reported and ignored. Returns false if any were dropped.
+    bool Compile(const ComponentSchema& schema);
+    bool IsCompiledFor(const ComponentSchema& schema) const {
+        return compiledSchema == &schema && compiledRevision == schema.GetRevision();
+    }
+
+    // Default image plus patches (compiles on the fly if needed)
+    void BuildImage(const ComponentSchema& schema, void* image) const;
 };
 
-// Component factory registration info
+// Component factory registration info (one slot per component ID)
 struct ComponentFactoryInfo {
+    using DefaultCreateFunc = std::unique_ptr<Component>(*)();
+
     std::string typeName;
     std::type_index typeIndex;
-    std::function<std::unique_ptr<Component>()> defaultCreator;
+    size_t id = 0;
+    DefaultCreateFunc defaultCreator = nullptr;
+    const ComponentSchema* schema = nullptr;
+
+    // Only set for RegisterComponentWithConfig types (may capture state)
     std::function<std::unique_ptr<Component>(const ComponentConfig&)> configCreator;
 
-    ComponentFactoryInfo(const std::string& name, std::type_index index,
-        std::function<std::unique_ptr<Component>()> defaultFunc,
-        std::function<std::unique_ptr<Component>(const ComponentConfig&)> configFunc)
-        : typeName(name), typeIndex(index), defaultCreator(defaultFunc), configCreator(configFunc) {
+    ComponentFactoryInfo(const std::string& name, std::type_index index, DefaultCreateFunc defaultFunc)
+        : typeName(name), typeIndex(index), defaultCreator(defaultFunc) {
     }
+
+    bool HasConfigCreator() const { return static_cast<bool>(configCreator); }
 };
 
 // ComponentFactory: Data-driven component creation (REQUIREMENT #4)
 class ComponentFactory {
 private:
-    // Factory registry
-    std::unordered_map<std::string, ComponentFactoryInfo> componentFactories;
-    std::unordered_map<std::type_index, std::string> typeToName;
+    // Factory registry, indexed by component ID - 1 (IDs are dense, 0 is invalid)
+    std::vector<ComponentFactoryInfo> registry;
 
-    // Component ID system for data-driven creation
-    std::unordered_map<std::string, size_t> componentIds;
-    std::unordered_map<size_t, std::string> idToName;
-    size_t nextId = 1;
+    // Perfect hash of the registered names, rebuilt on every registration:
+    // each name maps to a distinct slot holding its ID (0 = empty)
+    std::vector<uint32_t> nameSlots;
+    uint64_t nameSeed = 0;
+    size_t nameMask = 0;
+
+    // Reflection schemas (pointers stay valid for the factory's lifetime)
+    std::unordered_map<std::string, std::unique_ptr<ComponentSchema>> schemas;
+    std::unordered_map<std::type_index, const ComponentSchema*> schemasByType;
+    size_t schemaGeneration = 0;
 
     // Singleton instance
     static ComponentFactory* instance;
@@ -121,6 +158,26 @@ public:
     bool IsComponentRegistered(const std::string& typeName) const;
     bool IsComponentRegistered(size_t componentId) const;
 
+    // True for types whose configs must go through their own creator
+    // rather than the schema image path
+    bool HasConfigCreator(const std::string& typeName) const;
+
+    // Reflection schemas (RegisterComponent adds an empty one; replace it
+    // with a schema that has fields to make the type data-driven)
+    void RegisterSchema(const ComponentSchema& schema);
+    const ComponentSchema* GetSchema(const std::string& typeName) const;
+    const ComponentSchema* GetSchema(const std::type_index& typeIndex) const;
+
+    template<typename T>
+    const ComponentSchema* GetSchema() const { return GetSchema(std::type_index(typeid(T))); }
+
+    // Bumped by every RegisterSchema; data compiled against schemas records it
+    size_t GetSchemaGeneration() const { return schemaGeneration; }
+
+    // Hash of every schema's name and field layout; unlike the generation it
+    // is stable across runs, so persisted data can be keyed by it
+    uint64_t GetSchemaFingerprint() const;
+
     // Component creation by name
     std::unique_ptr<Component> CreateComponent(const std::string& typeName);
     std::unique_ptr<Component> CreateComponent(const std::string& typeName, const ComponentConfig& config);
@@ -140,7 +197,7 @@ public:
     // Factory information
     std::vector<std::string> GetRegisteredComponentNames() const;
     std::vector<size_t> GetRegisteredComponentIds() const;
-    size_t GetRegisteredComponentCount() const { return componentFactories.size(); }
+    size_t GetRegisteredComponentCount() const { return registry.size(); }
 
     // Data-driven creation from strings/files
     std::unique_ptr<Component> CreateFromString(const std::string& componentData);
@@ -158,7 +215,19 @@ public:
 private:
     // Internal helpers
     void InitializeBuiltinComponents();
-    size_t AssignComponentId(const std::string& typeName);
+    size_t AddRegistryEntry(ComponentFactoryInfo info);
+    void RebuildNameHash();
+
+    // Registry lookups: one hash and a compare by name, an index by ID
+    const ComponentFactoryInfo* FindInfo(std::string_view typeName) const;
+    const ComponentFactoryInfo* FindInfo(size_t componentId) const {
+        return componentId - 1 < registry.size() ? &registry[componentId - 1] : nullptr;
+    }
+
+    std::unique_ptr<Component> CreateFromInfo(const ComponentFactoryInfo& info, const ComponentConfig& config) const;
+
+    template<typename T>
+    static std::unique_ptr<Component> CreateDefault() { return std::make_unique<T>(); }
 
     // Preset storage
     std::unordered_map<std::string, ComponentConfig> presets;
@@ -174,27 +243,11 @@ void ComponentFactory::RegisterComponent(const std::string& typeName) {
         return;
     }
 
-    std::type_index typeIndex = std::type_index(typeid(T));
+    size_t id = AddRegistryEntry(ComponentFactoryInfo(typeName, std::type_index(typeid(T)), &CreateDefault<T>));
 
-    // Default creator function
-    auto defaultCreator = []() -> std::unique_ptr<Component> {
-        return std::make_unique<T>();
-        };
-
-    // Config-based creator function (default implementation)
-    auto configCreator = [](const ComponentConfig& config) -> std::unique_ptr<Component> {
-        auto component = std::make_unique<T>();
-        // Apply configuration properties if the component supports it
-        // This would be overridden for specific component types
-        return component;
-        };
-
-    ComponentFactoryInfo info(typeName, typeIndex, defaultCreator, configCreator);
-    componentFactories.emplace(typeName, info);
-    typeToName.emplace(typeIndex, typeName);
-
-    // Assign unique ID
-    size_t id = AssignComponentId(typeName);
+    if (!GetSchema(typeName)) {
+        RegisterSchema(ComponentSchema::Create<T>(typeName));
+    }
 
     std::cout << "Registered component: " << typeName << " (ID: " << id << ")" << std::endl;
 }
@@ -209,24 +262,15 @@ void ComponentFactory::RegisterComponentWithConfig(const std::string& typeName,
         return;
     }
 
-    std::type_index typeIndex = std::type_index(typeid(T));
-
-    // Default creator
-    auto defaultCreator = []() -> std::unique_ptr<Component> {
-        return std::make_unique<T>();
-        };
-
-    // Wrap the typed config creator to return Component*
-    auto wrappedConfigCreator = [configCreator](const ComponentConfig& config) -> std::unique_ptr<Component> {
+    ComponentFactoryInfo info(typeName, std::type_index(typeid(T)), &CreateDefault<T>);
+    info.configCreator = [configCreator](const ComponentConfig& config) -> std::unique_ptr<Component> {
         return configCreator(config);
         };
+    size_t id = AddRegistryEntry(std::move(info));
 
-    ComponentFactoryInfo info(typeName, typeIndex, defaultCreator, wrappedConfigCreator);
-    componentFactories.emplace(typeName, info);
-    typeToName.emplace(typeIndex, typeName);
-
-    // Assign unique ID
-    size_t id = AssignComponentId(typeName);
+    if (!GetSchema(typeName)) {
+        RegisterSchema(ComponentSchema::Create<T>(typeName));
+    }
 
     std::cout << "Registered component with config: " << typeName << " (ID: " << id << ")" << std::endl;
 }
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "../core/GameObject.h"
+#include "../components/Transform.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <typeindex>
+#include <cstdint>
+#include <cstddef>
+
+// Storable field types (String only exists as a config value and is
+// converted to the field's type when the config is compiled)
+enum class FieldType : uint8_t {
+    Bool,
+    Int,
+    Float,
+    Vector3,
+    String
+};
+
+size_t GetFieldTypeSize(FieldType type);
+const char* GetFieldTypeName(FieldType type);
+
+// Typed property value (replaces string-only config properties)
+struct PropertyValue {
+    FieldType type = FieldType::String;
+    union {
+        bool boolValue;
+        int32_t intValue;
+        float floatValue;
+        float vectorValue[3];
+    };
+    std::string stringValue;
+
+    PropertyValue() : vectorValue{ 0.0f, 0.0f, 0.0f } {}
+
+    static PropertyValue FromBool(bool value);
+    static PropertyValue FromInt(int32_t value);
+    static PropertyValue FromFloat(float value);
+    static PropertyValue FromVector3(const Vector3& value);
+    static PropertyValue FromString(const std::string& value);
+
+    // Conversions (String values are parsed)
+    bool AsBool(bool defaultValue = false) const;
+    int32_t AsInt(int32_t defaultValue = 0) const;
+    float AsFloat(float defaultValue = 0.0f) const;
+    Vector3 AsVector3(const Vector3& defaultValue = Vector3::Zero) const;
+    std::string ToString() const;
+
+    // Convert to the exact bytes of a field of the given type; returns false
+    // if the value cannot be represented (e.g. unparsable text)
+    bool Encode(FieldType target, uint8_t* destination) const;
+};
+
+// A field in a component's data image
+struct FieldInfo {
+    std::string name;
+    FieldType type;
+    uint32_t offset;
+    uint32_t size;
+};
+
+// Pre-resolved write into a data image
+struct FieldPatch {
+    uint32_t offset = 0;
+    uint32_t size = 0;
+    alignas(4) uint8_t bytes[12] = {};
+};
+
+// ComponentSchema: Reflection data for one component type.
+// A component is described by a plain data image (e.g. TransformData) with
+// named fields at fixed offsets. Configs compile to FieldPatch lists against
+// the default image, and the binary serializer stores the fields as columns.
+class ComponentSchema {
+public:
+    using CreateFunc = std::unique_ptr<Component>(*)(const void* image);
+    using EmplaceFunc = Component* (*)(GameObject& owner, const void* image);
+    using CaptureFunc = void(*)(const Component& component, void* image);
+    using ApplyFunc = void(*)(Component& component, const void* image);
+
+private:
+    // Extra config names that write into (part of) a field, e.g. "x" -> position.x
+    struct Alias {
+        std::string name;
+        FieldType type;
+        uint32_t offset;
+    };
+
+    std::string typeName;
+    std::type_index typeIndex;
+    std::vector<uint8_t> defaultImage;
+    std::vector<FieldInfo> fields;
+    std::vector<Alias> aliases;
+
+    size_t revision = 0;    // Set by ComponentFactory on registration
+
+    CreateFunc create = nullptr;
+    EmplaceFunc emplace = nullptr;
+    CaptureFunc capture = nullptr;
+    ApplyFunc apply = nullptr;
+
+public:
+    ComponentSchema(const std::string& name, std::type_index index, const void* defaults, size_t imageSize);
+
+    // Schema for a component with no data fields
+    template<typename T>
+    static ComponentSchema Create(const std::string& name);
+
+    // Schema over a data image; bind create/emplace/capture/apply afterwards
+    template<typename T, typename Data>
+    static ComponentSchema Create(const std::string& name, const Data& defaults);
+
+    // Building
+    ComponentSchema& AddField(const std::string& name, FieldType type, size_t offset);
+    ComponentSchema& AddAlias(const std::string& name, FieldType type, size_t offset);
+    ComponentSchema& SetCreate(CreateFunc func) { create = func; return *this; }
+    ComponentSchema& SetEmplace(EmplaceFunc func) { emplace = func; return *this; }
+    ComponentSchema& SetCapture(CaptureFunc func) { capture = func; return *this; }
+    ComponentSchema& SetApply(ApplyFunc func) { apply = func; return *this; }
+    void SetRevision(size_t value) { revision = value; }
+
+    // Information
+    const std::string& GetTypeName() const { return typeName; }
+    size_t GetRevision() const { return revision; }
+    std::type_index GetTypeIndex() const { return typeIndex; }
+    size_t GetImageSize() const { return defaultImage.size(); }
+    size_t GetImageWords() const { return (defaultImage.size() + sizeof(uint64_t) - 1) / sizeof(uint64_t); }
+    const uint8_t* GetDefaultImage() const { return defaultImage.data(); }
+    const std::vector<FieldInfo>& GetFields() const { return fields; }
+    bool HasFields() const { return !fields.empty(); }
+    const FieldInfo* FindField(std::string_view name) const;
+
+    // Config compilation
+    bool CompilePatch(const std::string& property, const PropertyValue& value, FieldPatch& patch) const;
+
+    // Image operations
+    void InitImage(void* image) const;
+    static void ApplyPatches(void* image, const std::vector<FieldPatch>& patches);
+
+    // Component operations (image must be at least GetImageSize() bytes)
+    std::unique_ptr<Component> CreateComponent(const void* image) const;
+    Component* EmplaceComponent(GameObject& owner, const void* image) const;
+    void CaptureComponent(const Component& component, void* image) const;
+    void ApplyToComponent(Component& component, const void* image) const;
+};
+
+// Template implementations
+template<typename T>
+ComponentSchema ComponentSchema::Create(const std::string& name) {
+    static_assert(std::is_base_of_v<Component, T>, "T must derive from Component");
+
+    ComponentSchema schema(name, std::type_index(typeid(T)), nullptr, 0);
+    schema.create = [](const void*) -> std::unique_ptr<Component> {
+        return std::make_unique<T>();
+        };
+    schema.emplace = [](GameObject& owner, const void*) -> Component* {
+        return owner.AddComponent<T>();
+        };
+    return schema;
+}
+
+template<typename T, typename Data>
+ComponentSchema ComponentSchema::Create(const std::string& name, const Data& defaults) {
+    static_assert(std::is_base_of_v<Component, T>, "T must derive from Component");
+    static_assert(std::is_trivially_copyable_v<Data>, "Schema data images must be trivially copyable");
+
+    return ComponentSchema(name, std::type_index(typeid(T)), &defaults, sizeof(Data));
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "ComponentSchema.h"
+#include "ComponentFactory.h"
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstdint>
+
+// Forward declarations
+struct GameObjectTemplate;
+
+// Field-level difference between two compilations of the same template,
+// applied to live instances by hot reload
+struct BlueprintDiff {
+    struct ComponentChange {
+        const ComponentSchema* schema = nullptr;
+        size_t componentId = 0;
+        std::vector<FieldPatch> patches;            // Changed fields (new values)
+
+        // Components the previous compilation did not have
+        bool added = false;
+        std::vector<uint64_t> image;
+        std::unique_ptr<ComponentConfig> config;    // Only for types with their own config creator
+    };
+
+    size_t templateId = 0;
+    std::string templateName;
+    std::vector<ComponentChange> components;
+    std::vector<std::string> removedComponents;     // Reported only, live instances keep them
+
+    bool IsEmpty() const { return components.empty() && removedComponents.empty(); }
+};
+
+// GameObjectBlueprint: Immutable, pre-resolved form of a GameObjectTemplate.
+// Compiling resolves every component type to its schema and bakes the
+// defaults plus the config patches into one data image, so instantiating is
+// a walk over the component list with no name lookups or text conversion.
+class GameObjectBlueprint {
+public:
+    struct ComponentEntry {
+        const ComponentSchema* schema = nullptr;
+        size_t componentId = 0;             // ComponentFactory ID
+        uint32_t imageOffset = 0;           // Byte offset of this component's image
+        std::vector<FieldPatch> patches;    // Config patches (already baked into the image)
+        std::unique_ptr<ComponentConfig> config;  // Only for types with their own config creator
+    };
+
+private:
+    std::string name;
+    std::string tag;
+    bool active = true;
+
+    std::vector<ComponentEntry> components;
+    std::vector<uint64_t> image;            // Component images, each 8-byte aligned
+    size_t schemaGeneration = 0;
+    size_t templateId = 0;                  // Stamped on every instance
+
+public:
+    GameObjectBlueprint() = default;
+
+    // Resolve a template; unknown component types are skipped and reported in 'errors'
+    static std::unique_ptr<GameObjectBlueprint> Compile(const GameObjectTemplate& gameObjectTemplate,
+        const ComponentFactory& componentFactory, std::vector<std::string>& errors, size_t templateId = 0);
+
+    // What changed from 'previous' to 'current' (fields compared byte-wise;
+    // every field counts as changed if a schema was re-registered in between)
+    static BlueprintDiff Diff(const GameObjectBlueprint& previous, const GameObjectBlueprint& current);
+
+    // Instantiation
+    std::unique_ptr<GameObject> Instantiate() const;
+    std::unique_ptr<GameObject> Instantiate(size_t objectId) const;   // Pre-reserved ID
+    void AddComponentsTo(GameObject& gameObject) const;
+
+    // Information
+    const std::string& GetName() const { return name; }
+    const std::string& GetTag() const { return tag; }
+    bool IsActive() const { return active; }
+    size_t GetTemplateId() const { return templateId; }
+    size_t GetComponentCount() const { return components.size(); }
+    const std::vector<ComponentEntry>& GetComponents() const { return components; }
+    const void* GetComponentImage(size_t index) const;
+    size_t GetImageSize() const { return image.size() * sizeof(uint64_t); }
+
+    // False once a schema was re-registered after this blueprint was compiled
+    bool IsCurrent(const ComponentFactory& componentFactory) const;
+};
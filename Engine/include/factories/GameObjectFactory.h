@@ -2,16 +2,23 @@
 
 #include "../core/GameObject.h"
 #include "ComponentFactory.h"
+#include "GameObjectBlueprint.h"
 #include <vector>
 #include <string>
+#include <string_view>
 #include <memory>
 #include <unordered_map>
 #include <functional>
+#include <cstdint>
 
 #include <iostream>
 
 // Forward declarations
 class Scene;
+class ThreadPool;
+class ParseCache;
+class AssetArchive;
+struct TemplateParseError;
 
 // GameObject template/blueprint definition
 struct GameObjectTemplate {
@@ -96,15 +103,45 @@ struct GameObjectCreationResult {
     }
 };
 
+// Result of loading a template directory
+struct TemplateLoadReport {
+    size_t filesFound = 0;
+    size_t filesLoaded = 0;                 // Opened and parsed (possibly with errors)
+    size_t templatesRegistered = 0;
+    std::vector<std::string> errors;        // "path:line:column: message", in path order
+
+    bool Succeeded() const { return errors.empty() && templatesRegistered > 0; }
+    bool HasErrors() const { return !errors.empty(); }
+    void PrintErrors() const {
+        for (const std::string& error : errors) {
+            std::cerr << "Template load error: " << error << std::endl;
+        }
+    }
+};
+
 // GameObjectFactory: Data-driven GameObject creation (REQUIREMENT #4)
 class GameObjectFactory {
 private:
     // Template registry
     std::unordered_map<std::string, GameObjectTemplate> templates;
 
+    // Compiled form of each registered template, used for spawning
+    std::unordered_map<std::string, std::unique_ptr<GameObjectBlueprint>> blueprints;
+
+    // Stable ID per template name, stamped on instances (kept across re-registration)
+    std::unordered_map<std::string, size_t> templateIds;
+    size_t nextTemplateId = 1;
+
     // Component factory reference
     ComponentFactory& componentFactory;
 
+    // Parallel instantiation (optional, not owned)
+    ThreadPool* threadPool = nullptr;
+    size_t parallelThreshold = 4096;
+
+    // Persistent parse cache for template files (optional, not owned)
+    ParseCache* parseCache = nullptr;
+
     // Factory statistics
     size_t objectsCreated = 0;
     size_t templatesRegistered = 0;
@@ -132,6 +169,9 @@ public:
     bool HasTemplate(const std::string& templateName) const;
     const GameObjectTemplate* GetTemplate(const std::string& templateName) const;
 
+    // Compiled blueprint of a registered template (recompiled if a schema changed)
+    const GameObjectBlueprint* GetBlueprint(const std::string& templateName);
+
     // GameObject creation from templates
     GameObjectCreationResult CreateGameObject(const std::string& templateName);
     GameObjectCreationResult CreateGameObject(const GameObjectTemplate& gameObjectTemplate);
@@ -142,6 +182,24 @@ public:
 
     // Batch GameObject creation
     std::vector<GameObjectCreationResult> CreateGameObjects(const std::string& templateName, size_t count);
+
+    // Instantiate a blueprint 'count' times, split across the thread pool when
+    // one is set and the batch is large enough. Each worker fills its own slice
+    // from a pre-reserved ID range, so the result (order and IDs) is identical
+    // to a single-threaded run. The initializer runs on worker threads.
+    std::vector<std::unique_ptr<GameObject>> InstantiateBatch(const GameObjectBlueprint& blueprint, size_t count,
+        const std::function<void(GameObject&, size_t)>& initializer = nullptr);
+
+    // Parallel instantiation
+    void SetThreadPool(ThreadPool* pool) { threadPool = pool; }
+    ThreadPool* GetThreadPool() const { return threadPool; }
+    void SetParallelThreshold(size_t objectCount) { parallelThreshold = objectCount; }
+    size_t GetParallelThreshold() const { return parallelThreshold; }
+
+    // Template files are read through the cache when one is set
+    void SetParseCache(ParseCache* cache) { parseCache = cache; }
+    ParseCache* GetParseCache() const { return parseCache; }
+
     std::vector<GameObjectCreationResult> CreateGameObjectsFromFile(const std::string& filepath);
 
     // Specialized creation methods
@@ -158,7 +216,23 @@ public:
     // Template serialization
     bool SaveTemplate(const std::string& templateName, const std::string& filepath) const;
     bool LoadTemplate(const std::string& filepath);
-    bool LoadTemplatesFromDirectory(const std::string& directory);
+
+    // Recursively load every file with 'extension' below 'directory'. Files are
+    // read and parsed on the thread pool (when set); templates are registered on
+    // the calling thread in path order, so a name defined twice resolves the
+    // same way on every run (the later path wins).
+    TemplateLoadReport LoadTemplatesFromDirectory(const std::string& directory,
+        const std::string& extension = ".template");
+
+    // Load every entry with 'extension' from a pack file, parsing stored
+    // entries in place; same ordering and reporting as a directory load
+    TemplateLoadReport LoadTemplatesFromArchive(const AssetArchive& archive,
+        const std::string& extension = ".template");
+
+    // Hot reload: re-parse one template file, re-register its templates and
+    // append what changed in each one that was already registered. A file with
+    // errors registers nothing, so live data never sees a half-edited file.
+    TemplateLoadReport ReloadTemplateFile(const std::string& filepath, std::vector<BlueprintDiff>& diffs);
 
     // Data-driven creation from strings
     GameObjectCreationResult CreateFromString(const std::string& objectData);
@@ -178,6 +252,9 @@ public:
     void PrintTemplate(const std::string& templateName) const;
 
 private:
+    // Store a template and compile its blueprint; compile errors go to 'errors'
+    void StoreTemplate(GameObjectTemplate gameObjectTemplate, std::vector<std::string>& errors);
+
     // Internal creation helpers
     std::unique_ptr<GameObject> CreateGameObjectInternal(const GameObjectTemplate& gameObjectTemplate,
         GameObjectCreationResult& result);
@@ -190,8 +267,35 @@ private:
     void InitializeBuiltinTemplates();
 
     // File parsing helpers
+    enum class TemplateFileFormat : uint32_t {
+        Document,   // Multi-line template documents (SaveTemplate format)
+        Lines       // One "Name:Tag:Components" template per line
+    };
+
     GameObjectTemplate ParseTemplateFromString(const std::string& data) const;
     std::vector<GameObjectTemplate> ParseTemplatesFromFile(const std::string& filepath) const;
+    static void ParseTemplateLines(std::string_view text, const std::string& source,
+        std::vector<GameObjectTemplate>& fileTemplates, std::vector<TemplateParseError>& errors);
+
+    // Parse results of one file, registered after all files are parsed
+    struct ParsedTemplateFile {
+        bool opened = false;
+        std::vector<GameObjectTemplate> templates;
+        std::vector<TemplateParseError> errors;
+    };
+
+    // Run parse(begin, end) over [0, count) in chunks on the thread pool (when set)
+    void ParseInParallel(size_t count, const std::function<void(size_t, size_t)>& parse) const;
+
+    // Register in file order; overrides and errors go to the report
+    void RegisterParsedFiles(const std::vector<std::string>& files,
+        std::vector<ParsedTemplateFile>& parsed, TemplateLoadReport& report);
+
+    // Read and parse a template file, through the parse cache if set; returns
+    // false if the file cannot be read
+    bool ReadTemplateFile(const std::string& filepath, TemplateFileFormat format, uint64_t cacheVersion,
+        std::vector<GameObjectTemplate>& fileTemplates, std::vector<TemplateParseError>& errors) const;
+    uint64_t GetParseCacheVersion(TemplateFileFormat format) const;
 };
 
 // Template builder helper class
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "GameObjectFactory.h"
+#include "../io/FileWatcher.h"
+#include "../serialization/SceneStreamReader.h"
+#include <string>
+#include <vector>
+#include <deque>
+
+// Forward declarations
+class Scene;
+
+// TemplateHotReloader: Applies edits to template files to a running scene.
+// Changed files are re-parsed and their blueprints recompiled; live instances
+// of each changed template then receive only the fields that changed, so
+// state the game set on other fields survives. Call Update at a frame
+// boundary; patching is spread over frames by the budget.
+//
+// Limits: tag/active changes and removed components are not applied to live
+// instances (removals are reported); only the scene passed to Update is
+// patched.
+class TemplateHotReloader {
+private:
+    struct PendingPatch {
+        BlueprintDiff diff;
+        const Scene* scene = nullptr;       // Scene the instance list was collected from
+        std::vector<size_t> objectIds;      // Live instances (IDs, objects may die meanwhile)
+        size_t nextObject = 0;
+    };
+
+    GameObjectFactory& factory;
+    FileWatcher watcher;
+    std::string extension = ".template";
+    std::deque<PendingPatch> pending;
+    std::vector<uint64_t> scratchImage;
+
+    // Statistics
+    size_t filesReloaded = 0;
+    size_t objectsPatched = 0;
+
+public:
+    explicit TemplateHotReloader(GameObjectFactory& gameObjectFactory = GameObjectFactory::GetInstance());
+
+    // Delete copy operations (owns the file watch)
+    TemplateHotReloader(const TemplateHotReloader&) = delete;
+    TemplateHotReloader& operator=(const TemplateHotReloader&) = delete;
+
+    bool Watch(const std::string& directory, const std::string& fileExtension = ".template");
+    bool IsWatching() const { return watcher.IsWatching(); }
+
+    // Reload one file now (also used for watcher events); patches are queued
+    TemplateLoadReport ReloadFile(const std::string& filepath);
+
+    // Frame boundary: pick up changed files, then patch live instances in
+    // 'scene' within the budget. Returns the number of objects patched.
+    size_t Update(Scene& scene, const SceneLoadBudget& budget = SceneLoadBudget(1024, 1000));
+
+    bool HasPendingPatches() const { return !pending.empty(); }
+    size_t GetFilesReloaded() const { return filesReloaded; }
+    size_t GetObjectsPatched() const { return objectsPatched; }
+
+private:
+    void CollectInstances(PendingPatch& patch, Scene& scene);
+    void PatchObject(GameObject& gameObject, const BlueprintDiff& diff);
+};
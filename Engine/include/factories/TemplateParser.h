@@ -0,0 +1,66 @@
+#pragma once
+
+#include "GameObjectFactory.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+// Parse error with a 1-based source position
+struct TemplateParseError {
+    std::string source;
+    size_t line = 0;
+    size_t column = 0;
+    std::string message;
+
+    std::string ToString() const;
+};
+
+// TemplateParser: Tokenizer for the template text formats.
+// Works on string_views over the input (no per-token allocation) and parses
+// numbers with std::from_chars; only the resulting names and values are copied.
+//
+// Template documents (as written by GameObjectFactory::SaveTemplate), one or
+// more templates per file, each starting at an unindented Name: line:
+//
+//   # comment
+//   Name:Enemy
+//   Tag:Enemy
+//   Active:true
+//   Components:
+//     - Type:Transform
+//       position:10,0,5
+//       scale:0.8
+//     - Type:Behavior
+//
+// Property values are typed on parse: true/false, integers, floats, "x,y,z"
+// vectors, anything else is kept as a string.
+class TemplateParser {
+public:
+    // Parse a whole document; templates are appended to 'templates'. Lines with
+    // errors are skipped and reported, the rest of the document still parses.
+    // Returns true if there were no errors.
+    static bool ParseDocument(std::string_view text, std::vector<GameObjectTemplate>& templates,
+        std::vector<TemplateParseError>& errors, std::string_view sourceName = "<string>");
+
+    // Single-line form "Name:Tag:Component1,Component2"
+    static bool ParseTemplateLine(std::string_view line, GameObjectTemplate& gameObjectTemplate,
+        TemplateParseError* error = nullptr);
+
+    // Component string "Type:prop=value,prop=value" (vector values may contain commas)
+    static bool ParseComponentString(std::string_view text, ComponentConfig& config,
+        TemplateParseError* error = nullptr);
+
+    // Typed value from its text form
+    static PropertyValue ParseValue(std::string_view text);
+
+    // Split the next line off 'text' (line break and trailing '\r' removed);
+    // returns false once the text is exhausted
+    static bool NextLine(std::string_view& text, std::string_view& line);
+
+    // Binary form of parsed templates (ParseCache payloads); decoding is a
+    // bounds-checked copy with no text conversion
+    static constexpr uint32_t BinaryVersion = 1;
+    static void EncodeTemplates(const std::vector<GameObjectTemplate>& templates, std::vector<uint8_t>& bytes);
+    static bool DecodeTemplates(const uint8_t* data, size_t size, std::vector<GameObjectTemplate>& templates);
+};
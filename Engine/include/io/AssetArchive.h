@@ -0,0 +1,140 @@
+#pragma once
+
+#include "MappedFile.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+
+// Asset archive ("pack file") layout, little-endian:
+//   ArchiveHeader
+//   ArchiveEntry[entryCount]      sorted by (pathHash, path)
+//   path strings                  '/'-separated, relative, not terminated
+//   blobs                         each aligned to BlobAlignment
+// A blob is stored raw, or BlockCompression-compressed when that made it
+// smaller (decided per blob when the archive is built).
+struct ArchiveHeader {
+    char magic[4];
+    uint32_t formatVersion;
+    uint64_t entryCount;
+    uint64_t pathsOffset;
+    uint64_t pathsSize;
+    uint64_t dataOffset;
+    uint64_t fileSize;
+};
+
+struct ArchiveEntry {
+    enum Compression : uint8_t {
+        Stored = 0,
+        Block = 1       // BlockCompression
+    };
+
+    uint64_t pathHash;
+    uint64_t offset;        // From the start of the archive
+    uint64_t storedSize;    // Bytes in the archive
+    uint64_t size;          // Original size
+    uint32_t pathOffset;    // Into the path strings
+    uint16_t pathLength;
+    uint8_t compression;
+    uint8_t reserved;
+};
+
+static_assert(sizeof(ArchiveHeader) == 48, "ArchiveHeader layout changed");
+static_assert(sizeof(ArchiveEntry) == 40, "ArchiveEntry layout changed");
+
+// AssetArchive: Read-only view of a pack file. The archive is mapped once;
+// lookups binary-search the hash index and return views into the mapping, so
+// loaders parse stored entries in place. Const access is thread-safe.
+class AssetArchive {
+public:
+    static constexpr uint32_t FormatVersion = 1;
+    static constexpr size_t BlobAlignment = 16;
+
+private:
+    MappedFile file;
+    std::string archivePath;
+    const ArchiveEntry* entries = nullptr;
+    size_t entryCount = 0;
+    const char* paths = nullptr;
+
+public:
+    AssetArchive() = default;
+
+    // Delete copy operations (owns the mapping)
+    AssetArchive(const AssetArchive&) = delete;
+    AssetArchive& operator=(const AssetArchive&) = delete;
+
+    // Maps the archive and validates its header and index
+    bool Open(const std::string& filepath);
+    void Close();
+    bool IsOpen() const { return file.IsOpen(); }
+    const std::string& GetPath() const { return archivePath; }
+
+    // Lookup ('path' as given to the builder, '/'-separated)
+    const ArchiveEntry* Find(std::string_view path) const;
+    bool Contains(std::string_view path) const { return Find(path) != nullptr; }
+
+    // Stored bytes of an entry (compressed data for compressed entries)
+    std::string_view GetStoredData(const ArchiveEntry& entry) const;
+    std::string_view GetEntryPath(const ArchiveEntry& entry) const;
+
+    // Contents of 'path': a view into the mapping for stored entries, or
+    // decompressed into 'scratch' for compressed ones. False if missing or
+    // corrupt. The view stays valid while the archive (and scratch) live.
+    bool GetContents(std::string_view path, std::string_view& contents, std::vector<uint8_t>& scratch) const;
+    bool GetContents(const ArchiveEntry& entry, std::string_view& contents, std::vector<uint8_t>& scratch) const;
+
+    // Enumeration (index order, i.e. by hash)
+    size_t GetEntryCount() const { return entryCount; }
+    const ArchiveEntry& GetEntry(size_t index) const { return entries[index]; }
+
+    // Entries whose path ends with 'extension', sorted by path
+    std::vector<const ArchiveEntry*> FindByExtension(std::string_view extension) const;
+
+    // Path key hash (stored in the index)
+    static uint64_t HashPath(std::string_view path);
+};
+
+// AssetArchiveBuilder: Collects files in memory and writes a pack file
+class AssetArchiveBuilder {
+private:
+    struct PendingEntry {
+        std::string path;
+        std::vector<uint8_t> data;
+        bool compress = false;
+    };
+
+    std::vector<PendingEntry> pending;
+    std::unordered_map<std::string, size_t> pathIndices;
+
+    // Statistics from the last Write
+    size_t bytesIn = 0;
+    size_t bytesStored = 0;
+    size_t entriesCompressed = 0;
+
+public:
+    // Add or replace an entry; returns false for paths the format cannot hold
+    bool AddData(const std::string& path, std::vector<uint8_t> data, bool compress = false);
+    bool AddFile(const std::string& path, const std::string& sourcePath, bool compress = false);
+
+    // Every file below 'directory' with 'extension' (all files if empty),
+    // stored as 'prefix' + path relative to the directory. Returns the count.
+    size_t AddDirectory(const std::string& directory, const std::string& prefix = "",
+        const std::string& extension = "", bool compress = false);
+
+    size_t GetEntryCount() const { return pending.size(); }
+    void Clear();
+
+    // Writes the archive (temp file + rename)
+    bool Write(const std::string& filepath);
+
+    // Statistics
+    size_t GetBytesIn() const { return bytesIn; }
+    size_t GetBytesStored() const { return bytesStored; }
+    size_t GetEntriesCompressed() const { return entriesCompressed; }
+
+    // Canonical entry path: '/' separators, no leading "./" or '/'
+    static std::string NormalizePath(const std::string& path);
+};
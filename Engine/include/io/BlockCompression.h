@@ -0,0 +1,52 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Forward declarations
+class ThreadPool;
+
+// BlockCompression: Fast LZ77 block codec (LZ4-style byte format, no entropy
+// stage). Each block is self-contained; the caller stores the original size
+// and passes it back to Decompress.
+//
+// A block is a series of sequences: a token (high nibble: literal count,
+// low nibble: match length - 4, 15 means more length bytes follow), the
+// literals, then a 2-byte little-endian match offset. The last sequence has
+// literals only. Matches never start in the last 12 bytes and never cover
+// the last 5, which keeps the decoder's wide copies inside the output.
+class BlockCompression {
+public:
+    static constexpr size_t MaxBlockSize = 0x7E000000;
+
+    // Destination size that always suffices for Compress
+    static size_t GetMaxCompressedSize(size_t sourceSize) {
+        return sourceSize + sourceSize / 255 + 16;
+    }
+
+    // Returns the compressed size, or 0 if the source is larger than
+    // MaxBlockSize or destinationCapacity < GetMaxCompressedSize(sourceSize)
+    static size_t Compress(const uint8_t* source, size_t sourceSize,
+        uint8_t* destination, size_t destinationCapacity);
+
+    // 'destinationSize' must be the exact original size. Returns false for
+    // corrupt input; never reads or writes outside the given ranges.
+    static bool Decompress(const uint8_t* source, size_t sourceSize,
+        uint8_t* destination, size_t destinationSize);
+
+    // Frames: header, one stored size per block, then the blocks. The input is
+    // split into 'blockSize' pieces compressed independently (a piece that does
+    // not shrink is stored raw), so both directions run block-parallel on the
+    // pool when one is given. The calling thread takes a share of the blocks;
+    // don't pass a pool whose workers may all be blocked on this call.
+    static constexpr size_t DefaultFrameBlockSize = 256 * 1024;
+
+    static void CompressFrame(const uint8_t* source, size_t sourceSize, std::vector<uint8_t>& frame,
+        ThreadPool* pool = nullptr, size_t blockSize = DefaultFrameBlockSize);
+    static bool DecompressFrame(const uint8_t* frame, size_t frameSize, std::vector<uint8_t>& content,
+        ThreadPool* pool = nullptr);
+
+    // Cheap check of the frame magic
+    static bool IsFrame(const uint8_t* data, size_t size);
+};
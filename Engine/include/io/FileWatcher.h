@@ -0,0 +1,47 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+// FileWatcher: Reports files that were written, created or moved into the
+// watched directory trees. Uses inotify on Linux (subdirectories created
+// later are picked up too); other platforms fall back to comparing
+// modification times on every Poll.
+class FileWatcher {
+private:
+    std::vector<std::string> roots;
+
+#ifdef __linux__
+    int inotifyFd = -1;
+    std::unordered_map<int, std::string> watchDirectories;   // Watch descriptor -> directory
+#else
+    std::unordered_map<std::string, int64_t> modificationTimes;
+#endif
+
+public:
+    FileWatcher() = default;
+    ~FileWatcher();
+
+    // Delete copy operations (owns the watch handle)
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    // Watch a directory tree (recursive)
+    bool Watch(const std::string& directory);
+    void Close();
+    bool IsWatching() const { return !roots.empty(); }
+
+    // Non-blocking; appends every file changed since the last call (each path
+    // once). Returns the number of paths added.
+    size_t Poll(std::vector<std::string>& changedFiles);
+
+private:
+#ifdef __linux__
+    bool AddWatch(const std::string& directory);
+    void AddWatchTree(const std::string& directory, std::vector<std::string>* existingFiles);
+#else
+    void Scan(const std::string& directory, std::vector<std::string>* changedFiles);
+#endif
+};
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Forward declarations
+class ThreadPool;
+
+// Completed I/O request. A read owns the file contents; the buffer is read
+// into once and then only moved (to the callback or future), never copied.
+struct IOResult {
+    std::string path;
+    bool success = false;
+    int error = 0;                  // errno value on failure
+    std::vector<uint8_t> data;      // Read: file contents
+    size_t bytesTransferred = 0;
+};
+
+// Runs on the I/O completion thread; keep it short or hand work off
+using IOCallback = std::function<void(IOResult& result)>;
+
+struct IORequest {
+    enum class Type { Read, Write, Append };
+
+    Type type = Type::Read;
+    std::string path;
+    std::vector<uint8_t> data;      // Write/Append payload (moved in, no copy)
+    IOCallback callback;            // Optional; without one the result goes to the future
+    bool sync = false;              // Write/Append: reach stable storage (fdatasync) before completing
+
+    static IORequest Read(const std::string& filepath, IOCallback onComplete = nullptr);
+    static IORequest Write(const std::string& filepath, std::vector<uint8_t> payload, IOCallback onComplete = nullptr);
+    static IORequest Append(const std::string& filepath, std::vector<uint8_t> payload, IOCallback onComplete = nullptr);
+};
+
+// IOService: Engine-wide asynchronous whole-file reads and writes.
+// On Linux requests go through an io_uring driven by one submission thread
+// (up to queueDepth operations in flight); if io_uring is unavailable (old
+// kernel, seccomp, other platforms) a small ThreadPool performs them with
+// blocking calls instead. Writes replace the file (create/truncate), appends
+// add to its end (creating it). Requests in flight together complete in any
+// order; a caller that needs ordering submits the next once one completed.
+class IOService {
+public:
+    enum class Backend {
+        IoUring,
+        ThreadPool
+    };
+
+private:
+    struct Pending {
+        IORequest request;
+        std::promise<IOResult> promise;
+    };
+
+    struct Ring;    // io_uring state, defined in the .cpp
+
+    Backend backend = Backend::ThreadPool;
+    unsigned queueDepth = 64;
+
+    // Submission queue (io_uring backend)
+    std::mutex queueMutex;
+    std::condition_variable queueCondition;
+    std::deque<std::unique_ptr<Pending>> queue;
+    bool stopping = false;
+    std::unique_ptr<Ring> ring;
+    std::thread ringThread;
+
+    // Fallback backend
+    std::unique_ptr<ThreadPool> workers;
+
+    // Statistics
+    std::atomic<size_t> requestsCompleted{ 0 };
+    std::atomic<size_t> requestsFailed{ 0 };
+    std::atomic<size_t> bytesRead{ 0 };
+    std::atomic<size_t> bytesWritten{ 0 };
+
+    // Singleton instance
+    static IOService* instance;
+
+public:
+    // Singleton access
+    static IOService& GetInstance();
+    static void DestroyInstance();
+
+    explicit IOService(size_t workerThreads = 2, unsigned maxInFlight = 64, bool allowIoUring = true);
+    ~IOService();   // Finishes every request already submitted
+
+    // Delete copy operations
+    IOService(const IOService&) = delete;
+    IOService& operator=(const IOService&) = delete;
+
+    // Single requests
+    std::future<IOResult> ReadFile(const std::string& filepath);
+    std::future<IOResult> WriteFile(const std::string& filepath, std::vector<uint8_t> data);
+    void ReadFile(const std::string& filepath, IOCallback callback);
+    void WriteFile(const std::string& filepath, std::vector<uint8_t> data, IOCallback callback);
+
+    // Batch submission (one queue lock, one wake-up). Returns one future per
+    // request, in order; for requests with a callback the future is set after
+    // the callback ran (with whatever it left in the result).
+    std::vector<std::future<IOResult>> Submit(std::vector<IORequest> requests);
+
+    // Information
+    Backend GetBackend() const { return backend; }
+    const char* GetBackendName() const;
+    size_t GetRequestsCompleted() const { return requestsCompleted.load(); }
+    size_t GetRequestsFailed() const { return requestsFailed.load(); }
+    size_t GetBytesRead() const { return bytesRead.load(); }
+    size_t GetBytesWritten() const { return bytesWritten.load(); }
+
+private:
+    void RingLoop();
+    void ExecuteBlocking(Pending& pending);
+    void Complete(Pending& pending, IOResult& result);
+};
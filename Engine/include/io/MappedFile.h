@@ -0,0 +1,42 @@
+#pragma once
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+// MappedFile: Read-only memory mapping of a whole file
+class MappedFile {
+private:
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#else
+    int fileDescriptor = -1;
+#endif
+
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string& filepath);
+    ~MappedFile();
+
+    // Delete copy operations (the mapping is unique)
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Move operations
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    bool Open(const std::string& filepath);
+    void Close();
+
+    bool IsOpen() const { return data != nullptr; }
+    const uint8_t* GetData() const { return data; }
+    size_t GetSize() const { return size; }
+
+private:
+    void Reset();
+};
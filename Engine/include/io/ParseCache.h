@@ -0,0 +1,83 @@
+#pragma once
+
+#include "MappedFile.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// ParseCache: Persistent cache of parse results for text source files.
+// Each entry holds an opaque payload (the caller's binary form of the parse
+// result) keyed by the source's content hash and a caller-supplied version,
+// which should change whenever the payload format or anything it depends on
+// (e.g. component schemas) changes.
+// Entries live in a cache directory, or next to the source as
+// "<source>.pcache" when no directory is set.
+//
+// Validation is layered so unchanged files stay cheap: size and mtime are
+// compared first (a stat plus an mmap of the entry), the source is only
+// hashed when those differ, and a matching hash just refreshes the entry's
+// mtime. Lookups and stores may run concurrently for different sources.
+class ParseCache {
+public:
+    static constexpr uint32_t FormatVersion = 1;
+
+    // Lookup result; on a miss the source stays mapped for parsing
+    struct Entry {
+        bool hit = false;
+        std::string sourcePath;
+        std::string cachePath;
+        uint64_t version = 0;
+        uint64_t sourceSize = 0;
+        int64_t sourceTime = 0;
+        uint64_t contentHash = 0;
+
+        MappedFile source;              // Miss only (not mapped for empty files)
+        MappedFile cacheFile;           // Hit only
+        const uint8_t* payload = nullptr;
+        size_t payloadSize = 0;
+
+        std::string_view GetSourceText() const {
+            return std::string_view(reinterpret_cast<const char*>(source.GetData()), source.GetSize());
+        }
+    };
+
+private:
+    std::string cacheDirectory;
+
+    // Statistics
+    std::atomic<size_t> hits{ 0 };
+    std::atomic<size_t> rehashedHits{ 0 };
+    std::atomic<size_t> misses{ 0 };
+
+public:
+    explicit ParseCache(const std::string& directory = "");
+
+    // Delete copy operations
+    ParseCache(const ParseCache&) = delete;
+    ParseCache& operator=(const ParseCache&) = delete;
+
+    // Returns false only if the source cannot be read
+    bool Lookup(const std::string& sourcePath, uint64_t version, Entry& entry);
+
+    // Write the payload for a missed entry (temp file + rename, so readers
+    // never see a partial entry)
+    bool Store(const Entry& entry, const std::vector<uint8_t>& payload);
+
+    // Configuration
+    const std::string& GetCacheDirectory() const { return cacheDirectory; }
+
+    // Statistics
+    size_t GetHits() const { return hits.load(); }
+    size_t GetRehashedHits() const { return rehashedHits.load(); }
+    size_t GetMisses() const { return misses.load(); }
+    void ResetStatistics();
+
+    // 64-bit content hash used for the keys
+    static uint64_t HashBytes(const void* data, size_t size, uint64_t seed = 0);
+
+private:
+    std::string GetCachePath(const std::string& sourcePath) const;
+};
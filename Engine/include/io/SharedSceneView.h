@@ -0,0 +1,244 @@
+#pragma once
+
+#include "../core/FramePipeline.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Forward declarations
+class Scene;
+
+// Shared view layout (native endianness, one writer, any number of readers):
+//   SharedViewHeader              fixed description of the region
+//   buffer 0, buffer 1            one published frame each
+// A buffer is a SharedViewBuffer followed by the enabled columns at the
+// offsets named in the header (relative to the buffer):
+//   ids        u64 x capacity     GameObject IDs
+//   positions  3 x f32 x capacity X, Y and Z columns (local Transform position,
+//                                 0 for objects without one)
+//   active     u8 x capacity
+//   tags       u32 x capacity     index into the buffer's tag table,
+//              u32 x (maxTags+1)  tag offsets, then the tag characters
+//
+// The writer fills the buffer readers are not pointed at, then flips
+// 'latest'. Each buffer also carries a sequence number that is odd while it
+// is being written, so a reader that is still looking at a buffer when the
+// writer comes back to it (two publishes later) notices and retries.
+namespace SharedViewFormat {
+    constexpr char Magic[4] = { 'G', 'S', 'S', 'V' };
+    constexpr uint32_t Version = 1;
+
+    enum Column : uint32_t {
+        Ids = 1 << 0,
+        Positions = 1 << 1,
+        ActiveFlags = 1 << 2,
+        Tags = 1 << 3,
+        AllColumns = Ids | Positions | ActiveFlags | Tags
+    };
+
+    struct SharedViewBuffer {
+        std::atomic<uint64_t> sequence;
+        uint64_t frame;
+        uint32_t objectCount;
+        uint32_t tagCount;
+        uint32_t tagBytes;
+        uint32_t truncated;         // Objects past capacity were left out
+    };
+
+    struct SharedViewHeader {
+        char magic[4];
+        uint32_t version;
+        uint32_t columns;           // Column mask
+        uint32_t capacity;          // Objects per buffer
+        uint32_t maxTags;
+        uint32_t maxTagBytes;
+        uint64_t bufferSize;
+        uint64_t bufferOffsets[2];  // From the start of the region
+        uint64_t idOffset;          // Column offsets from the start of a buffer
+        uint64_t positionOffsets[3];
+        uint64_t activeOffset;
+        uint64_t tagIndexOffset;
+        uint64_t tagOffsetsOffset;
+        uint64_t tagCharsOffset;
+        std::atomic<uint32_t> latest;
+        uint32_t reserved;
+        std::atomic<uint64_t> publishCount;
+    };
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared view needs address-free atomics");
+    static_assert(sizeof(SharedViewBuffer) == 32, "SharedViewBuffer layout changed");
+    static_assert(sizeof(SharedViewHeader) == 128, "SharedViewHeader layout changed");
+}
+
+// Shared view configuration
+struct SharedSceneViewConfig {
+    std::string name = "GameEngineSceneView";  // Shared memory object name
+    size_t capacity = 65536;                    // Objects per frame; the rest is cut off
+    uint32_t columns = SharedViewFormat::AllColumns;
+    size_t maxTags = 256;                       // Distinct tags per frame
+    size_t maxTagBytes = 16 * 1024;
+    size_t publishIntervalFrames = 1;           // Publish every Nth frame
+};
+
+// Shared memory region (named, read-write for the owner, read-only otherwise)
+class SharedMemoryRegion {
+private:
+    uint8_t* data = nullptr;
+    size_t size = 0;
+    std::string name;
+    bool owner = false;
+
+#ifdef _WIN32
+    void* mappingHandle = nullptr;
+#endif
+
+public:
+    SharedMemoryRegion() = default;
+    ~SharedMemoryRegion();
+
+    // Delete copy operations (the mapping is unique)
+    SharedMemoryRegion(const SharedMemoryRegion&) = delete;
+    SharedMemoryRegion& operator=(const SharedMemoryRegion&) = delete;
+
+    // Create (replacing a stale region of the same name) or open an existing one
+    bool Create(const std::string& regionName, size_t regionSize);
+    bool OpenReadOnly(const std::string& regionName);
+    void Close();
+
+    bool IsOpen() const { return data != nullptr; }
+    uint8_t* GetData() const { return data; }
+    size_t GetSize() const { return size; }
+    const std::string& GetName() const { return name; }
+};
+
+// SharedScenePublisher: Mirrors selected per-object columns of a scene into
+// shared memory once per frame, for external tools (profilers, level viewers,
+// debug overlays) to map and read in place. The engine never waits on
+// readers; publishing from a scene captures a FrameSnapshot first (one pass
+// over the scene's objects), then copies its columns.
+class SharedScenePublisher {
+private:
+    // Column pointers into the buffer being written
+    struct WriteTarget {
+        uint32_t index = 0;
+        uint8_t* base = nullptr;
+        SharedViewFormat::SharedViewBuffer* buffer = nullptr;
+        uint64_t sequence = 0;
+        size_t capacity = 0;
+        uint64_t* ids = nullptr;
+        float* positions[3] = {};
+        uint8_t* active = nullptr;
+        uint32_t* tags = nullptr;
+    };
+
+    SharedSceneViewConfig config;
+    SharedMemoryRegion region;
+    SharedViewFormat::SharedViewHeader* header = nullptr;
+
+    size_t framesSincePublish = 0;
+
+    // Tag table, kept between publishes and reset once it fills up
+    std::unordered_map<std::string, uint32_t> tagIndices;
+    std::vector<uint32_t> tagOffsets;
+    std::string tagChars;
+    std::vector<uint32_t> snapshotTagMap;
+
+    // Reused by Publish(const Scene&)
+    FrameSnapshot sceneSnapshot;
+
+public:
+    SharedScenePublisher() = default;
+    ~SharedScenePublisher() = default;
+
+    // Delete copy operations (owns the region)
+    SharedScenePublisher(const SharedScenePublisher&) = delete;
+    SharedScenePublisher& operator=(const SharedScenePublisher&) = delete;
+
+    bool Open(const SharedSceneViewConfig& viewConfig);
+    void Close();
+    bool IsOpen() const { return header != nullptr; }
+    const SharedSceneViewConfig& GetConfig() const { return config; }
+
+    // Call at the frame boundary; publishes every publishIntervalFrames calls.
+    // The snapshot form copies a FramePipeline snapshot (off the main thread).
+    void Update(const Scene& scene, uint64_t frameNumber);
+    void Update(const FrameSnapshot& snapshot);
+
+    // Publish now
+    void Publish(const Scene& scene, uint64_t frameNumber);
+    void Publish(const FrameSnapshot& snapshot);
+
+    uint64_t GetPublishCount() const;
+
+private:
+    bool ShouldPublish();
+    bool BeginWrite(WriteTarget& target);
+    void EndWrite(WriteTarget& target, uint64_t frameNumber, size_t count, bool truncated);
+    uint32_t GetTagIndex(const std::string& tag);
+};
+
+// One published frame, read in place. The pointers reference shared memory
+// the publisher may reuse, so nothing read through them is trustworthy until
+// SharedSceneReader::Read has returned true; copy out what must outlive it.
+struct SharedSceneFrame {
+    uint64_t frame = 0;
+    size_t objectCount = 0;
+    bool truncated = false;
+
+    const uint64_t* ids = nullptr;          // Null when the column is disabled
+    const float* positionX = nullptr;
+    const float* positionY = nullptr;
+    const float* positionZ = nullptr;
+    const uint8_t* active = nullptr;
+    const uint32_t* tagIndices = nullptr;
+
+    // Tag table (bounds-checked, a torn frame may hold any values)
+    size_t tagCount = 0;
+    const uint32_t* tagOffsets = nullptr;
+    const char* tagChars = nullptr;
+    size_t tagBytes = 0;
+
+    std::string GetTag(size_t objectIndex) const;
+};
+
+// SharedSceneReader: Maps a published view read-only (tool side)
+class SharedSceneReader {
+private:
+    SharedMemoryRegion region;
+    const SharedViewFormat::SharedViewHeader* header = nullptr;
+
+public:
+    bool Open(const std::string& name);
+    void Close();
+    bool IsOpen() const { return header != nullptr; }
+
+    uint64_t GetPublishCount() const;
+
+    // Call 'visitor(const SharedSceneFrame&)' on the latest frame. Returns
+    // true once a visit saw a consistent frame; a visit racing the writer is
+    // discarded and retried up to 'attempts' times.
+    template<typename Visitor>
+    bool Read(Visitor&& visitor, size_t attempts = 8) const {
+        SharedSceneFrame frame;
+        for (size_t attempt = 0; attempt < attempts; ++attempt) {
+            uint32_t buffer = 0;
+            uint64_t sequence = 0;
+            if (!BeginRead(frame, buffer, sequence)) {
+                continue;
+            }
+            visitor(static_cast<const SharedSceneFrame&>(frame));
+            if (EndRead(buffer, sequence)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    const SharedViewFormat::SharedViewBuffer* GetBuffer(uint32_t buffer) const;
+    bool BeginRead(SharedSceneFrame& frame, uint32_t& buffer, uint64_t& sequence) const;
+    bool EndRead(uint32_t buffer, uint64_t sequence) const;
+};
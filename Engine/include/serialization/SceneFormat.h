@@ -0,0 +1,232 @@
+#pragma once
+
+#include "../components/Transform.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Forward declarations
+class Scene;
+class GameObject;
+class AssetArchive;
+class ThreadPool;
+class ComponentSchema;
+
+// Binary scene format (native endianness, every section 16-byte aligned):
+//
+//   FileHeader
+//   SectionEntry[sectionCount]
+//   Strings     : uint32 offsets[count + 1], chars
+//   Objects     : ObjectRecord[objectCount]
+//   Components  : one section per type (nameIndex = type name)
+//                 uint32 objectIndex[count], uint8 active[count], pad to 4,
+//                 uint32 fieldCount, FieldDescriptor[fieldCount],
+//                 then one column of count values per field (4-byte aligned)
+//   Hierarchy   : int32 parentIndex[objectCount] (-1 = root)
+//   Tags        : TagRecord[count], uint32 objectIndex[...]
+//
+// Component fields come from the type's ComponentSchema. Loading matches file
+// fields to schema fields by name and type, so added/removed fields fall back
+// to the schema defaults, and the columns are copied straight into the data
+// image the component is built from.
+namespace SceneFormat {
+
+    constexpr char Magic[4] = { 'S', 'C', 'N', 'B' };
+    constexpr uint32_t Version = 2;
+    constexpr size_t SectionAlignment = 16;
+    constexpr int32_t NoParent = -1;
+
+    enum class SectionType : uint32_t {
+        Strings = 1,
+        Objects = 2,
+        Components = 3,
+        Hierarchy = 4,
+        Tags = 5
+    };
+
+    enum ObjectFlags : uint32_t {
+        ObjectActive = 1 << 0
+    };
+
+    struct FileHeader {
+        char magic[4];
+        uint32_t version;
+        uint64_t fileSize;
+        uint64_t objectCount;
+        uint32_t sectionCount;
+        uint32_t reserved;
+    };
+
+    struct SectionEntry {
+        uint32_t type;
+        uint32_t nameIndex;   // String index (component type name), 0 otherwise
+        uint64_t offset;
+        uint64_t size;
+        uint64_t count;       // Number of records in the section
+    };
+
+    struct ObjectRecord {
+        uint64_t id;          // ID at save time (objects get fresh IDs on load)
+        uint32_t nameIndex;
+        uint32_t tagIndex;
+        uint32_t flags;
+        uint32_t componentCount;
+    };
+
+    struct FieldDescriptor {
+        uint32_t nameIndex;
+        uint32_t type;        // FieldType
+        uint32_t size;
+        uint32_t reserved;
+    };
+
+    struct TagRecord {
+        uint32_t tagIndex;
+        uint32_t firstObject; // Offset into the object index list
+        uint32_t objectCount;
+        uint32_t reserved;
+    };
+
+    static_assert(sizeof(FileHeader) == 32, "FileHeader layout changed");
+    static_assert(sizeof(SectionEntry) == 32, "SectionEntry layout changed");
+    static_assert(sizeof(ObjectRecord) == 24, "ObjectRecord layout changed");
+    static_assert(sizeof(FieldDescriptor) == 16, "FieldDescriptor layout changed");
+    static_assert(sizeof(Vector3) == 3 * sizeof(float), "Vector3 must be tightly packed");
+
+    inline size_t AlignSize(size_t value, size_t alignment = SectionAlignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+}
+
+// Column view of one component field
+struct SceneFieldColumn {
+    std::string_view name;
+    uint32_t type = 0;
+    uint32_t size = 0;
+    const uint8_t* values = nullptr;      // count * size bytes
+};
+
+// Column view of one component section
+struct SceneComponentColumn {
+    std::string_view typeName;
+    size_t count = 0;
+    const uint32_t* objectIndices = nullptr;
+    const uint8_t* activeFlags = nullptr;
+    std::vector<SceneFieldColumn> fields;
+};
+
+// SceneFileView: Validated, non-owning view over a binary scene image
+class SceneFileView {
+private:
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    const SceneFormat::FileHeader* header = nullptr;
+    const SceneFormat::SectionEntry* sections = nullptr;
+
+    // Resolved sections
+    const uint32_t* stringOffsets = nullptr;
+    const char* stringChars = nullptr;
+    size_t stringCount = 0;
+    size_t stringBytes = 0;
+
+    const SceneFormat::ObjectRecord* objects = nullptr;
+    const int32_t* parentIndices = nullptr;
+    const SceneFormat::TagRecord* tags = nullptr;
+    const uint32_t* tagObjectIndices = nullptr;
+    size_t tagCount = 0;
+
+    std::vector<SceneComponentColumn> componentColumns;
+
+public:
+    SceneFileView() = default;
+
+    // Validates the header and every section against the image bounds
+    bool Open(const uint8_t* imageData, size_t imageSize);
+    bool IsValid() const { return header != nullptr; }
+
+    size_t GetObjectCount() const { return header ? static_cast<size_t>(header->objectCount) : 0; }
+    const SceneFormat::ObjectRecord& GetObject(size_t index) const { return objects[index]; }
+    int32_t GetParentIndex(size_t index) const { return parentIndices ? parentIndices[index] : SceneFormat::NoParent; }
+
+    std::string_view GetString(uint32_t index) const;
+
+    const std::vector<SceneComponentColumn>& GetComponentColumns() const { return componentColumns; }
+    const SceneComponentColumn* FindComponentColumn(std::string_view typeName) const;
+
+    size_t GetTagCount() const { return tagCount; }
+    const SceneFormat::TagRecord& GetTag(size_t index) const { return tags[index]; }
+
+private:
+    bool ParseComponentSection(const SceneFormat::SectionEntry& section, size_t objectCount);
+
+    template<typename T>
+    const T* SectionData(const SceneFormat::SectionEntry& section, size_t offset, size_t count) const;
+};
+
+// SceneCapture: Copy of a scene's saveable state in save-ready columns.
+// Capture walks the live scene and must run on the main thread between
+// frames; Encode only reads the copy, so it can run on any thread while the
+// scene keeps changing.
+class SceneCapture {
+private:
+    // Components of one schema, gathered column-wise while walking the scene
+    struct ComponentGroup {
+        const ComponentSchema* schema = nullptr;
+        std::vector<uint32_t> objectIndices;
+        std::vector<uint8_t> activeFlags;
+        std::vector<std::vector<uint8_t>> fieldColumns;
+    };
+
+    // Per object; names and tags are interned by Encode
+    std::vector<SceneFormat::ObjectRecord> objects;
+    std::vector<std::string> names;
+    std::vector<std::string> tags;
+
+    // Hierarchy as object addresses, resolved to indices by Encode
+    std::vector<const GameObject*> objectAddresses;
+    std::vector<const GameObject*> parentAddresses;
+
+    std::vector<ComponentGroup> groups;
+
+public:
+    // Copies the scene (buffers from the previous capture are reused)
+    void Capture(const Scene& scene);
+
+    // Scene file image (BlockCompression frame if 'compress')
+    std::vector<uint8_t> Encode(bool compress, ThreadPool* pool = nullptr) const;
+
+    void Clear();
+    size_t GetObjectCount() const { return objects.size(); }
+    size_t GetComponentCount() const;
+
+private:
+    ComponentGroup& GetGroup(const ComponentSchema* schema);
+};
+
+// SceneSerializer: Writes and loads the binary scene format
+// A compressed scene is the same image wrapped in a BlockCompression frame;
+// loading detects it and decompresses block-parallel before reading.
+class SceneSerializer {
+public:
+    // Save (the two-argument form uses the compression default below)
+    static bool Save(const Scene& scene, const std::string& filepath);
+    static bool Save(const Scene& scene, const std::string& filepath, bool compress);
+    static std::vector<uint8_t> SaveToMemory(const Scene& scene, bool compress = false);
+
+    // Load (appends the file's objects to the scene)
+    static bool Load(Scene& scene, const std::string& filepath);
+    static bool LoadFromMemory(Scene& scene, const uint8_t* data, size_t size);
+    static bool Load(Scene& scene, const AssetArchive& archive, const std::string& path);
+
+    // Component types that can be saved and loaded (those with a schema)
+    static std::vector<std::string> GetSupportedComponentTypes();
+
+    // Compression default for Save, and the pool compressed images are coded on
+    static void SetCompressionEnabled(bool enabled);
+    static bool IsCompressionEnabled();
+    static void SetThreadPool(ThreadPool* pool);
+    static ThreadPool* GetThreadPool();
+};
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "SceneFormat.h"
+#include "../io/MappedFile.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+// Forward declarations
+class Scene;
+class Transform;
+class ComponentSchema;
+
+// Work allowed per Step() call; zero means unlimited
+struct SceneLoadBudget {
+    size_t maxObjects = 0;
+    size_t maxMicroseconds = 0;
+
+    SceneLoadBudget() = default;
+    SceneLoadBudget(size_t objects, size_t microseconds)
+        : maxObjects(objects), maxMicroseconds(microseconds) {
+    }
+
+    static SceneLoadBudget Unlimited() { return SceneLoadBudget(); }
+};
+
+enum class SceneLoadState {
+    Idle,
+    Instantiating,  // Creating objects and components
+    Linking,        // Resolving the transform hierarchy
+    Complete,
+    Failed
+};
+
+// SceneStreamReader: Resumable loader for the binary scene format.
+// Objects are created into a staging scene that nobody else can see until
+// TakeScene() hands it over, so Step() may run on a worker thread.
+class SceneStreamReader {
+private:
+    MappedFile file;
+    std::vector<uint8_t> decompressed;    // Image of a compressed scene file
+    SceneFileView view;
+
+    std::unique_ptr<Scene> stagingScene;
+    Scene* targetScene = nullptr;
+    SceneLoadState state = SceneLoadState::Idle;
+    std::string sourceName;
+    size_t objectCount = 0;
+
+    // File field column copied into a schema image
+    struct FieldCopy {
+        const uint8_t* values;
+        uint32_t offset;
+        uint32_t size;
+    };
+
+    // Component column resolved against its registered schema
+    struct ColumnCursor {
+        const SceneComponentColumn* column = nullptr;
+        const ComponentSchema* schema = nullptr;
+        std::vector<FieldCopy> copies;
+        size_t cursor = 0;
+        bool isTransform = false;
+    };
+
+    // Cursors
+    size_t nextObject = 0;
+    size_t nextLink = 0;
+    std::vector<ColumnCursor> columns;
+    std::vector<uint64_t> componentImage;
+
+    std::vector<Transform*> loadedTransforms;
+
+    // Statistics
+    size_t stepCount = 0;
+    float totalStepTime = 0.0f;
+    float longestStepTime = 0.0f;
+
+public:
+    SceneStreamReader() = default;
+    ~SceneStreamReader();
+
+    // Delete copy operations
+    SceneStreamReader(const SceneStreamReader&) = delete;
+    SceneStreamReader& operator=(const SceneStreamReader&) = delete;
+
+    // Begin loading; with no target the reader creates its own staging scene
+    bool Open(const std::string& filepath, const std::string& sceneName = "Scene");
+    bool OpenMemory(const uint8_t* data, size_t size, Scene& target);
+
+    // Advance the load within the budget; returns true once finished (or failed)
+    bool Step(const SceneLoadBudget& budget);
+
+    // Run to completion
+    bool LoadAll();
+
+    // Hand over the staging scene (only once complete)
+    std::unique_ptr<Scene> TakeScene();
+
+    // State
+    SceneLoadState GetState() const { return state; }
+    bool IsComplete() const { return state == SceneLoadState::Complete; }
+    bool IsFailed() const { return state == SceneLoadState::Failed; }
+    bool IsFinished() const { return IsComplete() || IsFailed(); }
+    float GetProgress() const;
+
+    size_t GetObjectCount() const { return objectCount; }
+    size_t GetLoadedObjectCount() const { return nextObject; }
+    size_t GetStepCount() const { return stepCount; }
+    float GetTotalStepTime() const { return totalStepTime; }
+    float GetLongestStepTime() const { return longestStepTime; }
+
+private:
+    bool OpenView(const uint8_t* data, size_t size);
+    bool Begin(Scene& target);
+    void InstantiateObject(size_t index);
+    void LinkObject(size_t index);
+    void ReportSkippedColumns() const;
+};
@@ -0,0 +1,279 @@
+#pragma once
+
+#include "SceneFormat.h"
+#include "../io/IOService.h"
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <utility>
+#include <typeinfo>
+#include <future>
+#include <cstddef>
+#include <cstdint>
+
+// Forward declarations
+class Scene;
+class GameObject;
+class Component;
+class ComponentSchema;
+class ThreadPool;
+
+// Journal file layout (native endianness):
+//   JournalHeader                identifies the snapshot the journal follows
+//   batches                      one per recorded frame with changes
+// A batch is a JournalBatchHeader plus 'payloadSize' bytes of records; the
+// hash covers the payload, so a batch torn by a crash ends the replay.
+//
+// Records start with a JournalOp byte and are packed without padding:
+//   DefineType       u16 type, u8 nameLength, name, u16 fieldCount,
+//                    fieldCount x (u8 nameLength, name, u8 fieldType, u8 size)
+//   Create           u64 object, u16 nameLength, name, u16 tagLength, tag,
+//                    u8 active, u8 componentCount, componentCount x component
+//   Destroy          u64 object
+//   SetActive        u64 object, u8 active
+//   SetParent        u64 object, u64 parent (0 = none)
+//   SetTag/SetName   u64 object, u16 length, text
+//   SetField         u64 object, u16 type, u16 field, value
+//   AddComponent     u64 object, component
+//   RemoveComponent  u64 object, u16 type
+//   SetComponentActive u64 object, u16 type, u8 active
+// where a component is u16 type, u8 active, then every field's value.
+namespace JournalFormat {
+    constexpr char Magic[4] = { 'W', 'J', 'N', 'L' };
+    constexpr uint32_t Version = 1;
+    constexpr uint32_t BatchMagic = 0x5442574A;     // "JWBT"
+
+    enum class JournalOp : uint8_t {
+        DefineType = 1,
+        Create,
+        Destroy,
+        SetActive,
+        SetParent,
+        SetTag,
+        SetName,
+        SetField,
+        AddComponent,
+        RemoveComponent,
+        SetComponentActive
+    };
+
+    struct JournalHeader {
+        char magic[4];
+        uint32_t version;
+        uint64_t snapshotHash;      // ParseCache::HashBytes of the snapshot file
+        uint64_t snapshotSize;
+        uint64_t snapshotFrame;
+    };
+
+    struct JournalBatchHeader {
+        uint32_t magic;
+        uint32_t payloadSize;
+        uint64_t frame;
+        uint64_t payloadHash;
+    };
+
+    static_assert(sizeof(JournalHeader) == 32, "JournalHeader layout changed");
+    static_assert(sizeof(JournalBatchHeader) == 24, "JournalBatchHeader layout changed");
+}
+
+// Journal configuration
+struct WorldJournalConfig {
+    std::string snapshotPath = "world.snapshot";
+    std::string journalPath = "world.journal";
+
+    // Frames recorded between fdatasyncs of the journal (1 = every frame)
+    size_t syncIntervalFrames = 30;
+
+    // Automatic checkpoints: after this many frames, or once the journal has
+    // grown past maxJournalBytes (0 disables either trigger)
+    size_t checkpointIntervalFrames = 0;
+    size_t maxJournalBytes = 64 * 1024 * 1024;
+
+    bool compressSnapshots = true;
+};
+
+// Outcome of WorldJournal::Recover
+struct JournalReplayStats {
+    bool snapshotLoaded = false;
+    bool journalUsed = false;       // False if missing or written for another snapshot
+    bool tornTail = false;          // Replay stopped at an incomplete or corrupt batch
+    size_t snapshotObjects = 0;
+    size_t batches = 0;
+    size_t records = 0;
+    uint64_t snapshotFrame = 0;
+    uint64_t lastFrame = 0;         // Frame of the last replayed batch
+    float snapshotLoadTime = 0.0f;  // Milliseconds
+    float replayTime = 0.0f;
+};
+
+// WorldJournal: Write-ahead log of world mutations between full snapshots.
+// RecordFrame diffs the scene against the state it last recorded (objects by
+// ID, components by schema, fields by value) and appends the changes as one
+// batch through the IOService. Writes are issued one at a time so they land
+// in order; batches recorded while one is in flight are merged into the next
+// write. The journal is fdatasynced every syncIntervalFrames frames.
+// A scan costs about two passes over the scene's components; large worlds
+// can record every few frames, each batch then holds everything since the
+// previous one.
+//
+// A checkpoint writes a full scene snapshot (temp file, synced, renamed) and
+// then starts a fresh journal whose header names that snapshot by hash, so
+// a crash at any point leaves a snapshot plus a journal that either belongs
+// to it or is ignored. If the snapshot cannot be written the old journal is
+// kept: what was recorded meanwhile is appended to it and the checkpoint is
+// retried when next due. Recover loads the snapshot and replays the journal.
+class WorldJournal {
+private:
+    // Ordered I/O step; 'renameTo' is applied once the request succeeded
+    struct IOStep {
+        IORequest request;
+        std::string renameTo;
+        uint64_t lastFrame = 0;
+        bool snapshot = false;          // Checkpoint snapshot; the next step replaces the journal
+        bool newJournal = false;        // Replaces the journal; dropped if its snapshot failed
+        size_t previousJournalBytes = 0;
+    };
+
+    // Recorded state of one component
+    struct TrackedComponent {
+        const ComponentSchema* schema = nullptr;
+        bool active = true;
+        size_t imageOffset = 0;     // Into the image words
+    };
+
+    // Recorded state of one object
+    struct TrackedObject {
+        uint64_t id = 0;
+        uint64_t parentId = 0;
+        bool active = true;
+        uint32_t firstComponent = 0;
+        uint32_t componentCount = 0;
+        std::string name;
+        std::string tag;
+    };
+
+    // Recorded state, double-buffered: a scan fills 'next' from the scene
+    // while comparing against 'current', then the two swap
+    struct TrackedState {
+        std::vector<TrackedObject> objects;
+        std::vector<TrackedComponent> components;
+        std::vector<uint64_t> images;
+        std::unordered_map<uint64_t, size_t> indices;   // Built on demand
+        bool indexed = false;
+
+        void Clear();
+        void Index();
+    };
+
+    WorldJournalConfig config;
+    bool open = false;
+
+    TrackedState current;
+    TrackedState next;
+    std::vector<uint8_t> seen;
+
+    // Schema per component type, valid for one scan
+    std::vector<std::pair<const std::type_info*, const ComponentSchema*>> schemaCache;
+    const ComponentSchema* transformSchema = nullptr;
+
+    // Component types defined in the current journal file
+    std::unordered_map<const ComponentSchema*, uint16_t> typeIds;
+
+    // Records of the frame being scanned
+    std::vector<uint8_t> records;
+    size_t recordCount = 0;
+    std::vector<std::pair<uint64_t, uint64_t>> parentChanges;
+
+    // Ordered writes
+    std::deque<IOStep> ioQueue;
+    std::future<IOResult> ioInFlight;
+    std::string ioRenameTo;
+    uint64_t ioLastFrame = 0;
+    bool ioSyncing = false;
+    bool ioSnapshot = false;
+    bool ioNewJournal = false;
+    bool journalStarted = false;    // A journal of this session is on disk
+    size_t framesSinceSync = 0;
+    bool hasUnsynced = false;
+    uint64_t lastBatchFrame = 0;
+
+    // Checkpoint being encoded; batches recorded meanwhile open the new journal
+    SceneCapture checkpointCapture;
+    std::future<std::vector<uint8_t>> checkpointImage;
+    std::vector<uint8_t> checkpointTail;
+    uint64_t checkpointTailFrame = 0;
+    uint64_t checkpointFrame = 0;
+    uint64_t lastCheckpointFrame = 0;
+    size_t replacedJournalBytes = 0;    // Size of the journal the checkpoint replaces
+    ThreadPool* threadPool = nullptr;
+
+    // Statistics
+    size_t journalBytes = 0;
+    size_t totalBatches = 0;
+    size_t totalRecords = 0;
+    size_t checkpointCount = 0;
+    size_t writeErrors = 0;
+    uint64_t durableFrame = 0;
+
+public:
+    WorldJournal() = default;
+    ~WorldJournal();
+
+    // Delete copy operations (owns in-flight writes)
+    WorldJournal(const WorldJournal&) = delete;
+    WorldJournal& operator=(const WorldJournal&) = delete;
+
+    // Start journaling 'scene': writes a checkpoint of its current state
+    bool Open(const Scene& scene, const WorldJournalConfig& journalConfig, uint64_t frameNumber = 0);
+    void Close();
+    bool IsOpen() const { return open; }
+    const WorldJournalConfig& GetConfig() const { return config; }
+
+    // Call once per frame, after the frame's mutations
+    void RecordFrame(const Scene& scene, uint64_t frameNumber);
+
+    // Full snapshot now; the journal restarts empty after it
+    void Checkpoint(const Scene& scene, uint64_t frameNumber);
+
+    // Block until everything recorded is written (and synced if 'sync')
+    void Flush(bool sync = true);
+
+    // Pool for encoding checkpoint snapshots off the main thread (optional)
+    void SetThreadPool(ThreadPool* pool) { threadPool = pool; }
+
+    // Statistics
+    size_t GetJournalBytes() const { return journalBytes; }
+    size_t GetBatchCount() const { return totalBatches; }
+    size_t GetRecordCount() const { return totalRecords; }
+    size_t GetCheckpointCount() const { return checkpointCount; }
+    size_t GetWriteErrorCount() const { return writeErrors; }
+    uint64_t GetDurableFrame() const { return durableFrame; }
+    size_t GetTrackedObjectCount() const { return current.objects.size(); }
+
+    // Rebuild the world: load the snapshot into 'scene', then replay the
+    // journal written after it (objects get fresh IDs, as with any load)
+    static bool Recover(Scene& scene, const std::string& snapshotPath, const std::string& journalPath,
+        JournalReplayStats* stats = nullptr);
+
+private:
+    // Diff the scene against the recorded state ('emit' false only rebaselines)
+    void Scan(const Scene& scene, bool emit);
+    void ScanComponents(const GameObject& gameObject, const TrackedObject* previous, TrackedObject& tracked, bool emit);
+    const ComponentSchema* FindSchema(const Component& component);
+
+    // Record encoding
+    uint16_t GetTypeId(const ComponentSchema* schema);
+    void BeginRecord(JournalFormat::JournalOp op, uint64_t objectId);
+    void WriteComponent(const TrackedComponent& component, const uint8_t* image);
+    void WriteString(const std::string& value);
+
+    // Batches and ordered I/O
+    void AppendBatch(uint64_t frameNumber);
+    void QueueAppend(std::vector<uint8_t> bytes, uint64_t lastFrame);
+    void RequestSync();
+    void StartCheckpointWrites(std::vector<uint8_t> image);
+    void KeepJournalAfterFailedSnapshot();
+    void PumpIO(bool wait);
+    bool IsIOIdle() const;
+};
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <cstddef>
+#include <cstdint>
+
+// Forward declarations
+class Scene;
+class ComponentSchema;
+
+// WorldSnapshot: Per-object state of a scene captured at one frame.
+// State is stored column-wise as 32-bit words so consecutive snapshots XOR to
+// long runs of zeros: one flags column, then a column set per component
+// schema with fields (a presence word, then the schema's data image split
+// into words). Components are captured and restored through the schema's
+// capture/apply functions, so every reflected component takes part.
+class WorldSnapshot {
+public:
+    enum ObjectFlags : uint32_t {
+        ObjectActive = 1 << 0
+    };
+
+    enum ComponentFlags : uint32_t {
+        ComponentPresent = 1 << 0,
+        ComponentActive = 1 << 1
+    };
+
+    // Columns of one component schema
+    struct ColumnSet {
+        const ComponentSchema* schema = nullptr;   // Null if not registered when decoded
+        std::string typeName;
+        uint32_t wordsPerObject = 0;                // Image words after the presence word
+        size_t firstColumn = 0;
+
+        bool operator==(const ColumnSet& other) const {
+            return typeName == other.typeName && wordsPerObject == other.wordsPerObject;
+        }
+    };
+
+private:
+    uint64_t frame = 0;
+    std::vector<uint64_t> objectIds;
+    std::vector<ColumnSet> columnSets;          // Sorted by type name
+    size_t columnCount = 1;
+    std::vector<uint32_t> stateWords;           // columnCount columns of objectIds.size() words
+
+public:
+    WorldSnapshot() = default;
+
+    // Capture reuses this snapshot's buffers, so keep snapshots around between frames
+    void Capture(const Scene& scene, uint64_t frameNumber = 0);
+
+    // Writes state back to the objects with matching IDs; objects that no
+    // longer exist are skipped and new objects are left untouched, as are
+    // components added or removed since the capture.
+    // Returns the number of objects restored.
+    size_t Restore(Scene& scene) const;
+
+    uint64_t GetFrame() const { return frame; }
+    size_t GetObjectCount() const { return objectIds.size(); }
+    size_t GetColumnCount() const { return columnCount; }
+    const std::vector<uint64_t>& GetObjectIds() const { return objectIds; }
+    const std::vector<ColumnSet>& GetColumnSets() const { return columnSets; }
+    const std::vector<uint32_t>& GetStateWords() const { return stateWords; }
+    const ColumnSet* FindColumnSet(const std::string& typeName) const;
+
+    // Per-object accessors
+    uint32_t GetFlags(size_t index) const { return stateWords[index]; }
+    uint32_t GetComponentFlags(const ColumnSet& set, size_t index) const;
+
+    // Copies the object's component image (at least wordsPerObject words);
+    // false if the object had no such component
+    bool ReadComponentImage(const ColumnSet& set, size_t index, void* image) const;
+
+    // True when both snapshots describe the same objects and columns in the same order
+    bool HasSameLayout(const WorldSnapshot& other) const {
+        return objectIds == other.objectIds && columnSets == other.columnSets;
+    }
+
+    void Clear();
+
+private:
+    friend class SnapshotCodec;
+    void Resize(size_t objectCount);
+    void LayoutColumns();
+};
+
+// SnapshotCodec: Keyframe / delta encoding of snapshots.
+// Deltas XOR the state words against a base snapshot and run-length encode
+// the zero words, so unchanged objects cost close to nothing. The encoding is
+// lossless, which rollback needs to resimulate bit-identically. The payload
+// can additionally be LZ-compressed (kept only when it shrinks), which mostly
+// pays off for keyframes: default scales and zero rotations repeat.
+class SnapshotCodec {
+public:
+    // Encodes a delta against base, or a keyframe when base is null or its
+    // object layout differs. Output is appended to 'out'.
+    static void Encode(const WorldSnapshot& snapshot, const WorldSnapshot* base, std::vector<uint8_t>& out,
+        bool compress = false);
+
+    // Decodes into 'out'; deltas need the same base they were encoded against
+    static bool Decode(const uint8_t* data, size_t size, const WorldSnapshot* base, WorldSnapshot& out);
+
+    static bool IsKeyframe(const uint8_t* data, size_t size);
+};
+
+// SnapshotHistory: Ring of encoded snapshots for replay and rollback.
+// Every keyframeInterval-th frame (and any frame whose layout changed) is a
+// keyframe; other frames are deltas against the previous frame.
+class SnapshotHistory {
+private:
+    struct Entry {
+        uint64_t frame = 0;
+        bool keyframe = false;
+        std::vector<uint8_t> bytes;
+    };
+
+    std::deque<Entry> entries;
+    size_t capacity;
+    size_t keyframeInterval;
+
+    WorldSnapshot lastSnapshot;
+    WorldSnapshot scratch;
+    bool hasLast = false;
+    bool compressFrames = false;
+    size_t framesSinceKeyframe = 0;
+    size_t totalBytes = 0;
+
+public:
+    SnapshotHistory(size_t maxFrames = 600, size_t keyframeEvery = 60);
+
+    // Capture and append the scene's current state
+    void Record(const Scene& scene, uint64_t frameNumber);
+
+    // Reconstruct the snapshot of a recorded frame
+    bool GetSnapshot(uint64_t frameNumber, WorldSnapshot& out) const;
+
+    // Restore the scene to a recorded frame and drop everything after it
+    bool Rollback(Scene& scene, uint64_t frameNumber);
+
+    void Clear();
+
+    // LZ-compress recorded frames (costs encode time on Record)
+    void SetCompressionEnabled(bool enabled) { compressFrames = enabled; }
+    bool IsCompressionEnabled() const { return compressFrames; }
+
+    size_t GetFrameCount() const { return entries.size(); }
+    size_t GetTotalBytes() const { return totalBytes; }
+    bool HasFrame(uint64_t frameNumber) const;
+    uint64_t GetOldestFrame() const { return entries.empty() ? 0 : entries.front().frame; }
+    uint64_t GetNewestFrame() const { return entries.empty() ? 0 : entries.back().frame; }
+
+private:
+    void TrimToCapacity();
+};
@@ -9,6 +9,7 @@
 #include <typeindex>
 #include <functional>
 #include <string>
+#include <atomic>
 
 // Forward declarations
 class GameObject;
@@ -45,6 +46,11 @@ private:
     std::vector<Component*> allActiveComponents;
     bool componentsDirty = true;
 
+    // Registered instance counts, kept current by Register/Unregister and
+    // Component::SetActive
+    size_t instanceCount = 0;
+    std::atomic<size_t> activeInstanceCount{ 0 };
+
     // Singleton instance
     static ComponentManager* instance;
 
@@ -98,13 +104,17 @@ public:
     void RegisterComponentInstance(Component* component);
     void UnregisterComponentInstance(Component* component);
 
+    // Called by Component::SetActive for registered instances
+    static void OnInstanceActiveChanged(bool isActive);
+
     // Batch processing support
     const std::vector<Component*>& GetAllActiveComponents();
     void RefreshComponentCache();
 
     // Component statistics
     size_t GetComponentTypeCount() const { return componentTypes.size(); }
-    size_t GetActiveComponentCount() const;
+    size_t GetComponentCount() const { return instanceCount; }
+    size_t GetActiveComponentCount() const { return activeInstanceCount.load(std::memory_order_relaxed); }
     size_t GetComponentCountOfType(const std::type_index& typeIndex) const;
 
     template<typename T>
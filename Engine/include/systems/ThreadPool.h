@@ -83,6 +83,15 @@ private:
     size_t CalculateOptimalBatchSize(size_t totalItems) const;
 };
 
+// Runs work(begin, end) over [0, count) in up to 'chunkCount' equal chunks:
+// the pool takes all chunks but the first, which the calling thread runs.
+// Every chunk finishes before the first exception is rethrown, since chunks
+// usually write the caller's buffers. Runs inline without a pool or when
+// there is only one chunk. The caller's share means a pool whose workers
+// are all busy still makes progress, but don't call it from a pool's own
+// worker while waiting on that pool elsewhere.
+void ParallelFor(ThreadPool* pool, size_t count, size_t chunkCount, const std::function<void(size_t, size_t)>& work);
+
 // Specialized batch processing functions for game engine components
 namespace BatchProcessing {
     // Transform batch operations
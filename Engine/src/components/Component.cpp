@@ -0,0 +1,15 @@
+#include "../include/components/Component.h"
+#include "../include/core/GameObject.h"
+#include "../include/systems/ComponentManager.h"
+
+void Component::SetActive(bool isActive) {
+    if (active == isActive) return;
+    active = isActive;
+
+    if (owner) {
+        owner->OnComponentActiveChanged(isActive);
+    }
+    if (tracked) {
+        ComponentManager::OnInstanceActiveChanged(isActive);
+    }
+}
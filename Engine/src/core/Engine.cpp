@@ -52,7 +52,7 @@ bool Engine::Initialize(const EngineConfig& engineConfig) {
     std::cout << "\n=== Initializing Game Engine ===" << std::endl;
 
     // Initialize timing
-    targetFrameTime = std::chrono::duration<float>(1.0f / config.targetFrameRate);
+    framePacer.SetTargetFrameRate(config.targetFrameRate);
     fixedDeltaTime = 1.0f / config.fixedUpdateRate;
 
     // Initialize all systems
@@ -91,11 +91,52 @@ void Engine::Run() {
 
     // Reset timing
     lastFrameTime = std::chrono::high_resolution_clock::now();
+    runStartTime = lastFrameTime;
+    stats.simulatedTime = 0.0;
+    framePacer.Reset();
 
     // Main game loop
     MainLoop();
 
     std::cout << "Engine stopped" << std::endl;
+    if (config.headless) {
+        double wallTime = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - runStartTime).count();
+        stats.simulationSpeed = wallTime > 0.0 ? static_cast<float>(stats.simulatedTime / wallTime) : 0.0f;
+        std::cout << "Simulated " << stats.simulatedTime << "s at " << stats.simulationSpeed
+            << " simulated seconds per second" << std::endl;
+    }
+}
+
+HeadlessRunStats Engine::RunFrames(size_t frameCount) {
+    HeadlessRunStats result;
+    if (state.load() != EngineState::Stopped) {
+        std::cerr << "Engine must be stopped to run frames" << std::endl;
+        return result;
+    }
+
+    state = EngineState::Running;
+
+    lastFrameTime = std::chrono::high_resolution_clock::now();
+    runStartTime = lastFrameTime;
+    stats.simulatedTime = 0.0;
+    framePacer.Reset();
+
+    // Stop() ends the run early; Pause() is not meaningful here and ends it too
+    while (result.frames < frameCount && state.load() == EngineState::Running) {
+        RunFrame();
+        ++result.frames;
+    }
+
+    auto runEnd = std::chrono::high_resolution_clock::now();
+    result.simulatedSeconds = stats.simulatedTime;
+    result.wallSeconds = std::chrono::duration<double>(runEnd - runStartTime).count();
+    if (result.wallSeconds > 0.0) {
+        result.simulatedSecondsPerWallSecond = result.simulatedSeconds / result.wallSeconds;
+    }
+    stats.simulationSpeed = static_cast<float>(result.simulatedSecondsPerWallSecond);
+
+    state = EngineState::Stopped;
+    return result;
 }
 
 void Engine::Stop() {
@@ -116,6 +157,7 @@ void Engine::Resume() {
     if (state.load() == EngineState::Paused) {
         state = EngineState::Running;
         lastFrameTime = std::chrono::high_resolution_clock::now(); // Reset timing
+        framePacer.Reset();
         std::cout << "Engine resumed" << std::endl;
     }
 }
@@ -155,7 +197,7 @@ void Engine::SetConfig(const EngineConfig& newConfig) {
         ConfigureSystems();
 
         // Update timing
-        targetFrameTime = std::chrono::duration<float>(1.0f / config.targetFrameRate);
+        framePacer.SetTargetFrameRate(config.targetFrameRate);
         fixedDeltaTime = 1.0f / config.fixedUpdateRate;
     }
 }
@@ -219,6 +261,8 @@ void Engine::PrintEngineInfo() const {
     std::cout << "  Target FPS: " << config.targetFrameRate << std::endl;
     std::cout << "  Fixed Update Rate: " << config.fixedUpdateRate << std::endl;
     std::cout << "  VSync: " << (config.enableVSync ? "Enabled" : "Disabled") << std::endl;
+    std::cout << "  Headless: " << (config.headless ? "Enabled" : "Disabled") << std::endl;
+    std::cout << "  Pipelined Frames: " << (config.pipelineFrames ? "Enabled" : "Disabled") << std::endl;
 }
 
 void Engine::PrintPerformanceStats() const {
@@ -231,8 +275,30 @@ void Engine::PrintPerformanceStats() const {
     std::cout << "Update Time: " << stats.updateTime << "ms" << std::endl;
     std::cout << "Late Update Time: " << stats.lateUpdateTime << "ms" << std::endl;
     std::cout << "Fixed Update Time: " << stats.fixedUpdateTime << "ms" << std::endl;
+
+    // Percentiles read live from the histograms (window / whole run)
+    static const char* phaseNames[] = { "Update", "Late Update", "Fixed Update", "Frame" };
+    std::cout << "Phase Times p50/p90/p99/p99.9/max (ms, window | run):" << std::endl;
+    for (size_t phase = 0; phase < static_cast<size_t>(FramePhase::Count); ++phase) {
+        FrameTimeSummary window = phaseTimes[phase].GetWindowSummary();
+        FrameTimeSummary run = phaseTimes[phase].GetRunSummary();
+        std::cout << "  " << std::left << std::setw(13) << phaseNames[phase] << std::right
+            << window.p50 << " / " << window.p90 << " / " << window.p99 << " / " << window.p999 << " / " << window.max
+            << " | " << run.p50 << " / " << run.p90 << " / " << run.p99 << " / " << run.p999 << " / " << run.max
+            << std::endl;
+    }
+    std::cout << "Frames Over Budget: " << GetFrameTimes(FramePhase::Frame).GetRunSummary().spikes << std::endl;
+    if (config.enableVSync) {
+        std::cout << "Pacing Error p50/p99/max: " << stats.pacingErrorP50 << " / " << stats.pacingErrorP99
+            << " / " << stats.pacingErrorMax << "us (" << stats.missedFrameDeadlines << " missed)" << std::endl;
+    }
     std::cout << "Total Frames: " << stats.totalFrames << std::endl;
     std::cout << "Total Run Time: " << stats.totalRunTime << "s" << std::endl;
+    if (config.pipelineFrames) {
+        std::cout << "Snapshot Extract / Pipeline Wait: " << stats.snapshotExtractTime << " / "
+            << stats.pipelineWaitTime << "ms" << std::endl;
+    }
+    std::cout << "Simulated Time: " << stats.simulatedTime << "s (" << stats.simulationSpeed << "x)" << std::endl;
 }
 
 void Engine::PrintMemoryStats() const {
@@ -275,17 +341,7 @@ void Engine::MainLoop() {
             continue;
         }
 
-        // Calculate timing
-        CalculateTiming();
-
-        // Update frame
-        UpdateFrame();
-
-        // Update statistics
-        UpdateStatistics();
-
-        // Handle frame rate limiting
-        HandleFrameRate();
+        RunFrame();
 
         // Check for stop signal
         if (state.load() == EngineState::Stopping) {
@@ -297,6 +353,26 @@ void Engine::MainLoop() {
     TriggerStopCallbacks();
 }
 
+void Engine::RunFrame() {
+    // Calculate timing
+    CalculateTiming();
+
+    // Advance time-sliced scene loads before the frame sees the scene list
+    sceneManager.UpdatePendingLoads();
+
+    // Capture queued background saves and report finished ones
+    sceneManager.UpdatePendingSaves();
+
+    // Update frame
+    UpdateFrame();
+
+    // Update statistics
+    UpdateStatistics();
+
+    // Handle frame rate limiting
+    HandleFrameRate();
+}
+
 void Engine::UpdateFrame() {
     auto frameStart = std::chrono::high_resolution_clock::now();
 
@@ -305,6 +381,9 @@ void Engine::UpdateFrame() {
         return; // No scene to update
     }
 
+    // Stream world cells in/out within their own frame budget
+    sceneManager.UpdateStreaming();
+
     // Update systems (MAIN REQUIREMENT #5: THREADED UPDATES!)
     auto updateStart = std::chrono::high_resolution_clock::now();
     systemManager.UpdateSystems(currentScene, deltaTime);
@@ -325,15 +404,43 @@ void Engine::UpdateFrame() {
     stats.lateUpdateTime = std::chrono::duration<float, std::milli>(lateUpdateEnd - lateUpdateStart).count();
     stats.fixedUpdateTime = std::chrono::duration<float, std::milli>(fixedUpdateEnd - fixedUpdateStart).count();
 
+    // Frame boundary: apply edited templates to live objects
+    if (hotReloader) {
+        hotReloader->Update(*currentScene,
+            SceneLoadBudget(config.hotReloadObjectsPerFrame, config.hotReloadMicrosecondsPerFrame));
+    }
+
+    // Hand the finished frame to the downstream stages, or mirror it for
+    // external tools right here
+    if (framePipeline) {
+        framePipeline->SubmitFrame(*currentScene, stats.totalFrames, deltaTime);
+    }
+    else if (sharedSceneView) {
+        sharedSceneView->Update(*currentScene, stats.totalFrames);
+    }
+
     auto frameEnd = std::chrono::high_resolution_clock::now();
     stats.frameTime = std::chrono::duration<float, std::milli>(frameEnd - frameStart).count();
 
-    TrackFrameTime(stats.frameTime);
+    // Headless runs skip the per-frame statistics (see UpdateStatistics)
+    if (!config.headless) {
+        TrackFrameTime(stats.frameTime);
+        GetPhaseTimes(FramePhase::Update).Record(stats.updateTime);
+        GetPhaseTimes(FramePhase::LateUpdate).Record(stats.lateUpdateTime);
+        GetPhaseTimes(FramePhase::FixedUpdate).Record(stats.fixedUpdateTime);
+        GetPhaseTimes(FramePhase::Frame).Record(stats.frameTime);
+    }
 }
 
 void Engine::CalculateTiming() {
     auto currentTime = std::chrono::high_resolution_clock::now();
-    deltaTime = std::chrono::duration<float>(currentTime - lastFrameTime).count();
+    if (config.headless) {
+        // Fixed step: the simulation doesn't depend on how fast frames run
+        deltaTime = config.headlessDeltaTime > 0.0f ? config.headlessDeltaTime : fixedDeltaTime;
+    }
+    else {
+        deltaTime = std::chrono::duration<float>(currentTime - lastFrameTime).count();
+    }
     lastFrameTime = currentTime;
 
     stats.totalRunTime = std::chrono::duration<float>(currentTime - startTime).count();
@@ -341,6 +448,17 @@ void Engine::CalculateTiming() {
 
 void Engine::UpdateStatistics() {
     stats.totalFrames++;
+    stats.simulatedTime += deltaTime;
+
+    // Headless runs only keep the counters; throughput is computed at the end
+    if (config.headless) {
+        return;
+    }
+
+    float wallTime = std::chrono::duration<float>(lastFrameTime - runStartTime).count();
+    if (wallTime > 0.0f) {
+        stats.simulationSpeed = static_cast<float>(stats.simulatedTime / wallTime);
+    }
 
     // Calculate FPS
     if (deltaTime > 0.0f) {
@@ -350,12 +468,22 @@ void Engine::UpdateStatistics() {
     // Update averages
     CalculateAverages();
 
-    // Update system statistics
+    // Update system statistics (pipelined: counted off-thread, a frame behind)
     Scene* currentScene = GetCurrentScene();
-    if (currentScene) {
+    if (framePipeline) {
+        stats.totalGameObjects = pipelinedObjectCount.load(std::memory_order_relaxed);
+        stats.activeGameObjects = pipelinedActiveCount.load(std::memory_order_relaxed);
+        stats.snapshotExtractTime = framePipeline->GetStats().extractTime;
+        stats.pipelineWaitTime = framePipeline->GetStats().waitTime;
+    }
+    else if (currentScene) {
         stats.totalGameObjects = currentScene->GetGameObjectCount();
         stats.activeGameObjects = currentScene->GetActiveGameObjectCount();
     }
+    if (currentScene) {
+        stats.totalComponents = currentScene->GetComponentCount();
+        stats.activeComponents = currentScene->GetActiveComponentCount();
+    }
 
     // Update memory statistics
     stats.memoryUsage = memoryManager.GetCurrentUsage();
@@ -368,6 +496,24 @@ void Engine::UpdateStatistics() {
         stats.activeTasks = updateSystem.GetThreadPool().GetActiveTaskCount();
     }
 
+    // Pacing percentiles sort the recent history, refresh them once a second or so
+    if (config.enableVSync && stats.totalFrames % 60 == 0) {
+        FramePacingStats pacing = framePacer.GetStats();
+        stats.pacingErrorP50 = pacing.p50;
+        stats.pacingErrorP99 = pacing.p99;
+        stats.pacingErrorMax = pacing.max;
+        stats.missedFrameDeadlines = pacing.missedDeadlines;
+    }
+
+    // Frame time percentiles, on the same cadence
+    if (stats.totalFrames % 60 == 0) {
+        stats.frameTimes = GetFrameTimes(FramePhase::Frame).GetWindowSummary();
+        stats.updateTimes = GetFrameTimes(FramePhase::Update).GetWindowSummary();
+        stats.lateUpdateTimes = GetFrameTimes(FramePhase::LateUpdate).GetWindowSummary();
+        stats.fixedUpdateTimes = GetFrameTimes(FramePhase::FixedUpdate).GetWindowSummary();
+        stats.frameBudgetSpikes = GetFrameTimes(FramePhase::Frame).GetRunSummary().spikes;
+    }
+
     // Performance logging
     if (config.enablePerformanceLogging && stats.totalFrames % 60 == 0) {
         std::cout << "[PERF] FPS: " << std::fixed << std::setprecision(1)
@@ -383,17 +529,12 @@ void Engine::UpdateStatistics() {
 }
 
 void Engine::HandleFrameRate() {
-    if (!config.enableVSync) {
+    if (!config.enableVSync || config.headless) {
         return;
     }
 
-    auto frameEnd = std::chrono::high_resolution_clock::now();
-    auto frameDuration = frameEnd - lastFrameTime;
-
-    if (frameDuration < targetFrameTime) {
-        auto sleepTime = targetFrameTime - frameDuration;
-        std::this_thread::sleep_for(sleepTime);
-    }
+    // Absolute deadlines: sleep, then spin the last stretch
+    framePacer.WaitForNextFrame();
 }
 
 // Initialization helpers
@@ -424,20 +565,117 @@ void Engine::InitializeFactories() {
 }
 
 void Engine::ConfigureSystems() {
+    // Frame time histograms; only whole frames are held to the budget
+    for (FrameTimeRecorder& recorder : phaseTimes) {
+        recorder.SetWindowFrames(config.frameTimeWindowFrames);
+    }
+    float frameBudget = config.frameTimeBudget > 0.0f ? config.frameTimeBudget
+        : config.targetFrameRate > 0.0f ? 1000.0f / config.targetFrameRate : 0.0f;
+    GetPhaseTimes(FramePhase::Frame).SetSpikeThreshold(frameBudget);
+
     // Configure update system
     if (systemManager.IsInitialized()) {
         auto& updateSystem = systemManager.GetUpdateSystem();
         updateSystem.SetThreadingEnabled(config.useMultiThreading);
         updateSystem.SetFixedUpdateRate(config.fixedUpdateRate);
+
+        // Large template spawns share the update system's workers
+        gameObjectFactory.SetThreadPool(config.useMultiThreading ? &updateSystem.GetThreadPool() : nullptr);
+
+        // So does block-parallel scene compression
+        SceneSerializer::SetThreadPool(config.useMultiThreading ? &updateSystem.GetThreadPool() : nullptr);
+    }
+    SceneSerializer::SetCompressionEnabled(config.compressSceneFiles);
+
+    if (!config.useParseCache) {
+        parseCache.reset();
+    }
+    else if (!parseCache || parseCache->GetCacheDirectory() != config.parseCacheDirectory) {
+        parseCache = std::make_unique<ParseCache>(config.parseCacheDirectory);
+    }
+    gameObjectFactory.SetParseCache(parseCache.get());
+
+    if (config.assetArchivePath.empty()) {
+        assetArchive.reset();
+    }
+    else if (!assetArchive || assetArchive->GetPath() != config.assetArchivePath) {
+        assetArchive = std::make_unique<AssetArchive>();
+        if (assetArchive->Open(config.assetArchivePath)) {
+            gameObjectFactory.LoadTemplatesFromArchive(*assetArchive);
+        }
+        else {
+            assetArchive.reset();
+        }
+    }
+
+    if (config.hotReloadDirectory.empty()) {
+        hotReloader.reset();
+    }
+    else if (!hotReloader) {
+        hotReloader = std::make_unique<TemplateHotReloader>(gameObjectFactory);
+        if (!hotReloader->Watch(config.hotReloadDirectory)) {
+            hotReloader.reset();
+        }
+    }
+
+    // Stages may reference the shared view, so the pipeline goes first
+    framePipeline.reset();
+
+    if (config.sharedSceneViewName.empty()) {
+        sharedSceneView.reset();
+    }
+    else {
+        SharedSceneViewConfig viewConfig;
+        viewConfig.name = config.sharedSceneViewName;
+        viewConfig.capacity = config.sharedSceneViewCapacity;
+        viewConfig.publishIntervalFrames = config.sharedSceneViewIntervalFrames;
+
+        const SharedSceneViewConfig* current = sharedSceneView ? &sharedSceneView->GetConfig() : nullptr;
+        if (!current || current->name != viewConfig.name || current->capacity != viewConfig.capacity ||
+            current->publishIntervalFrames != viewConfig.publishIntervalFrames) {
+            sharedSceneView = std::make_unique<SharedScenePublisher>();
+            if (!sharedSceneView->Open(viewConfig)) {
+                sharedSceneView.reset();
+            }
+        }
+    }
+
+    if (config.pipelineFrames) {
+        framePipeline = std::make_unique<FramePipeline>(config.pipelineWorkerCount);
+        if (config.useMultiThreading && systemManager.IsInitialized()) {
+            framePipeline->SetThreadPool(&systemManager.GetUpdateSystem().GetThreadPool());
+        }
+        framePipeline->AddStage("statistics", [this](const FrameSnapshot& snapshot) {
+            pipelinedObjectCount.store(snapshot.GetObjectCount(), std::memory_order_relaxed);
+            pipelinedActiveCount.store(snapshot.activeCount, std::memory_order_relaxed);
+            });
+        if (sharedSceneView) {
+            SharedScenePublisher* publisher = sharedSceneView.get();
+            framePipeline->AddStage("sharedSceneView", [publisher](const FrameSnapshot& snapshot) {
+                publisher->Update(snapshot);
+                });
+        }
     }
 }
 
 void Engine::ShutdownSystems() {
+    // Let background saves finish before shutting systems down
+    sceneManager.WaitForPendingSaves();
+    gameObjectFactory.SetThreadPool(nullptr);
+    SceneSerializer::SetThreadPool(nullptr);
+    gameObjectFactory.SetParseCache(nullptr);
+    hotReloader.reset();
+    assetArchive.reset();
+    framePipeline.reset();
+    sharedSceneView.reset();
     systemManager.Shutdown();
 }
 
 void Engine::CleanupResources() {
     frameTimeHistory.clear();
+    for (FrameTimeRecorder& recorder : phaseTimes) {
+        recorder.Reset();
+    }
     startCallbacks.clear();
     stopCallbacks.clear();
     sceneChangeCallbacks.clear();
@@ -540,6 +778,20 @@ namespace EngineUtils {
         return config;
     }
 
+    EngineConfig GetHeadlessConfig() {
+        EngineConfig config;
+        config.threadCount = std::thread::hardware_concurrency();
+        config.useMultiThreading = true;
+        config.enableVSync = false;
+        config.headless = true;
+        config.trackMemoryAllocations = false;
+        config.enablePerformanceLogging = false;
+        config.enableMemoryLogging = false;
+        config.enableDebugOutput = false;
+        config.enableStatistics = false;
+        return config;
+    }
+
     EngineConfig GetLowMemoryConfig() {
         EngineConfig config;
         config.defaultPoolSize = 50; // Smaller pools
@@ -560,7 +812,9 @@ namespace EngineUtils {
     }
 
     void RunFrames(size_t frameCount) {
-        std::cout << "RunFrames not fully implemented - would run for " << frameCount << " frames" << std::endl;
+        HeadlessRunStats result = Engine::GetInstance().RunFrames(frameCount);
+        std::cout << "Ran " << result.frames << " frames: " << result.simulatedSeconds << "s simulated in "
+            << result.wallSeconds << "s (" << result.simulatedSecondsPerWallSecond << "x)" << std::endl;
     }
 
     void EnablePerformanceProfiling(bool enable) {
@@ -0,0 +1,127 @@
+#include "../include/core/FramePacer.h"
+#include <algorithm>
+#include <thread>
+
+#if defined(__linux__)
+#include <time.h>
+#include <cerrno>
+#endif
+
+namespace {
+    float ToMicroseconds(FramePacer::Clock::duration duration) {
+        return std::chrono::duration<float, std::micro>(duration).count();
+    }
+
+    float Percentile(std::vector<float>& values, double fraction) {
+        size_t index = std::min(values.size() - 1, static_cast<size_t>(fraction * values.size()));
+        std::nth_element(values.begin(), values.begin() + index, values.end());
+        return values[index];
+    }
+}
+
+FramePacer::FramePacer(size_t historySize)
+    : errors(std::max<size_t>(historySize, 1), 0.0f) {
+}
+
+void FramePacer::SetTargetFrameRate(float framesPerSecond) {
+    period = framesPerSecond > 0.0f
+        ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / framesPerSecond))
+        : Clock::duration::zero();
+    scheduled = false;
+}
+
+float FramePacer::GetTargetFrameRate() const {
+    return period.count() > 0 ? static_cast<float>(1.0 / std::chrono::duration<double>(period).count()) : 0.0f;
+}
+
+void FramePacer::SetSpinWindow(std::chrono::microseconds minimum, std::chrono::microseconds maximum) {
+    minSpin = minimum;
+    maxSpin = std::max<Clock::duration>(minimum, maximum);
+}
+
+void FramePacer::WaitForNextFrame() {
+    if (period.count() <= 0) {
+        return;
+    }
+
+    Clock::time_point now = Clock::now();
+    if (!scheduled) {
+        deadline = now + period;
+        scheduled = true;
+        return;
+    }
+
+    // Overran by more than a period: start over instead of rushing frames
+    if (now >= deadline + period) {
+        ++missedDeadlines;
+        RecordError(ToMicroseconds(now - deadline));
+        deadline = now + period;
+        return;
+    }
+
+    // Sleep coarsely, leaving the spin window for the OS wake-up latency
+    Clock::duration spin = std::chrono::microseconds(static_cast<int64_t>(2.0 * averageOvershoot));
+    spin = std::clamp(spin, minSpin, maxSpin);
+    Clock::time_point wakeTime = deadline - spin;
+    if (now < wakeTime) {
+        SleepUntil(wakeTime);
+        now = Clock::now();
+        double overshoot = std::max(0.0f, ToMicroseconds(now - wakeTime));
+        averageOvershoot += (overshoot - averageOvershoot) * 0.05;
+    }
+
+    // Spin the rest
+    while (now < deadline) {
+        std::this_thread::yield();
+        now = Clock::now();
+    }
+
+    RecordError(ToMicroseconds(now - deadline));
+    deadline += period;
+}
+
+void FramePacer::SleepUntil(Clock::time_point wakeTime) {
+#if defined(__linux__)
+    // steady_clock is CLOCK_MONOTONIC; an absolute deadline is immune to the
+    // time spent between computing it and going to sleep
+    auto sinceEpoch = std::chrono::duration_cast<std::chrono::nanoseconds>(wakeTime.time_since_epoch()).count();
+    timespec request;
+    request.tv_sec = static_cast<time_t>(sinceEpoch / 1000000000);
+    request.tv_nsec = static_cast<long>(sinceEpoch % 1000000000);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &request, nullptr) == EINTR) {
+    }
+#else
+    std::this_thread::sleep_until(wakeTime);
+#endif
+}
+
+void FramePacer::RecordError(float microseconds) {
+    errors[errorCursor] = microseconds;
+    errorCursor = (errorCursor + 1) % errors.size();
+    errorCount = std::min(errorCount + 1, errors.size());
+    ++frameCount;
+}
+
+FramePacingStats FramePacer::GetStats() const {
+    FramePacingStats result;
+    result.frames = frameCount;
+    result.missedDeadlines = missedDeadlines;
+    result.spinWindow = ToMicroseconds(std::clamp<Clock::duration>(
+        std::chrono::microseconds(static_cast<int64_t>(2.0 * averageOvershoot)), minSpin, maxSpin));
+
+    if (errorCount > 0) {
+        std::vector<float> recent(errors.begin(), errors.begin() + errorCount);
+        result.max = *std::max_element(recent.begin(), recent.end());
+        result.p50 = Percentile(recent, 0.50);
+        result.p95 = Percentile(recent, 0.95);
+        result.p99 = Percentile(recent, 0.99);
+    }
+    return result;
+}
+
+void FramePacer::ClearStats() {
+    errorCursor = 0;
+    errorCount = 0;
+    frameCount = 0;
+    missedDeadlines = 0;
+}
@@ -0,0 +1,229 @@
+#include "../include/core/FramePipeline.h"
+#include "../include/core/Scene.h"
+#include "../include/core/GameObject.h"
+#include "../include/systems/ThreadPool.h"
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <typeinfo>
+#include <limits>
+#include <exception>
+
+// ===== FrameSnapshot =====
+
+namespace {
+    // Marks null scene slots until they are squeezed out
+    constexpr uint64_t NullId = std::numeric_limits<uint64_t>::max();
+}
+
+void FrameSnapshot::Capture(const Scene& scene, uint64_t frameNumber, float frameDeltaTime, ThreadPool* pool) {
+    frame = frameNumber;
+    deltaTime = frameDeltaTime;
+
+    // Sized up front and written by index; the columns keep their capacity
+    const auto& objects = scene.GetAllGameObjects();
+    size_t objectCount = objects.size();
+    ids.resize(objectCount);
+    positions.resize(objectCount);
+    active.resize(objectCount);
+    tagIndices.resize(objectCount);
+
+    // Chunks fill disjoint ranges with their own tag tables, merged below
+    size_t threadCount = pool && objectCount >= MinParallelObjects ? pool->GetThreadCount() : 0;
+    size_t chunkCount = threadCount ? std::min(objectCount / (MinParallelObjects / 4), (threadCount + 1) * 2) : 1;
+    size_t chunkSize = (objectCount + chunkCount - 1) / std::max<size_t>(chunkCount, 1);
+    chunks.resize(std::max<size_t>(chunkCount, 1));
+
+    auto captureChunk = [this, &objects, chunkSize](size_t chunkIndex) {
+        CaptureChunk& chunk = chunks[chunkIndex];
+        chunk.tags.clear();
+        chunk.tagLookup.clear();
+        chunk.activeCount = 0;
+        chunk.nullCount = 0;
+
+        size_t begin = chunkIndex * chunkSize;
+        size_t end = std::min(begin + chunkSize, objects.size());
+        const std::string* lastTag = nullptr;
+        uint32_t lastTagIndex = 0;
+
+        for (size_t i = begin; i < end; ++i) {
+            const GameObject* gameObject = objects[i].get();
+            if (!gameObject) {
+                ids[i] = NullId;
+                ++chunk.nullCount;
+                continue;
+            }
+
+            Vector3 position = Vector3::Zero;
+            for (const auto& component : gameObject->GetAllComponents()) {
+                if (typeid(*component) == typeid(Transform)) {
+                    position = static_cast<const Transform&>(*component).GetPosition();
+                    break;
+                }
+            }
+
+            // Objects usually come in runs sharing a tag
+            const std::string& tag = gameObject->GetTag();
+            if (!lastTag || tag != *lastTag) {
+                auto inserted = chunk.tagLookup.emplace(tag, static_cast<uint32_t>(chunk.tags.size()));
+                if (inserted.second) {
+                    chunk.tags.push_back(tag);
+                }
+                lastTag = &tag;
+                lastTagIndex = inserted.first->second;
+            }
+
+            bool isActive = gameObject->IsActive();
+            ids[i] = static_cast<uint64_t>(gameObject->GetId());
+            positions[i] = position;
+            active[i] = isActive ? 1 : 0;
+            tagIndices[i] = lastTagIndex;
+            chunk.activeCount += isActive ? 1 : 0;
+        }
+        };
+
+    ParallelFor(pool, chunks.size(), chunks.size(), [&captureChunk](size_t begin, size_t end) {
+        for (size_t chunkIndex = begin; chunkIndex < end; ++chunkIndex) {
+            captureChunk(chunkIndex);
+        }
+        });
+
+    // Merge the chunk tag tables; chunk-local indices are remapped in place
+    tags.clear();
+    tagLookup.clear();
+    activeCount = 0;
+    size_t nullCount = 0;
+    for (size_t chunkIndex = 0; chunkIndex < chunks.size(); ++chunkIndex) {
+        CaptureChunk& chunk = chunks[chunkIndex];
+        activeCount += chunk.activeCount;
+        nullCount += chunk.nullCount;
+
+        bool identity = true;
+        chunk.remap.resize(chunk.tags.size());
+        for (size_t i = 0; i < chunk.tags.size(); ++i) {
+            auto inserted = tagLookup.emplace(chunk.tags[i], static_cast<uint32_t>(tags.size()));
+            if (inserted.second) {
+                tags.push_back(chunk.tags[i]);
+            }
+            chunk.remap[i] = inserted.first->second;
+            identity = identity && chunk.remap[i] == i;
+        }
+
+        if (!identity) {
+            size_t begin = chunkIndex * chunkSize;
+            size_t end = std::min(begin + chunkSize, objectCount);
+            for (size_t i = begin; i < end; ++i) {
+                if (ids[i] != NullId) {
+                    tagIndices[i] = chunk.remap[tagIndices[i]];
+                }
+            }
+        }
+    }
+
+    // Null slots (rare) are squeezed out
+    if (nullCount > 0) {
+        size_t count = 0;
+        for (size_t i = 0; i < objectCount; ++i) {
+            if (ids[i] == NullId) continue;
+            ids[count] = ids[i];
+            positions[count] = positions[i];
+            active[count] = active[i];
+            tagIndices[count] = tagIndices[i];
+            ++count;
+        }
+        ids.resize(count);
+        positions.resize(count);
+        active.resize(count);
+        tagIndices.resize(count);
+    }
+}
+
+// ===== FramePipeline =====
+
+FramePipeline::FramePipeline(size_t workerCount)
+    : workers(std::make_unique<ThreadPool>(std::max<size_t>(workerCount, 1))) {
+}
+
+FramePipeline::~FramePipeline() {
+    Flush();
+}
+
+void FramePipeline::AddStage(const std::string& name, Stage stage) {
+    Flush();
+    StageEntry entry;
+    entry.name = name;
+    entry.function = std::move(stage);
+    stages.push_back(std::move(entry));
+}
+
+bool FramePipeline::RemoveStage(const std::string& name) {
+    Flush();
+    auto found = std::find_if(stages.begin(), stages.end(),
+        [&name](const StageEntry& entry) { return entry.name == name; });
+    if (found == stages.end()) {
+        return false;
+    }
+    stages.erase(found);
+    return true;
+}
+
+void FramePipeline::SubmitFrame(const Scene& scene, uint64_t frameNumber, float deltaTime) {
+    // The write snapshot's last readers finished at the previous submit
+    auto extractStart = std::chrono::high_resolution_clock::now();
+    FrameSnapshot& snapshot = snapshots[writeIndex];
+    snapshot.Capture(scene, frameNumber, deltaTime, extractPool);
+    auto extractEnd = std::chrono::high_resolution_clock::now();
+
+    // Bound the latency to one frame: the previous frame must be through
+    Flush();
+    auto waitEnd = std::chrono::high_resolution_clock::now();
+
+    stats.extractTime = std::chrono::duration<float, std::milli>(extractEnd - extractStart).count();
+    stats.waitTime = std::chrono::duration<float, std::milli>(waitEnd - extractEnd).count();
+    stats.stageTime = 0.0f;
+    for (const StageEntry& entry : stages) {
+        stats.stageTime = std::max(stats.stageTime, entry.lastTime);
+    }
+
+    for (StageEntry& entry : stages) {
+        StageEntry* stage = &entry;
+        const FrameSnapshot* input = &snapshot;
+        inFlight.push_back(workers->Enqueue([stage, input]() {
+            auto stageStart = std::chrono::high_resolution_clock::now();
+            stage->function(*input);
+            auto stageEnd = std::chrono::high_resolution_clock::now();
+            stage->runTime = std::chrono::duration<float, std::milli>(stageEnd - stageStart).count();
+            }));
+    }
+
+    writeIndex ^= 1;
+    ++stats.framesSubmitted;
+}
+
+void FramePipeline::Flush() {
+    if (inFlight.empty()) return;
+
+    for (std::future<void>& stage : inFlight) {
+        try {
+            stage.get();
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Frame pipeline stage failed: " << e.what() << std::endl;
+        }
+    }
+    inFlight.clear();
+    ++stats.framesCompleted;
+
+    for (StageEntry& entry : stages) {
+        entry.lastTime = entry.runTime;
+    }
+}
+
+float FramePipeline::GetStageTime(const std::string& name) const {
+    for (const StageEntry& entry : stages) {
+        if (entry.name == name) {
+            return entry.lastTime;
+        }
+    }
+    return 0.0f;
+}
@@ -0,0 +1,218 @@
+#include "../include/core/FrameTimeHistogram.h"
+#include <algorithm>
+#include <thread>
+#include <cmath>
+
+// ===== FrameTimeHistogram =====
+
+size_t FrameTimeHistogram::GetBucketIndex(uint64_t microseconds) {
+    uint64_t value = std::min(microseconds, MaxValue);
+    if (value < LinearBuckets) {
+        return static_cast<size_t>(value);
+    }
+
+    // Shift the value down into [SubBuckets, 2 * SubBuckets)
+    uint64_t shift = 1;
+    while ((value >> shift) >= 2 * SubBuckets) {
+        ++shift;
+    }
+    return static_cast<size_t>(LinearBuckets + (shift - 1) * SubBuckets + ((value >> shift) - SubBuckets));
+}
+
+uint64_t FrameTimeHistogram::GetBucketUpperBound(size_t index) {
+    if (index < LinearBuckets) {
+        return index;
+    }
+    uint64_t shift = (index - LinearBuckets) / SubBuckets + 1;
+    uint64_t subBucket = (index - LinearBuckets) % SubBuckets + SubBuckets;
+    return ((subBucket + 1) << shift) - 1;
+}
+
+FrameTimeHistogram::FrameTimeHistogram()
+    : counts(BucketCount, 0) {
+}
+
+void FrameTimeHistogram::Record(uint64_t microseconds) {
+    ++counts[GetBucketIndex(microseconds)];
+    ++total;
+    maxValue = std::max(maxValue, microseconds);
+    sum += microseconds;
+}
+
+void FrameTimeHistogram::Merge(const FrameTimeHistogram& other) {
+    for (size_t i = 0; i < BucketCount; ++i) {
+        counts[i] += other.counts[i];
+    }
+    total += other.total;
+    spikes += other.spikes;
+    maxValue = std::max(maxValue, other.maxValue);
+    sum += other.sum;
+}
+
+void FrameTimeHistogram::Clear() {
+    std::fill(counts.begin(), counts.end(), 0);
+    total = 0;
+    spikes = 0;
+    maxValue = 0;
+    sum = 0;
+}
+
+uint64_t FrameTimeHistogram::GetValueAtPercentile(double fraction) const {
+    if (total == 0) return 0;
+
+    uint64_t target = static_cast<uint64_t>(std::ceil(std::clamp(fraction, 0.0, 1.0) * total));
+    target = std::max<uint64_t>(target, 1);
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BucketCount; ++i) {
+        seen += counts[i];
+        if (seen >= target) {
+            return std::min(GetBucketUpperBound(i), maxValue);
+        }
+    }
+    return maxValue;
+}
+
+FrameTimeSummary FrameTimeHistogram::Summarize() const {
+    FrameTimeSummary summary;
+    summary.count = static_cast<size_t>(total);
+    summary.spikes = static_cast<size_t>(spikes);
+    if (total == 0) return summary;
+
+    summary.mean = static_cast<float>(static_cast<double>(sum) / total / 1000.0);
+    summary.p50 = GetValueAtPercentile(0.50) / 1000.0f;
+    summary.p90 = GetValueAtPercentile(0.90) / 1000.0f;
+    summary.p99 = GetValueAtPercentile(0.99) / 1000.0f;
+    summary.p999 = GetValueAtPercentile(0.999) / 1000.0f;
+    summary.max = maxValue / 1000.0f;
+    return summary;
+}
+
+// ===== FrameTimeRecorder =====
+
+FrameTimeRecorder::FrameTimeRecorder()
+    : cells((Slices + 1) * Stride) {
+}
+
+void FrameTimeRecorder::SetWindowFrames(size_t frames) {
+    sliceFrames.store(std::max<size_t>(frames / Slices, 1), std::memory_order_relaxed);
+}
+
+void FrameTimeRecorder::SetSpikeThreshold(float milliseconds) {
+    uint64_t microseconds = milliseconds > 0.0f ? static_cast<uint64_t>(milliseconds * 1000.0f) : 0;
+    spikeThreshold.store(microseconds, std::memory_order_relaxed);
+}
+
+void FrameTimeRecorder::Record(float milliseconds) {
+    uint64_t microseconds = milliseconds > 0.0f ? static_cast<uint64_t>(std::llround(milliseconds * 1000.0)) : 0;
+    uint64_t threshold = spikeThreshold.load(std::memory_order_relaxed);
+    bool spike = threshold > 0 && microseconds > threshold;
+    size_t bucket = FrameTimeHistogram::GetBucketIndex(microseconds);
+
+    uint64_t start = sequence.load(std::memory_order_relaxed);
+    sequence.store(start + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    // Move on to the next slice once this one is full, evicting the oldest
+    if (sliceCount >= sliceFrames.load(std::memory_order_relaxed)) {
+        currentSlice = (currentSlice + 1) % Slices;
+        ClearHistogram(1 + currentSlice);
+        sliceCount = 0;
+    }
+
+    Bump(0, bucket, microseconds, spike);
+    Bump(1 + currentSlice, bucket, microseconds, spike);
+    ++sliceCount;
+
+    sequence.store(start + 2, std::memory_order_release);
+}
+
+void FrameTimeRecorder::Reset() {
+    uint64_t start = sequence.load(std::memory_order_relaxed);
+    sequence.store(start + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (size_t histogram = 0; histogram <= Slices; ++histogram) {
+        ClearHistogram(histogram);
+    }
+    currentSlice = 0;
+    sliceCount = 0;
+
+    sequence.store(start + 2, std::memory_order_release);
+}
+
+void FrameTimeRecorder::Bump(size_t histogram, size_t bucket, uint64_t microseconds, bool spike) {
+    // Single writer: plain load and store, no read-modify-write needed
+    auto increment = [](std::atomic<uint64_t>& cell, uint64_t amount) {
+        cell.store(cell.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+        };
+
+    std::atomic<uint64_t>* base = &cells[histogram * Stride];
+    increment(base[bucket], 1);
+    increment(base[TotalCell], 1);
+    increment(base[SumCell], microseconds);
+    if (spike) {
+        increment(base[SpikesCell], 1);
+    }
+    if (microseconds > base[MaxCell].load(std::memory_order_relaxed)) {
+        base[MaxCell].store(microseconds, std::memory_order_relaxed);
+    }
+}
+
+void FrameTimeRecorder::ClearHistogram(size_t histogram) {
+    std::atomic<uint64_t>* base = &cells[histogram * Stride];
+    for (size_t i = 0; i < Stride; ++i) {
+        base[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+bool FrameTimeRecorder::Read(FrameTimeHistogram& out, size_t first, size_t count, int attempts) const {
+    for (int attempt = 0; attempt < attempts; ++attempt) {
+        uint64_t start = sequence.load(std::memory_order_acquire);
+        if (start & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        out.Clear();
+        for (size_t histogram = first; histogram < first + count; ++histogram) {
+            const std::atomic<uint64_t>* base = &cells[histogram * Stride];
+            for (size_t i = 0; i < FrameTimeHistogram::BucketCount; ++i) {
+                out.counts[i] += base[i].load(std::memory_order_relaxed);
+            }
+            out.total += base[TotalCell].load(std::memory_order_relaxed);
+            out.spikes += base[SpikesCell].load(std::memory_order_relaxed);
+            out.maxValue = std::max(out.maxValue, base[MaxCell].load(std::memory_order_relaxed));
+            out.sum += base[SumCell].load(std::memory_order_relaxed);
+        }
+
+        // Keep the loads above from moving past the sequence check
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) == start) {
+            return true;
+        }
+    }
+
+    out.Clear();
+    return false;
+}
+
+bool FrameTimeRecorder::ReadRun(FrameTimeHistogram& out, int attempts) const {
+    return Read(out, 0, 1, attempts);
+}
+
+bool FrameTimeRecorder::ReadWindow(FrameTimeHistogram& out, int attempts) const {
+    return Read(out, 1, Slices, attempts);
+}
+
+FrameTimeSummary FrameTimeRecorder::GetRunSummary() const {
+    FrameTimeHistogram histogram;
+    ReadRun(histogram);
+    return histogram.Summarize();
+}
+
+FrameTimeSummary FrameTimeRecorder::GetWindowSummary() const {
+    FrameTimeHistogram histogram;
+    ReadWindow(histogram);
+    return histogram.Summarize();
+}
@@ -3,20 +3,34 @@
 #include <iostream>
 
 // Static member initialization
-size_t GameObject::nextId = 0;
+std::atomic<size_t> GameObject::nextId{ 0 };
 
 // Updated constructor with name parameter
 GameObject::GameObject(const std::string& objectTag, const std::string& objectName)
-    : id(nextId++), tag(objectTag), name(objectName) {
+    : id(nextId.fetch_add(1, std::memory_order_relaxed)), tag(objectTag), name(objectName) {
     components.reserve(8); // Reserve space for typical component count
 }
 
+GameObject::GameObject(size_t objectId, const std::string& objectTag, const std::string& objectName)
+    : id(objectId), tag(objectTag), name(objectName) {
+    components.reserve(8);
+}
+
+GameObject::~GameObject() {
+    SetCounters(nullptr);
+}
+
 GameObject::GameObject(GameObject&& other) noexcept
     : id(other.id)
     , tag(std::move(other.tag))
     , name(std::move(other.name))  // Move name as well
-    , components(std::move(other.components))
-    , active(other.active) {
+    , active(other.active)
+    , templateId(other.templateId) {
+
+    // The moved-from object leaves its scene's counters while it still has
+    // its components
+    other.SetCounters(nullptr);
+    components = std::move(other.components);
 
     // Update component owner references
     for (auto& component : components) {
@@ -26,16 +40,25 @@ GameObject::GameObject(GameObject&& other) noexcept
 
 GameObject& GameObject::operator=(GameObject&& other) noexcept {
     if (this != &other) {
+        // Counts follow the contents: the moved-from object leaves its scene's
+        // counters, this one is re-counted in its own
+        SceneCounters* sceneCounters = counters;
+        SetCounters(nullptr);
+        other.SetCounters(nullptr);
+
         id = other.id;
         tag = std::move(other.tag);
         name = std::move(other.name);  // Move name as well
         components = std::move(other.components);
         active = other.active;
+        templateId = other.templateId;
 
         // Update component owner references
         for (auto& component : components) {
             component->SetOwner(this);
         }
+
+        SetCounters(sceneCounters);
     }
     return *this;
 }
@@ -46,9 +69,11 @@ void GameObject::SetActive(bool isActive) {
 
     bool wasActive = active;
     active = isActive;
+    size_t activeComponents = 0;
 
     // Notify all components about the state change
     for (auto& component : components) {
+        activeComponents += component->IsActive() ? 1 : 0;
         if (isActive && !wasActive) {
             // GameObject became active
             if (component->IsActive()) {
@@ -62,6 +87,56 @@ void GameObject::SetActive(bool isActive) {
             }
         }
     }
+
+    if (counters) {
+        if (isActive) {
+            counters->activeObjects.fetch_add(1, std::memory_order_relaxed);
+            counters->activeComponents.fetch_add(activeComponents, std::memory_order_relaxed);
+        }
+        else {
+            counters->activeObjects.fetch_sub(1, std::memory_order_relaxed);
+            counters->activeComponents.fetch_sub(activeComponents, std::memory_order_relaxed);
+        }
+    }
+}
+
+void GameObject::SetCounters(SceneCounters* sceneCounters) {
+    if (counters == sceneCounters) return;
+
+    size_t activeComponents = active ? CountActiveComponents() : 0;
+    if (counters) {
+        counters->objects.fetch_sub(1, std::memory_order_relaxed);
+        counters->activeObjects.fetch_sub(active ? 1 : 0, std::memory_order_relaxed);
+        counters->components.fetch_sub(components.size(), std::memory_order_relaxed);
+        counters->activeComponents.fetch_sub(activeComponents, std::memory_order_relaxed);
+    }
+
+    counters = sceneCounters;
+    if (counters) {
+        counters->objects.fetch_add(1, std::memory_order_relaxed);
+        counters->activeObjects.fetch_add(active ? 1 : 0, std::memory_order_relaxed);
+        counters->components.fetch_add(components.size(), std::memory_order_relaxed);
+        counters->activeComponents.fetch_add(activeComponents, std::memory_order_relaxed);
+    }
+}
+
+void GameObject::OnComponentActiveChanged(bool isActive) {
+    if (!counters || !active) return;
+
+    if (isActive) {
+        counters->activeComponents.fetch_add(1, std::memory_order_relaxed);
+    }
+    else {
+        counters->activeComponents.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+size_t GameObject::CountActiveComponents() const {
+    size_t count = 0;
+    for (const auto& component : components) {
+        count += component->IsActive() ? 1 : 0;
+    }
+    return count;
 }
 
 void GameObject::Update(float deltaTime) {
@@ -146,6 +221,37 @@ bool GameObject::HasConflictingComponents(const std::vector<std::string>& confli
     return foundTypes.size() > 1;
 }
 
+Component* GameObject::AttachComponent(std::unique_ptr<Component> component) {
+    if (!component) return nullptr;
+
+    const std::type_info& type = typeid(*component);
+    for (auto& existing : components) {
+        if (typeid(*existing) == type) {
+            return existing.get();
+        }
+    }
+
+    Component* componentPtr = component.get();
+    component->SetOwner(this);
+    components.push_back(std::move(component));
+    CountComponent(*componentPtr, true);
+
+    if (active) {
+        componentPtr->OnEnable();
+    }
+
+    return componentPtr;
+}
+
+Component* GameObject::GetComponent(const std::type_index& type) {
+    for (auto& component : components) {
+        if (std::type_index(typeid(*component)) == type) {
+            return component.get();
+        }
+    }
+    return nullptr;
+}
+
 bool GameObject::RemoveComponent(Component* component) {
     if (!component) return false;
 
@@ -157,6 +263,7 @@ bool GameObject::RemoveComponent(Component* component) {
     if (it != components.end()) {
         (*it)->OnDisable();  // Disable first
         (*it)->OnDestroy();  // Then destroy
+        CountComponent(**it, false);
         components.erase(it);
         return true;
     }
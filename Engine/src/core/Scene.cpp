@@ -1,9 +1,10 @@
 #include "../include/core/Scene.h"
 #include "../include/components/Transform.h"
 #include "../include/components/Behavior.h"
+#include "../include/serialization/SceneFormat.h"
+#include "../include/factories/GameObjectBlueprint.h"
 #include <iostream>
 #include <algorithm>
-#include <fstream>
 
 Scene::Scene(const std::string& sceneName) : name(sceneName) {
     // Reserve space for common scenarios to avoid reallocations
@@ -24,6 +25,11 @@ Scene::Scene(Scene&& other) noexcept
     , nextObjectIndex(other.nextObjectIndex)
     , gameObjectCreatedCallbacks(std::move(other.gameObjectCreatedCallbacks))
     , gameObjectDestroyedCallbacks(std::move(other.gameObjectDestroyedCallbacks)) {
+
+    // The objects now count towards this scene
+    for (auto& gameObject : objects) {
+        gameObject->SetCounters(&counters);
+    }
 }
 
 Scene& Scene::operator=(Scene&& other) noexcept {
@@ -39,6 +45,10 @@ Scene& Scene::operator=(Scene&& other) noexcept {
         nextObjectIndex = other.nextObjectIndex;
         gameObjectCreatedCallbacks = std::move(other.gameObjectCreatedCallbacks);
         gameObjectDestroyedCallbacks = std::move(other.gameObjectDestroyedCallbacks);
+
+        for (auto& gameObject : objects) {
+            gameObject->SetCounters(&counters);
+        }
     }
     return *this;
 }
@@ -69,6 +79,79 @@ void Scene::AddGameObject(std::unique_ptr<GameObject> gameObject) {
     TriggerGameObjectCreated(ptr);
 }
 
+size_t Scene::SpawnBatch(const GameObjectBlueprint& blueprint, size_t count, const SpawnInitializer& initializer) {
+    size_t first = objects.size();
+    if (count == 0) return first;
+
+    Reserve(first + count);
+    ReserveTag(blueprint.GetTag(), count);
+
+    for (size_t i = 0; i < count; ++i) {
+        objects.push_back(blueprint.Instantiate());
+        if (initializer) {
+            initializer(*objects.back(), i);
+        }
+    }
+
+    IndexBatch(first);
+    return first;
+}
+
+size_t Scene::AddGameObjects(std::vector<std::unique_ptr<GameObject>> batch) {
+    size_t first = objects.size();
+    Reserve(first + batch.size());
+
+    for (auto& gameObject : batch) {
+        if (gameObject) {
+            objects.push_back(std::move(gameObject));
+        }
+    }
+
+    IndexBatch(first);
+    return first;
+}
+
+void Scene::IndexBatch(size_t first) {
+    // Index the whole range; initializers may have changed tags, so reuse the
+    // tag vector only while consecutive objects share a tag
+    const std::string* lastTag = nullptr;
+    std::vector<GameObject*>* tagVector = nullptr;
+    for (size_t i = first; i < objects.size(); ++i) {
+        GameObject* gameObject = objects[i].get();
+        objectsById[gameObject->GetId()] = gameObject;
+        gameObject->SetCounters(&counters);
+
+        if (!lastTag || *lastTag != gameObject->GetTag()) {
+            lastTag = &gameObject->GetTag();
+            tagVector = &objectsByTag[*lastTag];
+        }
+        tagVector->push_back(gameObject);
+    }
+
+    // Clean caches can be extended in place instead of rebuilt
+    if (!componentCachesDirty) {
+        for (size_t i = first; i < objects.size(); ++i) {
+            AppendToComponentCaches(objects[i].get());
+        }
+    }
+
+    if (!gameObjectCreatedCallbacks.empty()) {
+        for (size_t i = first; i < objects.size(); ++i) {
+            TriggerGameObjectCreated(objects[i].get());
+        }
+    }
+}
+
+void Scene::Reserve(size_t objectCount) {
+    objects.reserve(objectCount);
+    objectsById.reserve(objectCount);
+}
+
+void Scene::ReserveTag(const std::string& tag, size_t objectCount) {
+    auto& tagVector = objectsByTag[tag];
+    tagVector.reserve(tagVector.size() + objectCount);
+}
+
 // GameObject destruction
 bool Scene::DestroyGameObject(GameObject* gameObject) {
     if (!gameObject) return false;
@@ -161,24 +244,32 @@ void Scene::RefreshComponentCaches() const {
     cachedBehaviors.clear();
 
     for (const auto& gameObject : objects) {
-        if (gameObject && gameObject->IsActive()) {
-            // Cache Transform components
-            if (Transform* transform = gameObject->GetComponent<Transform>()) {
-                cachedTransforms.push_back(transform);
-            }
-
-            // Cache Behavior components (check all components for Behavior base class)
-            for (const auto& component : gameObject->GetAllComponents()) {
-                if (Behavior* behavior = dynamic_cast<Behavior*>(component.get())) {
-                    cachedBehaviors.push_back(behavior);
-                }
-            }
-        }
+        AppendToComponentCaches(gameObject.get());
     }
 
     componentCachesDirty = false;
 }
 
+void Scene::AppendToComponentCaches(GameObject* gameObject) const {
+    if (!gameObject || !gameObject->IsActive()) return;
+
+    // Cache Transform components
+    if (Transform* transform = gameObject->GetComponent<Transform>()) {
+        cachedTransforms.push_back(transform);
+    }
+
+    // Cache Behavior components (check all components for Behavior base class)
+    for (const auto& component : gameObject->GetAllComponents()) {
+        if (Behavior* behavior = dynamic_cast<Behavior*>(component.get())) {
+            cachedBehaviors.push_back(behavior);
+        }
+    }
+}
+
+const std::vector<std::unique_ptr<GameObject>>& Scene::GetAllGameObjects() const {
+    return objects;
+}
+
 std::vector<GameObject*> Scene::GetActiveGameObjects() const {
     std::vector<GameObject*> activeObjects;
     for (const auto& obj : objects) {
@@ -190,13 +281,6 @@ std::vector<GameObject*> Scene::GetActiveGameObjects() const {
 }
 
 // Scene statistics
-size_t Scene::GetActiveGameObjectCount() const {
-    return std::count_if(objects.begin(), objects.end(),
-        [](const std::unique_ptr<GameObject>& obj) {
-            return obj && obj->IsActive();
-        });
-}
-
 size_t Scene::GetGameObjectCountWithTag(const std::string& tag) const {
     auto it = objectsByTag.find(tag);
     return (it != objectsByTag.end()) ? it->second.size() : 0;
@@ -239,44 +323,12 @@ void Scene::FixedUpdate(float fixedDeltaTime) {
 }
 
 // Basic serialization framework
-void Scene::SaveToFile(const std::string& filepath) const {
-    std::ofstream file(filepath);
-    if (!file.is_open()) {
-        std::cerr << "Failed to save scene to: " << filepath << std::endl;
-        return;
-    }
-
-    file << "Scene: " << name << std::endl;
-    file << "GameObjects: " << objects.size() << std::endl;
-
-    for (const auto& obj : objects) {
-        file << "GameObject ID: " << obj->GetId()
-            << " Tag: " << obj->GetTag()
-            << " Active: " << obj->IsActive()
-            << " Components: " << obj->GetComponentCount() << std::endl;
-    }
-
-    file.close();
-    std::cout << "Scene saved to: " << filepath << std::endl;
+bool Scene::SaveToFile(const std::string& filepath) const {
+    return SceneSerializer::Save(*this, filepath);
 }
 
 bool Scene::LoadFromFile(const std::string& filepath) {
-    std::ifstream file(filepath);
-    if (!file.is_open()) {
-        std::cerr << "Failed to load scene from: " << filepath << std::endl;
-        return false;
-    }
-
-    // Basic loading (would need more sophisticated parsing for real implementation)
-    std::string line;
-    while (std::getline(file, line)) {
-        // Parse scene data...
-        // This is a placeholder for a more complete implementation
-    }
-
-    file.close();
-    std::cout << "Scene loaded from: " << filepath << std::endl;
-    return true;
+    return SceneSerializer::Load(*this, filepath);
 }
 
 // Utility functions
@@ -302,6 +354,7 @@ void Scene::UpdateLookupMaps(GameObject* gameObject) {
 
     // Add to ID map
     objectsById[gameObject->GetId()] = gameObject;
+    gameObject->SetCounters(&counters);
 
     // Add to tag map
     const std::string& tag = gameObject->GetTag();
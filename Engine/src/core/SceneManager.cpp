@@ -1,6 +1,8 @@
 #include "../include/core/SceneManager.h"
 #include <iostream>
 #include <algorithm>
+#include <chrono>
+#include <cstring>
 
 // Static instance initialization
 SceneManager* SceneManager::instance = nullptr;
@@ -19,6 +21,9 @@ void SceneManager::DestroyInstance() {
 }
 
 SceneManager::~SceneManager() {
+    WaitForPendingSaves();
+    CancelPendingLoads();
+    DisableWorldStreaming();
     RemoveAllScenes();
 }
 
@@ -64,6 +69,11 @@ bool SceneManager::RemoveScene(const std::string& sceneName) {
         return false;
     }
 
+    // Streamed objects belong to the scene, stop streaming into it first
+    if (worldStreamer && worldStreamer->GetScene() == it->second.get()) {
+        DisableWorldStreaming();
+    }
+
     // If this is the current scene, unload it first
     if (currentScene == it->second.get()) {
         UnloadCurrentScene();
@@ -75,6 +85,7 @@ bool SceneManager::RemoveScene(const std::string& sceneName) {
 }
 
 void SceneManager::RemoveAllScenes() {
+    DisableWorldStreaming();
     UnloadCurrentScene();
     scenes.clear();
     std::cout << "All scenes removed" << std::endl;
@@ -158,8 +169,7 @@ bool SceneManager::SaveScene(const std::string& sceneName, const std::string& fi
         return false;
     }
 
-    scene->SaveToFile(filepath);
-    return true;
+    return scene->SaveToFile(filepath);
 }
 
 bool SceneManager::LoadSceneFromFile(const std::string& sceneName, const std::string& filepath) {
@@ -178,12 +188,202 @@ bool SceneManager::LoadSceneFromFile(const std::string& sceneName, const std::st
 
 bool SceneManager::SaveCurrentScene(const std::string& filepath) {
     if (currentScene) {
-        currentScene->SaveToFile(filepath);
-        return true;
+        return currentScene->SaveToFile(filepath);
     }
     return false;
 }
 
+// Incremental scene file loading
+bool SceneManager::LoadSceneFromFileAsync(const std::string& sceneName, const std::string& filepath,
+    const SceneLoadBudget& budget, const std::function<void(Scene*)>& callback) {
+    if (!IsValidSceneName(sceneName)) {
+        std::cerr << "Invalid scene name: " << sceneName << std::endl;
+        return false;
+    }
+
+    if (HasScene(sceneName) || IsSceneLoadPending(sceneName)) {
+        std::cerr << "Scene already exists or is loading: " << sceneName << std::endl;
+        return false;
+    }
+
+    auto reader = std::make_unique<SceneStreamReader>();
+    if (!reader->Open(filepath, sceneName)) {
+        std::cerr << "Failed to start loading scene: " << filepath << std::endl;
+        return false;
+    }
+
+    PendingSceneLoad load;
+    load.sceneName = sceneName;
+    load.reader = std::move(reader);
+    load.budget = budget;
+    load.callback = callback;
+    pendingLoads.push_back(std::move(load));
+
+    std::cout << "Scene load queued: " << sceneName << " (" << pendingLoads.back().reader->GetObjectCount()
+        << " objects)" << std::endl;
+    return true;
+}
+
+void SceneManager::UpdatePendingLoads() {
+    if (pendingLoads.empty()) return;
+
+    // One load per frame so the budget bounds the whole frame, not each load
+    PendingSceneLoad& load = pendingLoads.front();
+    if (!load.reader->Step(load.budget)) {
+        return;
+    }
+
+    PendingSceneLoad finished = std::move(load);
+    pendingLoads.erase(pendingLoads.begin());
+
+    Scene* scene = nullptr;
+    if (finished.reader->IsComplete()) {
+        std::unique_ptr<Scene> loadedScene = finished.reader->TakeScene();
+        scene = loadedScene.get();
+
+        if (AddScene(finished.sceneName, std::move(loadedScene))) {
+            std::cout << "Scene loaded: " << finished.sceneName << " in " << finished.reader->GetStepCount()
+                << " steps (longest " << finished.reader->GetLongestStepTime() << "ms)" << std::endl;
+        }
+        else {
+            scene = nullptr;
+        }
+    }
+    else {
+        std::cerr << "Scene load failed: " << finished.sceneName << std::endl;
+    }
+
+    if (finished.callback) {
+        finished.callback(scene);
+    }
+}
+
+bool SceneManager::IsSceneLoadPending(const std::string& sceneName) const {
+    return std::any_of(pendingLoads.begin(), pendingLoads.end(), [&sceneName](const PendingSceneLoad& load) {
+        return load.sceneName == sceneName;
+        });
+}
+
+void SceneManager::CancelPendingLoads() {
+    pendingLoads.clear();
+}
+
+// Background scene file saving
+bool SceneManager::SaveSceneAsync(const std::string& sceneName, const std::string& filepath,
+    const std::function<void(bool)>& callback) {
+    if (!HasScene(sceneName)) {
+        std::cerr << "Cannot save scene: " << sceneName << " (not found)" << std::endl;
+        return false;
+    }
+
+    PendingSceneSave save;
+    save.sceneName = sceneName;
+    save.filepath = filepath;
+    save.callback = callback;
+    pendingSaves.push_back(std::move(save));
+    return true;
+}
+
+void SceneManager::UpdatePendingSaves() {
+    if (pendingSaves.empty()) return;
+
+    // Callbacks run after the scan, they may queue new saves
+    std::vector<PendingSceneSave> finished;
+
+    for (auto it = pendingSaves.begin(); it != pendingSaves.end();) {
+        PendingSceneSave& save = *it;
+
+        // Newly queued: capture now, between frames
+        if (!save.result.valid()) {
+            Scene* scene = GetScene(save.sceneName);
+            if (!scene) {
+                std::cerr << "Cannot save scene: " << save.sceneName << " (removed)" << std::endl;
+                finished.push_back(std::move(save));
+                it = pendingSaves.erase(it);
+                continue;
+            }
+
+            StartSave(save, *scene);
+            ++it;
+            continue;
+        }
+
+        if (save.result.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            ++it;
+            continue;
+        }
+
+        finished.push_back(std::move(save));
+        it = pendingSaves.erase(it);
+    }
+
+    for (PendingSceneSave& save : finished) {
+        bool success = false;
+        if (save.result.valid()) {
+            IOResult result = save.result.get();
+            success = result.success;
+
+            if (success) {
+                std::cout << "Scene saved: " << save.sceneName << " -> " << save.filepath << " ("
+                    << save.capture->GetObjectCount() << " objects, " << save.captureTime
+                    << "ms on the main thread)" << std::endl;
+            }
+            else {
+                std::cerr << "Failed to write scene file: " << save.filepath << " (" << std::strerror(result.error)
+                    << ")" << std::endl;
+            }
+
+            // Keep the capture buffers for the next save
+            spareCaptures.push_back(std::move(save.capture));
+        }
+
+        if (save.callback) {
+            save.callback(success);
+        }
+    }
+}
+
+void SceneManager::WaitForPendingSaves() {
+    while (!pendingSaves.empty()) {
+        for (PendingSceneSave& save : pendingSaves) {
+            if (save.result.valid()) {
+                save.result.wait();
+            }
+        }
+        UpdatePendingSaves();
+    }
+}
+
+void SceneManager::StartSave(PendingSceneSave& save, const Scene& scene) {
+    auto start = std::chrono::steady_clock::now();
+
+    if (spareCaptures.empty()) {
+        save.capture = std::make_unique<SceneCapture>();
+    }
+    else {
+        save.capture = std::move(spareCaptures.back());
+        spareCaptures.pop_back();
+    }
+    save.capture->Capture(scene);
+
+    save.captureTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    // One dedicated worker: saves finish in order and never take threads
+    // from the frame's update pool (compression runs single-threaded there)
+    if (!saveWorker) {
+        saveWorker = std::make_unique<ThreadPool>(1);
+    }
+
+    const SceneCapture* capture = save.capture.get();
+    std::string filepath = save.filepath;
+    bool compress = SceneSerializer::IsCompressionEnabled();
+    IOService& ioService = IOService::GetInstance();
+
+    save.result = saveWorker->Enqueue([capture, filepath, compress, &ioService]() {
+        return ioService.WriteFile(filepath, capture->Encode(compress)).get();
+        });
+}
+
 // Scene updates
 void SceneManager::Update(float deltaTime) {
     // Handle async scene transitions
@@ -209,6 +409,44 @@ void SceneManager::FixedUpdate(float fixedDeltaTime) {
     }
 }
 
+// World streaming
+WorldStreamer* SceneManager::EnableWorldStreaming(const std::string& sceneName, const WorldStreamingConfig& config) {
+    Scene* scene = GetScene(sceneName);
+    if (!scene) {
+        std::cerr << "Cannot stream into missing scene: " << sceneName << std::endl;
+        return nullptr;
+    }
+
+    DisableWorldStreaming();
+    worldStreamer = std::make_unique<WorldStreamer>(scene, config);
+    return worldStreamer.get();
+}
+
+void SceneManager::DisableWorldStreaming() {
+    if (!worldStreamer) return;
+
+    worldStreamer->UnloadAll();
+    worldStreamer.reset();
+}
+
+void SceneManager::SetStreamingFocus(int focusId, const Vector3& position) {
+    if (worldStreamer) {
+        worldStreamer->SetFocusPoint(focusId, position);
+    }
+}
+
+void SceneManager::RemoveStreamingFocus(int focusId) {
+    if (worldStreamer) {
+        worldStreamer->RemoveFocusPoint(focusId);
+    }
+}
+
+void SceneManager::UpdateStreaming() {
+    if (worldStreamer) {
+        worldStreamer->Update();
+    }
+}
+
 // Global GameObject operations
 GameObject* SceneManager::CreateGameObject(const std::string& tag) {
     if (currentScene) {
@@ -0,0 +1,507 @@
+#include "../include/core/WorldStreamer.h"
+#include "../include/core/Scene.h"
+#include "../include/factories/GameObjectFactory.h"
+#include "../include/io/IOService.h"
+#include "../include/io/BlockCompression.h"
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <cerrno>
+#include <limits>
+#include <filesystem>
+
+namespace {
+    // Cell file layout (native endianness):
+    //   char magic[4] | uint32 version | uint32 templateCount | uint32 entryCount
+    //   templateCount x (uint16 length, chars)
+    //   entryCount x (uint32 templateIndex, float position[3], float rotation[3], float scale[3])
+    const char kCellMagic[4] = { 'W', 'C', 'E', 'L' };
+    const uint32_t kCellVersion = 1;
+
+    template<typename T>
+    void WritePod(std::vector<uint8_t>& buffer, const T& value) {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+        buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+    }
+
+    template<typename T>
+    bool ReadPod(const std::vector<uint8_t>& buffer, size_t& offset, T& value) {
+        if (offset + sizeof(T) > buffer.size()) return false;
+        std::memcpy(&value, buffer.data() + offset, sizeof(T));
+        offset += sizeof(T);
+        return true;
+    }
+
+    void WriteVector3(std::vector<uint8_t>& buffer, const Vector3& v) {
+        WritePod(buffer, v.x);
+        WritePod(buffer, v.y);
+        WritePod(buffer, v.z);
+    }
+
+    bool ReadVector3(const std::vector<uint8_t>& buffer, size_t& offset, Vector3& v) {
+        return ReadPod(buffer, offset, v.x) && ReadPod(buffer, offset, v.y) && ReadPod(buffer, offset, v.z);
+    }
+}
+
+WorldStreamer::WorldStreamer(Scene* targetScene, const WorldStreamingConfig& streamingConfig)
+    : scene(targetScene)
+    , gameObjectFactory(GameObjectFactory::GetInstance())
+    , config(streamingConfig) {
+
+    // The unload radius must never be inside the load radius, otherwise cells thrash
+    config.unloadRadius = std::max(config.unloadRadius, config.loadRadius);
+    config.cellSize = std::max(config.cellSize, 1.0f);
+    config.maxConcurrentLoads = std::max(config.maxConcurrentLoads, static_cast<size_t>(1));
+
+    loaderPool = std::make_unique<ThreadPool>(std::max(config.loaderThreads, static_cast<size_t>(1)));
+    std::cout << "WorldStreamer initialized (cell size: " << config.cellSize
+        << ", load radius: " << config.loadRadius
+        << ", unload radius: " << config.unloadRadius << ")" << std::endl;
+}
+
+WorldStreamer::~WorldStreamer() {
+    // Loader threads drain their queue before joining, so pending futures complete
+    loaderPool.reset();
+}
+
+// Focus points
+void WorldStreamer::SetFocusPoint(int focusId, const Vector3& position) {
+    focusPoints[focusId] = position;
+}
+
+void WorldStreamer::RemoveFocusPoint(int focusId) {
+    focusPoints.erase(focusId);
+}
+
+// Per-frame update
+void WorldStreamer::Update() {
+    if (!scene) return;
+
+    CollectFinishedLoads();
+    UnloadDistantCells();
+    RequestNearbyCells();
+    IntegrateWithinBudget();
+}
+
+void WorldStreamer::UnloadAll() {
+    for (auto& pair : cells) {
+        CellRecord& cell = pair.second;
+        if (cell.state == WorldCellState::Loading && cell.pendingLoad.valid()) {
+            cell.pendingLoad.wait();
+        }
+        for (size_t id : cell.objectIds) {
+            if (scene) {
+                scene->DestroyGameObject(id);
+            }
+        }
+    }
+
+    cells.clear();
+    loadsInFlight = 0;
+    residentObjects = 0;
+}
+
+size_t WorldStreamer::GetResidentCellCount() const {
+    return std::count_if(cells.begin(), cells.end(), [](const auto& pair) {
+        return pair.second.state == WorldCellState::Resident;
+        });
+}
+
+bool WorldStreamer::IsCellResident(const WorldCellCoord& coord) const {
+    auto it = cells.find(coord);
+    return it != cells.end() && it->second.state == WorldCellState::Resident;
+}
+
+// Cell math
+WorldCellCoord WorldStreamer::CellFromPosition(const Vector3& position, float cellSize) {
+    return WorldCellCoord(
+        static_cast<int>(std::floor(position.x / cellSize)),
+        static_cast<int>(std::floor(position.z / cellSize)));
+}
+
+std::string WorldStreamer::GetCellPath(const std::string& directory, const WorldCellCoord& coord) {
+    return directory + "/cell_" + std::to_string(coord.x) + "_" + std::to_string(coord.z) + ".wcell";
+}
+
+// Cell file access (through the IOService)
+bool WorldStreamer::WriteCellFile(const std::string& filepath, const WorldCellData& data, bool compress) {
+    IOResult result = IOService::GetInstance().WriteFile(filepath, EncodeCell(data, compress)).get();
+    if (!result.success) {
+        std::cerr << "Failed to write world cell: " << filepath << " (" << std::strerror(result.error) << ")" << std::endl;
+    }
+    return result.success;
+}
+
+WorldCellData WorldStreamer::ReadCellFile(const std::string& filepath) {
+    return ParseCell(IOService::GetInstance().ReadFile(filepath).get());
+}
+
+std::vector<uint8_t> WorldStreamer::EncodeCell(const WorldCellData& data, bool compress) {
+    std::vector<uint8_t> buffer;
+    buffer.reserve(16 + data.entries.size() * (sizeof(uint32_t) + 9 * sizeof(float)));
+
+    buffer.insert(buffer.end(), kCellMagic, kCellMagic + sizeof(kCellMagic));
+    WritePod(buffer, kCellVersion);
+    WritePod(buffer, static_cast<uint32_t>(data.templateNames.size()));
+    WritePod(buffer, static_cast<uint32_t>(data.entries.size()));
+
+    for (const std::string& name : data.templateNames) {
+        uint16_t length = static_cast<uint16_t>(std::min(name.size(), static_cast<size_t>(UINT16_MAX)));
+        WritePod(buffer, length);
+        buffer.insert(buffer.end(), name.begin(), name.begin() + length);
+    }
+
+    for (const WorldCellData::Entry& entry : data.entries) {
+        WritePod(buffer, entry.templateIndex);
+        WriteVector3(buffer, entry.position);
+        WriteVector3(buffer, entry.rotation);
+        WriteVector3(buffer, entry.scale);
+    }
+
+    // Compressed cells are one frame around the same layout
+    if (compress) {
+        std::vector<uint8_t> frame;
+        BlockCompression::CompressFrame(buffer.data(), buffer.size(), frame);
+        return frame;
+    }
+    return buffer;
+}
+
+WorldCellData WorldStreamer::ParseCell(const IOResult& file) {
+    WorldCellData data;
+    const std::string& filepath = file.path;
+
+    if (!file.success) {
+        // Missing cells are valid and simply empty
+        if (file.error == ENOENT) {
+            data.valid = true;
+        }
+        else {
+            std::cerr << "Failed to read world cell: " << filepath << " (" << std::strerror(file.error) << ")" << std::endl;
+        }
+        return data;
+    }
+
+    std::vector<uint8_t> expanded;
+    if (BlockCompression::IsFrame(file.data.data(), file.data.size()) &&
+        !BlockCompression::DecompressFrame(file.data.data(), file.data.size(), expanded)) {
+        std::cerr << "Corrupt compressed world cell: " << filepath << std::endl;
+        return data;
+    }
+    const std::vector<uint8_t>& buffer = expanded.empty() ? file.data : expanded;
+
+    size_t offset = 0;
+    char magic[4] = {};
+    uint32_t version = 0, templateCount = 0, entryCount = 0;
+
+    if (buffer.size() < sizeof(magic) || std::memcmp(buffer.data(), kCellMagic, sizeof(magic)) != 0) {
+        std::cerr << "Invalid world cell file: " << filepath << std::endl;
+        return data;
+    }
+    offset += sizeof(magic);
+
+    if (!ReadPod(buffer, offset, version) || version != kCellVersion ||
+        !ReadPod(buffer, offset, templateCount) || !ReadPod(buffer, offset, entryCount)) {
+        std::cerr << "Unsupported world cell file: " << filepath << std::endl;
+        return data;
+    }
+
+    data.templateNames.reserve(templateCount);
+    for (uint32_t i = 0; i < templateCount; ++i) {
+        uint16_t length = 0;
+        if (!ReadPod(buffer, offset, length) || offset + length > buffer.size()) {
+            std::cerr << "Truncated world cell file: " << filepath << std::endl;
+            return data;
+        }
+        data.templateNames.emplace_back(reinterpret_cast<const char*>(buffer.data()) + offset, length);
+        offset += length;
+    }
+
+    data.entries.resize(entryCount);
+    for (WorldCellData::Entry& entry : data.entries) {
+        if (!ReadPod(buffer, offset, entry.templateIndex) ||
+            !ReadVector3(buffer, offset, entry.position) ||
+            !ReadVector3(buffer, offset, entry.rotation) ||
+            !ReadVector3(buffer, offset, entry.scale) ||
+            entry.templateIndex >= templateCount) {
+            std::cerr << "Corrupt world cell file: " << filepath << std::endl;
+            data.entries.clear();
+            return data;
+        }
+    }
+
+    data.valid = true;
+    return data;
+}
+
+size_t WorldStreamer::BakeWorld(const std::string& directory, float cellSize, const std::vector<WorldPlacement>& placements,
+    bool compress) {
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+
+    // Partition placements into cells, each with its own string table
+    std::unordered_map<WorldCellCoord, WorldCellData, WorldCellCoordHash> bakedCells;
+    std::unordered_map<WorldCellCoord, std::unordered_map<std::string, uint32_t>, WorldCellCoordHash> nameIndices;
+
+    for (const WorldPlacement& placement : placements) {
+        WorldCellCoord coord = CellFromPosition(placement.position, cellSize);
+        WorldCellData& cell = bakedCells[coord];
+        auto& names = nameIndices[coord];
+
+        auto it = names.find(placement.templateName);
+        if (it == names.end()) {
+            it = names.emplace(placement.templateName, static_cast<uint32_t>(cell.templateNames.size())).first;
+            cell.templateNames.push_back(placement.templateName);
+        }
+
+        WorldCellData::Entry entry;
+        entry.templateIndex = it->second;
+        entry.position = placement.position;
+        entry.rotation = placement.rotation;
+        entry.scale = placement.scale;
+        cell.entries.push_back(entry);
+    }
+
+    // One batch, the cells are written concurrently
+    std::vector<IORequest> writes;
+    writes.reserve(bakedCells.size());
+    for (const auto& pair : bakedCells) {
+        writes.push_back(IORequest::Write(GetCellPath(directory, pair.first), EncodeCell(pair.second, compress)));
+    }
+
+    size_t written = 0;
+    for (auto& future : IOService::GetInstance().Submit(std::move(writes))) {
+        IOResult result = future.get();
+        if (result.success) {
+            written++;
+        }
+        else {
+            std::cerr << "Failed to write world cell: " << result.path << " (" << std::strerror(result.error) << ")" << std::endl;
+        }
+    }
+
+    std::cout << "Baked " << placements.size() << " placements into " << written
+        << " world cells in " << directory << std::endl;
+    return written;
+}
+
+// Debug
+void WorldStreamer::PrintStreamingInfo() const {
+    std::cout << "\n=== WorldStreamer Info ===" << std::endl;
+    std::cout << "Focus Points: " << focusPoints.size() << std::endl;
+    std::cout << "Tracked Cells: " << cells.size() << std::endl;
+    std::cout << "Resident Cells: " << GetResidentCellCount() << std::endl;
+    std::cout << "Resident Objects: " << residentObjects << std::endl;
+    std::cout << "Loads In Flight: " << loadsInFlight << std::endl;
+    std::cout << "Last Integration Time: " << lastIntegrationTime << "ms (budget: "
+        << config.integrationBudgetMs << "ms)" << std::endl;
+}
+
+// Private helpers
+float WorldStreamer::DistanceToNearestFocus(const WorldCellCoord& coord) const {
+    float minX = coord.x * config.cellSize;
+    float minZ = coord.z * config.cellSize;
+    float maxX = minX + config.cellSize;
+    float maxZ = minZ + config.cellSize;
+
+    float best = std::numeric_limits<float>::max();
+    for (const auto& pair : focusPoints) {
+        // Distance from the focus to the closest point of the cell on the XZ plane
+        float dx = std::max(std::max(minX - pair.second.x, 0.0f), pair.second.x - maxX);
+        float dz = std::max(std::max(minZ - pair.second.z, 0.0f), pair.second.z - maxZ);
+        best = std::min(best, std::sqrt(dx * dx + dz * dz));
+    }
+    return best;
+}
+
+void WorldStreamer::CollectFinishedLoads() {
+    std::vector<WorldCellCoord> discarded;
+
+    for (auto& pair : cells) {
+        CellRecord& cell = pair.second;
+        if (cell.state != WorldCellState::Loading) continue;
+
+        if (cell.pendingLoad.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            continue;
+        }
+
+        cell.data = cell.pendingLoad.get();
+        loadsInFlight--;
+
+        if (cell.cancelled || !cell.data.valid) {
+            discarded.push_back(pair.first);
+            continue;
+        }
+
+        cell.state = WorldCellState::Integrating;
+        cell.objectIds.reserve(cell.data.entries.size());
+    }
+
+    for (const WorldCellCoord& coord : discarded) {
+        cells.erase(coord);
+    }
+}
+
+void WorldStreamer::UnloadDistantCells() {
+    for (auto& pair : cells) {
+        CellRecord& cell = pair.second;
+        cell.priority = DistanceToNearestFocus(pair.first);
+
+        if (cell.priority <= config.unloadRadius) continue;
+
+        switch (cell.state) {
+        case WorldCellState::Loading:
+            cell.cancelled = true;
+            break;
+        case WorldCellState::Integrating:
+        case WorldCellState::Resident:
+            cell.state = WorldCellState::Unloading;
+            cell.data = WorldCellData(); // Release parsed data early
+            break;
+        case WorldCellState::Unloading:
+            break;
+        }
+    }
+}
+
+void WorldStreamer::RequestNearbyCells() {
+    if (focusPoints.empty() || loadsInFlight >= config.maxConcurrentLoads) return;
+
+    std::unordered_map<WorldCellCoord, float, WorldCellCoordHash> candidates;
+
+    for (const auto& pair : focusPoints) {
+        const Vector3& focus = pair.second;
+        WorldCellCoord minCell = CellFromPosition(Vector3(focus.x - config.loadRadius, 0.0f, focus.z - config.loadRadius), config.cellSize);
+        WorldCellCoord maxCell = CellFromPosition(Vector3(focus.x + config.loadRadius, 0.0f, focus.z + config.loadRadius), config.cellSize);
+
+        for (int x = minCell.x; x <= maxCell.x; ++x) {
+            for (int z = minCell.z; z <= maxCell.z; ++z) {
+                WorldCellCoord coord(x, z);
+                if (cells.find(coord) != cells.end() || candidates.find(coord) != candidates.end()) continue;
+
+                float distance = DistanceToNearestFocus(coord);
+                if (distance <= config.loadRadius) {
+                    candidates.emplace(coord, distance);
+                }
+            }
+        }
+    }
+
+    // Closest cells first
+    std::vector<std::pair<WorldCellCoord, float>> ordered(candidates.begin(), candidates.end());
+    std::sort(ordered.begin(), ordered.end(), [](const auto& a, const auto& b) {
+        return a.second < b.second;
+        });
+
+    for (const auto& candidate : ordered) {
+        if (loadsInFlight >= config.maxConcurrentLoads) break;
+
+        CellRecord& cell = cells[candidate.first];
+        cell.coord = candidate.first;
+        cell.state = WorldCellState::Loading;
+        cell.priority = candidate.second;
+
+        std::string path = GetCellPath(config.cellDirectory, candidate.first);
+        // Read on the IOService, parse on a loader thread
+        auto promise = std::make_shared<std::promise<WorldCellData>>();
+        cell.pendingLoad = promise->get_future();
+        ThreadPool* parsers = loaderPool.get();
+        IOService::GetInstance().ReadFile(path, [promise, parsers](IOResult& result) {
+            auto file = std::make_shared<IOResult>(std::move(result));
+            parsers->EnqueueTask([promise, file]() { promise->set_value(ParseCell(*file)); });
+            });
+        loadsInFlight++;
+    }
+}
+
+void WorldStreamer::IntegrateWithinBudget() {
+    auto start = std::chrono::high_resolution_clock::now();
+    auto deadline = start + std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(
+        std::chrono::duration<float, std::milli>(config.integrationBudgetMs));
+
+    // Unloads first (they free memory), then integrations ordered by distance
+    std::vector<CellRecord*> work;
+    for (auto& pair : cells) {
+        if (pair.second.state == WorldCellState::Integrating || pair.second.state == WorldCellState::Unloading) {
+            work.push_back(&pair.second);
+        }
+    }
+
+    std::sort(work.begin(), work.end(), [](const CellRecord* a, const CellRecord* b) {
+        bool aUnload = a->state == WorldCellState::Unloading;
+        bool bUnload = b->state == WorldCellState::Unloading;
+        if (aUnload != bUnload) return aUnload;
+        return a->priority < b->priority;
+        });
+
+    std::vector<WorldCellCoord> finishedUnloads;
+
+    for (CellRecord* cell : work) {
+        bool done = false;
+        while (!done && std::chrono::high_resolution_clock::now() < deadline) {
+            done = (cell->state == WorldCellState::Unloading) ? UnloadStep(*cell) : IntegrateStep(*cell);
+        }
+
+        if (done && cell->state == WorldCellState::Unloading) {
+            finishedUnloads.push_back(cell->coord);
+        }
+        else if (done) {
+            cell->state = WorldCellState::Resident;
+            cell->data = WorldCellData(); // Parsed data is no longer needed once instantiated
+        }
+
+        if (std::chrono::high_resolution_clock::now() >= deadline) break;
+    }
+
+    for (const WorldCellCoord& coord : finishedUnloads) {
+        cells.erase(coord);
+    }
+
+    lastIntegrationTime = std::chrono::duration<float, std::milli>(
+        std::chrono::high_resolution_clock::now() - start).count();
+}
+
+bool WorldStreamer::IntegrateStep(CellRecord& cell) {
+    if (cell.integratedCount >= cell.data.entries.size()) {
+        return true;
+    }
+
+    const WorldCellData::Entry& entry = cell.data.entries[cell.integratedCount++];
+    const std::string& templateName = cell.data.templateNames[entry.templateIndex];
+
+    auto result = gameObjectFactory.CreateGameObject(templateName);
+    if (result.success && result.gameObject) {
+        Transform* transform = result.gameObject->GetComponent<Transform>();
+        if (!transform) {
+            transform = result.gameObject->AddComponent<Transform>();
+        }
+        transform->SetPosition(entry.position);
+        transform->SetRotation(entry.rotation);
+        transform->SetScale(entry.scale);
+
+        cell.objectIds.push_back(result.gameObject->GetId());
+        scene->AddGameObject(std::move(result.gameObject));
+        residentObjects++;
+    }
+    else {
+        result.PrintErrors();
+    }
+
+    return cell.integratedCount >= cell.data.entries.size();
+}
+
+bool WorldStreamer::UnloadStep(CellRecord& cell) {
+    if (cell.objectIds.empty()) {
+        return true;
+    }
+
+    size_t id = cell.objectIds.back();
+    cell.objectIds.pop_back();
+    if (scene->DestroyGameObject(id)) {
+        residentObjects--;
+    }
+
+    return cell.objectIds.empty();
+}
@@ -1,10 +1,127 @@
 #include "../include/factories/ComponentFactory.h"
 #include "../include/components/Transform.h"
 #include "../include/components/Behavior.h"
+#include "../include/factories/TemplateParser.h"
+#include "../include/io/MappedFile.h"
+#include "../include/io/ParseCache.h"
 #include <iostream>
-#include <fstream>
-#include <sstream>
 #include <algorithm>
+#include <cstddef>
+
+namespace {
+    // Seed attempts per table size before the perfect hash table is doubled
+    const uint64_t kMaxNameSeeds = 256;
+
+    // FNV-1a with a seeded offset basis
+    uint64_t HashName(std::string_view name, uint64_t seed) {
+        uint64_t hash = 14695981039346656037ull ^ (seed * 0x9E3779B97F4A7C15ull);
+        for (char c : name) {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    // Transform: position/rotation/scale fields, plus the legacy scalar config
+    // names (x, rotX, ...) as aliases into them
+    ComponentSchema BuildTransformSchema() {
+        auto schema = ComponentSchema::Create<Transform>("Transform", TransformData());
+
+        const size_t position = offsetof(TransformData, position);
+        const size_t rotation = offsetof(TransformData, rotation);
+        const size_t scale = offsetof(TransformData, scale);
+
+        schema.AddField("position", FieldType::Vector3, position)
+            .AddField("rotation", FieldType::Vector3, rotation)
+            .AddField("scale", FieldType::Vector3, scale)
+            .AddAlias("x", FieldType::Float, position + offsetof(Vector3, x))
+            .AddAlias("y", FieldType::Float, position + offsetof(Vector3, y))
+            .AddAlias("z", FieldType::Float, position + offsetof(Vector3, z))
+            .AddAlias("rotX", FieldType::Float, rotation + offsetof(Vector3, x))
+            .AddAlias("rotY", FieldType::Float, rotation + offsetof(Vector3, y))
+            .AddAlias("rotZ", FieldType::Float, rotation + offsetof(Vector3, z))
+            .AddAlias("scaleX", FieldType::Float, scale + offsetof(Vector3, x))
+            .AddAlias("scaleY", FieldType::Float, scale + offsetof(Vector3, y))
+            .AddAlias("scaleZ", FieldType::Float, scale + offsetof(Vector3, z));
+
+        schema.SetCreate([](const void* image) -> std::unique_ptr<Component> {
+            const TransformData& data = *static_cast<const TransformData*>(image);
+            return std::make_unique<Transform>(data.position, data.rotation, data.scale);
+            });
+
+        schema.SetEmplace([](GameObject& owner, const void* image) -> Component* {
+            const TransformData& data = *static_cast<const TransformData*>(image);
+            if (Transform* existing = owner.GetComponent<Transform>()) {
+                existing->SetPosition(data.position);
+                existing->SetRotation(data.rotation);
+                existing->SetScale(data.scale);
+                return existing;
+            }
+            return owner.AddComponent<Transform>(data.position, data.rotation, data.scale);
+            });
+
+        schema.SetCapture([](const Component& component, void* image) {
+            const Transform& transform = static_cast<const Transform&>(component);
+            TransformData& data = *static_cast<TransformData*>(image);
+            data.position = transform.GetPosition();
+            data.rotation = transform.GetRotation();
+            data.scale = transform.GetScale();
+            });
+
+        schema.SetApply([](Component& component, const void* image) {
+            Transform& transform = static_cast<Transform&>(component);
+            const TransformData& data = *static_cast<const TransformData*>(image);
+            transform.SetPosition(data.position);
+            transform.SetRotation(data.rotation);
+            transform.SetScale(data.scale);
+            });
+
+        return schema;
+    }
+}
+
+// ===== ComponentConfig =====
+
+bool ComponentConfig::Compile(const ComponentSchema& schema) {
+    patches.clear();
+    patches.reserve(properties.size());
+
+    bool allResolved = true;
+    for (const auto& property : properties) {
+        FieldPatch patch;
+        if (schema.CompilePatch(property.first, property.second, patch)) {
+            patches.push_back(patch);
+        }
+        else if (schema.HasFields()) {
+            std::cerr << "Ignoring property " << typeName << "." << property.first
+                << " = '" << property.second.ToString() << "'" << std::endl;
+            allResolved = false;
+        }
+    }
+
+    // Property iteration order is unspecified; make overlapping writes
+    // (e.g. "scale" and "scaleX") deterministic: whole fields first
+    std::stable_sort(patches.begin(), patches.end(), [](const FieldPatch& a, const FieldPatch& b) {
+        return a.size > b.size;
+        });
+
+    compiledSchema = &schema;
+    compiledRevision = schema.GetRevision();
+    return allResolved;
+}
+
+void ComponentConfig::BuildImage(const ComponentSchema& schema, void* image) const {
+    schema.InitImage(image);
+
+    if (IsCompiledFor(schema)) {
+        ComponentSchema::ApplyPatches(image, patches);
+        return;
+    }
+
+    ComponentConfig compiled = *this;
+    compiled.Compile(schema);
+    ComponentSchema::ApplyPatches(image, compiled.patches);
+}
 
 // Static instance initialization
 ComponentFactory* ComponentFactory::instance = nullptr;
@@ -28,53 +145,124 @@ ComponentFactory::ComponentFactory() {
 
 // Component registration checks
 bool ComponentFactory::IsComponentRegistered(const std::string& typeName) const {
-    return componentFactories.find(typeName) != componentFactories.end();
+    return FindInfo(typeName) != nullptr;
 }
 
 bool ComponentFactory::IsComponentRegistered(size_t componentId) const {
-    return idToName.find(componentId) != idToName.end();
+    return FindInfo(componentId) != nullptr;
+}
+
+bool ComponentFactory::HasConfigCreator(const std::string& typeName) const {
+    const ComponentFactoryInfo* info = FindInfo(typeName);
+    return info && info->HasConfigCreator();
+}
+
+// Reflection schemas
+void ComponentFactory::RegisterSchema(const ComponentSchema& schema) {
+    // Replace in place so schema pointers held elsewhere stay valid
+    auto it = schemas.find(schema.GetTypeName());
+    if (it != schemas.end()) {
+        schemasByType.erase(it->second->GetTypeIndex());
+        *it->second = schema;
+    }
+    else {
+        it = schemas.emplace(schema.GetTypeName(), std::make_unique<ComponentSchema>(schema)).first;
+    }
+    schemasByType[schema.GetTypeIndex()] = it->second.get();
+    it->second->SetRevision(++schemaGeneration);
+
+    for (ComponentFactoryInfo& info : registry) {
+        if (info.typeName == schema.GetTypeName()) {
+            info.schema = it->second.get();
+        }
+    }
+
+    // Presets compiled against the previous schema must be recompiled
+    for (auto& pair : presets) {
+        if (pair.second.typeName == schema.GetTypeName()) {
+            pair.second.Compile(*GetSchema(schema.GetTypeName()));
+        }
+    }
+}
+
+const ComponentSchema* ComponentFactory::GetSchema(const std::string& typeName) const {
+    if (const ComponentFactoryInfo* info = FindInfo(typeName)) {
+        if (info->schema) return info->schema;
+    }
+
+    // Schemas may also be registered for types without a factory entry
+    auto it = schemas.find(typeName);
+    return it != schemas.end() ? it->second.get() : nullptr;
+}
+
+const ComponentSchema* ComponentFactory::GetSchema(const std::type_index& typeIndex) const {
+    auto it = schemasByType.find(typeIndex);
+    return it != schemasByType.end() ? it->second : nullptr;
+}
+
+uint64_t ComponentFactory::GetSchemaFingerprint() const {
+    std::vector<const ComponentSchema*> ordered;
+    ordered.reserve(schemas.size());
+    for (const auto& pair : schemas) {
+        ordered.push_back(pair.second.get());
+    }
+    std::sort(ordered.begin(), ordered.end(), [](const ComponentSchema* a, const ComponentSchema* b) {
+        return a->GetTypeName() < b->GetTypeName();
+        });
+
+    uint64_t hash = 0;
+    for (const ComponentSchema* schema : ordered) {
+        const std::string& name = schema->GetTypeName();
+        hash = ParseCache::HashBytes(name.data(), name.size(), hash);
+        for (const FieldInfo& field : schema->GetFields()) {
+            uint32_t layout[3] = { static_cast<uint32_t>(field.type), field.offset, field.size };
+            hash = ParseCache::HashBytes(field.name.data(), field.name.size(), hash);
+            hash = ParseCache::HashBytes(layout, sizeof(layout), hash);
+        }
+    }
+    return hash;
 }
 
 // Component creation by name
 std::unique_ptr<Component> ComponentFactory::CreateComponent(const std::string& typeName) {
-    auto it = componentFactories.find(typeName);
-    if (it == componentFactories.end()) {
+    const ComponentFactoryInfo* info = FindInfo(typeName);
+    if (!info) {
         std::cerr << "Component not registered: " << typeName << std::endl;
         return nullptr;
     }
 
-    return it->second.defaultCreator();
+    return info->defaultCreator();
 }
 
 std::unique_ptr<Component> ComponentFactory::CreateComponent(const std::string& typeName, const ComponentConfig& config) {
-    auto it = componentFactories.find(typeName);
-    if (it == componentFactories.end()) {
+    const ComponentFactoryInfo* info = FindInfo(typeName);
+    if (!info) {
         std::cerr << "Component not registered: " << typeName << std::endl;
         return nullptr;
     }
 
-    return it->second.configCreator(config);
+    return CreateFromInfo(*info, config);
 }
 
 // Component creation by ID
 std::unique_ptr<Component> ComponentFactory::CreateComponent(size_t componentId) {
-    auto it = idToName.find(componentId);
-    if (it == idToName.end()) {
+    const ComponentFactoryInfo* info = FindInfo(componentId);
+    if (!info) {
         std::cerr << "Component ID not found: " << componentId << std::endl;
         return nullptr;
     }
 
-    return CreateComponent(it->second);
+    return info->defaultCreator();
 }
 
 std::unique_ptr<Component> ComponentFactory::CreateComponent(size_t componentId, const ComponentConfig& config) {
-    auto it = idToName.find(componentId);
-    if (it == idToName.end()) {
+    const ComponentFactoryInfo* info = FindInfo(componentId);
+    if (!info) {
         std::cerr << "Component ID not found: " << componentId << std::endl;
         return nullptr;
     }
 
-    return CreateComponent(it->second, config);
+    return CreateFromInfo(*info, config);
 }
 
 // Batch component creation
@@ -108,28 +296,22 @@ std::vector<std::unique_ptr<Component>> ComponentFactory::CreateComponents(const
 
 // Component ID management
 size_t ComponentFactory::GetComponentId(const std::string& typeName) const {
-    auto it = componentIds.find(typeName);
-    if (it != componentIds.end()) {
-        return it->second;
-    }
-    return 0; // Invalid ID
+    const ComponentFactoryInfo* info = FindInfo(typeName);
+    return info ? info->id : 0; // 0 = invalid ID
 }
 
 std::string ComponentFactory::GetComponentName(size_t componentId) const {
-    auto it = idToName.find(componentId);
-    if (it != idToName.end()) {
-        return it->second;
-    }
-    return ""; // Invalid name
+    const ComponentFactoryInfo* info = FindInfo(componentId);
+    return info ? info->typeName : ""; // Invalid name
 }
 
 // Factory information
 std::vector<std::string> ComponentFactory::GetRegisteredComponentNames() const {
     std::vector<std::string> names;
-    names.reserve(componentFactories.size());
+    names.reserve(registry.size());
 
-    for (const auto& pair : componentFactories) {
-        names.push_back(pair.first);
+    for (const ComponentFactoryInfo& info : registry) {
+        names.push_back(info.typeName);
     }
 
     return names;
@@ -137,10 +319,10 @@ std::vector<std::string> ComponentFactory::GetRegisteredComponentNames() const {
 
 std::vector<size_t> ComponentFactory::GetRegisteredComponentIds() const {
     std::vector<size_t> ids;
-    ids.reserve(componentIds.size());
+    ids.reserve(registry.size());
 
-    for (const auto& pair : componentIds) {
-        ids.push_back(pair.second);
+    for (const ComponentFactoryInfo& info : registry) {
+        ids.push_back(info.id);
     }
 
     return ids;
@@ -148,62 +330,60 @@ std::vector<size_t> ComponentFactory::GetRegisteredComponentIds() const {
 
 // Data-driven creation from strings/files
 std::unique_ptr<Component> ComponentFactory::CreateFromString(const std::string& componentData) {
-    // Simple format: "ComponentType:property1=value1,property2=value2"
-    std::stringstream ss(componentData);
-    std::string typeName;
-
-    if (!std::getline(ss, typeName, ':')) {
-        std::cerr << "Invalid component data format" << std::endl;
+    // Format: "ComponentType:property1=value1,property2=value2"
+    ComponentConfig config;
+    TemplateParseError error;
+    if (!TemplateParser::ParseComponentString(componentData, config, &error)) {
+        std::cerr << "Invalid component data: " << error.ToString() << std::endl;
         return nullptr;
     }
 
-    ComponentConfig config(typeName);
-
-    std::string propertiesStr;
-    if (std::getline(ss, propertiesStr)) {
-        std::stringstream propStream(propertiesStr);
-        std::string property;
-
-        while (std::getline(propStream, property, ',')) {
-            size_t equalPos = property.find('=');
-            if (equalPos != std::string::npos) {
-                std::string key = property.substr(0, equalPos);
-                std::string value = property.substr(equalPos + 1);
-                config.SetProperty(key, value);
-            }
-        }
-    }
-
-    return CreateComponent(typeName, config);
+    return CreateComponent(config.typeName, config);
 }
 
 std::vector<std::unique_ptr<Component>> ComponentFactory::CreateFromFile(const std::string& filepath) {
     std::vector<std::unique_ptr<Component>> components;
-    std::ifstream file(filepath);
+    MappedFile file;
 
-    if (!file.is_open()) {
+    if (!file.Open(filepath)) {
         std::cerr << "Failed to open component file: " << filepath << std::endl;
         return components;
     }
 
-    std::string line;
-    while (std::getline(file, line)) {
-        if (!line.empty() && line[0] != '#') { // Skip empty lines and comments
-            auto component = CreateFromString(line);
-            if (component) {
-                components.push_back(std::move(component));
-            }
+    std::string_view text(reinterpret_cast<const char*>(file.GetData()), file.GetSize());
+    std::string_view line;
+    size_t lineNumber = 0;
+    ComponentConfig config;
+    TemplateParseError error;
+
+    while (TemplateParser::NextLine(text, line)) {
+        lineNumber++;
+        if (line.empty() || line[0] == '#') continue; // Skip empty lines and comments
+
+        if (!TemplateParser::ParseComponentString(line, config, &error)) {
+            error.source = filepath;
+            error.line = lineNumber;
+            std::cerr << "Invalid component data: " << error.ToString() << std::endl;
+            continue;
+        }
+
+        auto component = CreateComponent(config.typeName, config);
+        if (component) {
+            components.push_back(std::move(component));
         }
     }
 
-    file.close();
     std::cout << "Loaded " << components.size() << " components from " << filepath << std::endl;
     return components;
 }
 
 // Component presets/templates
 void ComponentFactory::RegisterPreset(const std::string& presetName, const ComponentConfig& config) {
-    presets[presetName] = config;
+    ComponentConfig& preset = presets[presetName];
+    preset = config;
+    if (const ComponentSchema* schema = GetSchema(config.typeName)) {
+        preset.Compile(*schema);
+    }
     std::cout << "Registered component preset: " << presetName << std::endl;
 }
 
@@ -225,46 +405,24 @@ bool ComponentFactory::HasPreset(const std::string& presetName) const {
 void ComponentFactory::PrintRegisteredComponents() const {
     std::cout << "\n=== Registered Components ===" << std::endl;
 
-    for (const auto& pair : componentFactories) {
-        size_t id = GetComponentId(pair.first);
-        std::cout << "- " << pair.first << " (ID: " << id << ")" << std::endl;
+    for (const ComponentFactoryInfo& info : registry) {
+        std::cout << "- " << info.typeName << " (ID: " << info.id << ")" << std::endl;
     }
 }
 
 void ComponentFactory::PrintFactoryInfo() const {
     std::cout << "\n=== ComponentFactory Info ===" << std::endl;
-    std::cout << "Registered Components: " << componentFactories.size() << std::endl;
+    std::cout << "Registered Components: " << registry.size() << std::endl;
     std::cout << "Registered Presets: " << presets.size() << std::endl;
-    std::cout << "Next Component ID: " << nextId << std::endl;
+    std::cout << "Next Component ID: " << registry.size() + 1 << std::endl;
+    std::cout << "Name Hash Slots: " << nameSlots.size() << std::endl;
 }
 
 // Private helpers
 void ComponentFactory::InitializeBuiltinComponents() {
-    // Register Transform with configuration support
-    RegisterComponentWithConfig<Transform>("Transform",
-        [](const ComponentConfig& config) -> std::unique_ptr<Transform> {
-            float x = config.GetFloat("x", 0.0f);
-            float y = config.GetFloat("y", 0.0f);
-            float z = config.GetFloat("z", 0.0f);
-
-            auto transform = std::make_unique<Transform>(x, y, z);
-
-            // Set rotation if provided
-            float rx = config.GetFloat("rotX", 0.0f);
-            float ry = config.GetFloat("rotY", 0.0f);
-            float rz = config.GetFloat("rotZ", 0.0f);
-            if (rx != 0.0f || ry != 0.0f || rz != 0.0f) {
-                transform->SetRotation(rx, ry, rz);
-            }
-
-            // Set scale if provided
-            float scale = config.GetFloat("scale", 1.0f);
-            if (scale != 1.0f) {
-                transform->SetScale(scale);
-            }
-
-            return transform;
-        });
+    // Register Transform as a data-driven type
+    RegisterComponent<Transform>("Transform");
+    RegisterSchema(BuildTransformSchema());
 
     // Register basic Behavior
     RegisterComponent<Behavior>("Behavior");
@@ -281,9 +439,81 @@ void ComponentFactory::InitializeBuiltinComponents() {
     std::cout << "Built-in components and presets registered" << std::endl;
 }
 
-size_t ComponentFactory::AssignComponentId(const std::string& typeName) {
-    size_t id = nextId++;
-    componentIds[typeName] = id;
-    idToName[id] = typeName;
-    return id;
-}
\ No newline at end of file
+size_t ComponentFactory::AddRegistryEntry(ComponentFactoryInfo info) {
+    info.id = registry.size() + 1;
+
+    auto schemaIt = schemas.find(info.typeName);
+    if (schemaIt != schemas.end()) {
+        info.schema = schemaIt->second.get();
+    }
+
+    registry.push_back(std::move(info));
+    RebuildNameHash();
+    return registry.back().id;
+}
+
+void ComponentFactory::RebuildNameHash() {
+    // Start at twice the name count and grow until some seed is collision free
+    size_t tableSize = 1;
+    while (tableSize < registry.size() * 2) {
+        tableSize <<= 1;
+    }
+
+    std::vector<uint32_t> slots;
+    for (;; tableSize <<= 1) {
+        for (uint64_t seed = 1; seed <= kMaxNameSeeds; ++seed) {
+            slots.assign(tableSize, 0);
+
+            bool collision = false;
+            for (const ComponentFactoryInfo& info : registry) {
+                uint32_t& slot = slots[HashName(info.typeName, seed) & (tableSize - 1)];
+                if (slot != 0) {
+                    collision = true;
+                    break;
+                }
+                slot = static_cast<uint32_t>(info.id);
+            }
+
+            if (!collision) {
+                nameSlots = std::move(slots);
+                nameSeed = seed;
+                nameMask = tableSize - 1;
+                return;
+            }
+        }
+    }
+}
+
+const ComponentFactoryInfo* ComponentFactory::FindInfo(std::string_view typeName) const {
+    if (nameSlots.empty()) return nullptr;
+
+    uint32_t id = nameSlots[HashName(typeName, nameSeed) & nameMask];
+    if (id == 0) return nullptr;
+
+    // Names outside the set can land on any slot, so confirm the match
+    const ComponentFactoryInfo& info = registry[id - 1];
+    return info.typeName == typeName ? &info : nullptr;
+}
+
+std::unique_ptr<Component> ComponentFactory::CreateFromInfo(const ComponentFactoryInfo& info, const ComponentConfig& config) const {
+    if (info.HasConfigCreator()) {
+        return info.configCreator(config);
+    }
+
+    // Data-driven types: default image plus the config's typed patches
+    const ComponentSchema* schema = info.schema;
+    if (schema && schema->HasFields()) {
+        const size_t kStackWords = 16;
+        if (schema->GetImageWords() <= kStackWords) {
+            uint64_t image[kStackWords];
+            config.BuildImage(*schema, image);
+            return schema->CreateComponent(image);
+        }
+
+        std::vector<uint64_t> image(schema->GetImageWords());
+        config.BuildImage(*schema, image.data());
+        return schema->CreateComponent(image.data());
+    }
+
+    return info.defaultCreator();
+}
@@ -0,0 +1,351 @@
+#include "../include/factories/ComponentSchema.h"
+#include <iostream>
+#include <sstream>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+#include <algorithm>
+#include <charconv>
+#include <string_view>
+
+namespace {
+    bool ParseFloat(const std::string& text, float& value) {
+        if (text.empty()) return false;
+        char* end = nullptr;
+        errno = 0;
+        value = std::strtof(text.c_str(), &end);
+        return errno == 0 && end != text.c_str() && *end == '\0';
+    }
+
+    // Parses straight into int32_t, so out-of-range text fails instead of
+    // wrapping (from_chars rejects a leading '+', accept it like strtol does)
+    bool ParseInt(const std::string& text, int32_t& value) {
+        std::string_view digits = text;
+        if (digits.size() > 1 && digits[0] == '+') digits.remove_prefix(1);
+        if (digits.empty()) return false;
+        const char* end = digits.data() + digits.size();
+        auto result = std::from_chars(digits.data(), end, value);
+        return result.ec == std::errc() && result.ptr == end;
+    }
+
+    bool ParseBool(const std::string& text, bool& value) {
+        if (text == "true" || text == "1") { value = true; return true; }
+        if (text == "false" || text == "0") { value = false; return true; }
+        return false;
+    }
+
+    // Accepts "x,y,z", "x y z" or a single value that is splatted
+    bool ParseVector3(const std::string& text, Vector3& value) {
+        std::string normalized = text;
+        for (char& c : normalized) {
+            if (c == ',') c = ' ';
+        }
+
+        std::istringstream stream(normalized);
+        float components[3];
+        size_t count = 0;
+        while (count < 3 && stream >> components[count]) {
+            count++;
+        }
+
+        if (count == 1) {
+            value = Vector3(components[0], components[0], components[0]);
+            return true;
+        }
+        if (count == 3) {
+            value = Vector3(components[0], components[1], components[2]);
+            return true;
+        }
+        return false;
+    }
+}
+
+size_t GetFieldTypeSize(FieldType type) {
+    switch (type) {
+    case FieldType::Bool: return sizeof(bool);
+    case FieldType::Int: return sizeof(int32_t);
+    case FieldType::Float: return sizeof(float);
+    case FieldType::Vector3: return sizeof(Vector3);
+    default: return 0;
+    }
+}
+
+const char* GetFieldTypeName(FieldType type) {
+    switch (type) {
+    case FieldType::Bool: return "Bool";
+    case FieldType::Int: return "Int";
+    case FieldType::Float: return "Float";
+    case FieldType::Vector3: return "Vector3";
+    case FieldType::String: return "String";
+    default: return "Unknown";
+    }
+}
+
+// ===== PropertyValue =====
+
+PropertyValue PropertyValue::FromBool(bool value) {
+    PropertyValue result;
+    result.type = FieldType::Bool;
+    result.boolValue = value;
+    return result;
+}
+
+PropertyValue PropertyValue::FromInt(int32_t value) {
+    PropertyValue result;
+    result.type = FieldType::Int;
+    result.intValue = value;
+    return result;
+}
+
+PropertyValue PropertyValue::FromFloat(float value) {
+    PropertyValue result;
+    result.type = FieldType::Float;
+    result.floatValue = value;
+    return result;
+}
+
+PropertyValue PropertyValue::FromVector3(const Vector3& value) {
+    PropertyValue result;
+    result.type = FieldType::Vector3;
+    result.vectorValue[0] = value.x;
+    result.vectorValue[1] = value.y;
+    result.vectorValue[2] = value.z;
+    return result;
+}
+
+PropertyValue PropertyValue::FromString(const std::string& value) {
+    PropertyValue result;
+    result.type = FieldType::String;
+    result.stringValue = value;
+    return result;
+}
+
+bool PropertyValue::AsBool(bool defaultValue) const {
+    switch (type) {
+    case FieldType::Bool: return boolValue;
+    case FieldType::Int: return intValue != 0;
+    case FieldType::Float: return floatValue != 0.0f;
+    case FieldType::String: {
+        bool value;
+        return ParseBool(stringValue, value) ? value : defaultValue;
+    }
+    default: return defaultValue;
+    }
+}
+
+int32_t PropertyValue::AsInt(int32_t defaultValue) const {
+    switch (type) {
+    case FieldType::Bool: return boolValue ? 1 : 0;
+    case FieldType::Int: return intValue;
+    case FieldType::Float: return static_cast<int32_t>(floatValue);
+    case FieldType::String: {
+        int32_t value;
+        return ParseInt(stringValue, value) ? value : defaultValue;
+    }
+    default: return defaultValue;
+    }
+}
+
+float PropertyValue::AsFloat(float defaultValue) const {
+    switch (type) {
+    case FieldType::Bool: return boolValue ? 1.0f : 0.0f;
+    case FieldType::Int: return static_cast<float>(intValue);
+    case FieldType::Float: return floatValue;
+    case FieldType::String: {
+        float value;
+        return ParseFloat(stringValue, value) ? value : defaultValue;
+    }
+    default: return defaultValue;
+    }
+}
+
+Vector3 PropertyValue::AsVector3(const Vector3& defaultValue) const {
+    switch (type) {
+    case FieldType::Int:
+    case FieldType::Float: {
+        float value = AsFloat();
+        return Vector3(value, value, value);
+    }
+    case FieldType::Vector3: return Vector3(vectorValue[0], vectorValue[1], vectorValue[2]);
+    case FieldType::String: {
+        Vector3 value;
+        return ParseVector3(stringValue, value) ? value : defaultValue;
+    }
+    default: return defaultValue;
+    }
+}
+
+std::string PropertyValue::ToString() const {
+    std::ostringstream stream;
+    switch (type) {
+    case FieldType::Bool: return boolValue ? "true" : "false";
+    case FieldType::Int: stream << intValue; break;
+    case FieldType::Float: stream << floatValue; break;
+    case FieldType::Vector3: stream << vectorValue[0] << "," << vectorValue[1] << "," << vectorValue[2]; break;
+    case FieldType::String: return stringValue;
+    }
+    return stream.str();
+}
+
+bool PropertyValue::Encode(FieldType target, uint8_t* destination) const {
+    switch (target) {
+    case FieldType::Bool: {
+        bool value = false;
+        if (type == FieldType::String) {
+            if (!ParseBool(stringValue, value)) return false;
+        }
+        else if (type == FieldType::Vector3) {
+            return false;
+        }
+        else {
+            value = AsBool();
+        }
+        std::memcpy(destination, &value, sizeof(value));
+        return true;
+    }
+    case FieldType::Int: {
+        int32_t value = 0;
+        if (type == FieldType::String) {
+            if (!ParseInt(stringValue, value)) return false;
+        }
+        else if (type == FieldType::Vector3) {
+            return false;
+        }
+        else {
+            value = AsInt();
+        }
+        std::memcpy(destination, &value, sizeof(value));
+        return true;
+    }
+    case FieldType::Float: {
+        float value = 0.0f;
+        if (type == FieldType::String) {
+            if (!ParseFloat(stringValue, value)) return false;
+        }
+        else if (type == FieldType::Vector3) {
+            return false;
+        }
+        else {
+            value = AsFloat();
+        }
+        std::memcpy(destination, &value, sizeof(value));
+        return true;
+    }
+    case FieldType::Vector3: {
+        // Scalars are splatted, so "scale:2" sets all three axes
+        Vector3 value;
+        if (type == FieldType::String) {
+            if (!ParseVector3(stringValue, value)) return false;
+        }
+        else if (type == FieldType::Bool) {
+            return false;
+        }
+        else {
+            value = AsVector3();
+        }
+        std::memcpy(destination, &value, sizeof(value));
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+// ===== ComponentSchema =====
+
+ComponentSchema::ComponentSchema(const std::string& name, std::type_index index, const void* defaults, size_t imageSize)
+    : typeName(name)
+    , typeIndex(index)
+    , defaultImage(imageSize) {
+    if (defaults && imageSize > 0) {
+        std::memcpy(defaultImage.data(), defaults, imageSize);
+    }
+}
+
+ComponentSchema& ComponentSchema::AddField(const std::string& name, FieldType type, size_t offset) {
+    size_t size = GetFieldTypeSize(type);
+    if (size == 0 || offset + size > defaultImage.size()) {
+        std::cerr << "Invalid schema field " << typeName << "." << name << std::endl;
+        return *this;
+    }
+
+    fields.push_back({ name, type, static_cast<uint32_t>(offset), static_cast<uint32_t>(size) });
+    return *this;
+}
+
+ComponentSchema& ComponentSchema::AddAlias(const std::string& name, FieldType type, size_t offset) {
+    size_t size = GetFieldTypeSize(type);
+    if (size == 0 || offset + size > defaultImage.size()) {
+        std::cerr << "Invalid schema alias " << typeName << "." << name << std::endl;
+        return *this;
+    }
+
+    aliases.push_back({ name, type, static_cast<uint32_t>(offset) });
+    return *this;
+}
+
+const FieldInfo* ComponentSchema::FindField(std::string_view name) const {
+    for (const FieldInfo& field : fields) {
+        if (field.name == name) {
+            return &field;
+        }
+    }
+    return nullptr;
+}
+
+bool ComponentSchema::CompilePatch(const std::string& property, const PropertyValue& value, FieldPatch& patch) const {
+    FieldType targetType;
+    uint32_t offset;
+
+    if (const FieldInfo* field = FindField(property)) {
+        targetType = field->type;
+        offset = field->offset;
+    }
+    else {
+        auto alias = std::find_if(aliases.begin(), aliases.end(), [&property](const Alias& entry) {
+            return entry.name == property;
+            });
+        if (alias == aliases.end()) {
+            return false;
+        }
+        targetType = alias->type;
+        offset = alias->offset;
+    }
+
+    patch.offset = offset;
+    patch.size = static_cast<uint32_t>(GetFieldTypeSize(targetType));
+    return value.Encode(targetType, patch.bytes);
+}
+
+void ComponentSchema::InitImage(void* image) const {
+    if (!defaultImage.empty()) {
+        std::memcpy(image, defaultImage.data(), defaultImage.size());
+    }
+}
+
+void ComponentSchema::ApplyPatches(void* image, const std::vector<FieldPatch>& patches) {
+    uint8_t* bytes = static_cast<uint8_t*>(image);
+    for (const FieldPatch& patch : patches) {
+        std::memcpy(bytes + patch.offset, patch.bytes, patch.size);
+    }
+}
+
+std::unique_ptr<Component> ComponentSchema::CreateComponent(const void* image) const {
+    return create ? create(image) : nullptr;
+}
+
+Component* ComponentSchema::EmplaceComponent(GameObject& owner, const void* image) const {
+    return emplace ? emplace(owner, image) : nullptr;
+}
+
+void ComponentSchema::CaptureComponent(const Component& component, void* image) const {
+    if (capture) {
+        capture(component, image);
+    }
+}
+
+void ComponentSchema::ApplyToComponent(Component& component, const void* image) const {
+    if (apply) {
+        apply(component, image);
+    }
+}
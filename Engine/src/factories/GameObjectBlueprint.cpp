@@ -0,0 +1,155 @@
+#include "../include/factories/GameObjectBlueprint.h"
+#include "../include/factories/GameObjectFactory.h"
+#include "../include/factories/ComponentFactory.h"
+#include <algorithm>
+#include <cstring>
+
+std::unique_ptr<GameObjectBlueprint> GameObjectBlueprint::Compile(const GameObjectTemplate& gameObjectTemplate,
+    const ComponentFactory& componentFactory, std::vector<std::string>& errors, size_t templateId) {
+    auto blueprint = std::make_unique<GameObjectBlueprint>();
+    blueprint->templateId = templateId;
+    blueprint->name = gameObjectTemplate.name;
+    blueprint->tag = gameObjectTemplate.tag;
+    blueprint->active = gameObjectTemplate.active;
+    blueprint->schemaGeneration = componentFactory.GetSchemaGeneration();
+    blueprint->components.reserve(gameObjectTemplate.components.size());
+
+    // Lay out one image slot per component
+    size_t imageWords = 0;
+    for (const ComponentConfig& config : gameObjectTemplate.components) {
+        const ComponentSchema* schema = componentFactory.GetSchema(config.typeName);
+        if (!schema) {
+            errors.push_back("Unknown component type: " + config.typeName);
+            continue;
+        }
+
+        ComponentEntry entry;
+        entry.schema = schema;
+        entry.componentId = componentFactory.GetComponentId(config.typeName);
+        entry.imageOffset = static_cast<uint32_t>(imageWords * sizeof(uint64_t));
+
+        // Always compile against the current schema; stored patches may be stale
+        ComponentConfig compiled = config;
+        if (!compiled.Compile(*schema)) {
+            errors.push_back("Ignored properties in " + gameObjectTemplate.name + "." + config.typeName);
+        }
+        entry.patches = std::move(compiled.patches);
+
+        if (componentFactory.HasConfigCreator(config.typeName)) {
+            entry.config = std::make_unique<ComponentConfig>(config);
+        }
+
+        imageWords += schema->GetImageWords();
+        blueprint->components.push_back(std::move(entry));
+    }
+
+    // Bake defaults and patches
+    blueprint->image.assign(imageWords, 0);
+    uint8_t* bytes = reinterpret_cast<uint8_t*>(blueprint->image.data());
+    for (const ComponentEntry& entry : blueprint->components) {
+        entry.schema->InitImage(bytes + entry.imageOffset);
+        ComponentSchema::ApplyPatches(bytes + entry.imageOffset, entry.patches);
+    }
+
+    return blueprint;
+}
+
+std::unique_ptr<GameObject> GameObjectBlueprint::Instantiate() const {
+    return Instantiate(GameObject::ReserveIds(1));
+}
+
+std::unique_ptr<GameObject> GameObjectBlueprint::Instantiate(size_t objectId) const {
+    auto gameObject = std::make_unique<GameObject>(objectId, tag);
+    gameObject->SetTemplateId(templateId);
+
+    // Deactivate first so components are not enabled just to be disabled again
+    if (!active) {
+        gameObject->SetActive(false);
+    }
+
+    AddComponentsTo(*gameObject);
+    return gameObject;
+}
+
+void GameObjectBlueprint::AddComponentsTo(GameObject& gameObject) const {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(image.data());
+    for (const ComponentEntry& entry : components) {
+        if (entry.config) {
+            gameObject.AttachComponent(ComponentFactory::GetInstance().CreateComponent(entry.componentId, *entry.config));
+        }
+        else {
+            entry.schema->EmplaceComponent(gameObject, bytes + entry.imageOffset);
+        }
+    }
+}
+
+BlueprintDiff GameObjectBlueprint::Diff(const GameObjectBlueprint& previous, const GameObjectBlueprint& current) {
+    BlueprintDiff diff;
+    diff.templateId = current.templateId;
+    diff.templateName = current.name;
+
+    // Offsets are only comparable if both were compiled against the same schemas
+    bool sameLayout = previous.schemaGeneration == current.schemaGeneration;
+    const uint8_t* previousBytes = reinterpret_cast<const uint8_t*>(previous.image.data());
+    const uint8_t* currentBytes = reinterpret_cast<const uint8_t*>(current.image.data());
+
+    for (const ComponentEntry& entry : current.components) {
+        const uint8_t* currentImage = currentBytes + entry.imageOffset;
+
+        BlueprintDiff::ComponentChange change;
+        change.schema = entry.schema;
+        change.componentId = entry.componentId;
+
+        auto old = std::find_if(previous.components.begin(), previous.components.end(),
+            [&entry](const ComponentEntry& candidate) { return candidate.componentId == entry.componentId; });
+
+        if (old == previous.components.end()) {
+            change.added = true;
+            change.image.assign(entry.schema->GetImageWords(), 0);
+            std::memcpy(change.image.data(), currentImage, entry.schema->GetImageSize());
+            if (entry.config) {
+                change.config = std::make_unique<ComponentConfig>(*entry.config);
+            }
+            diff.components.push_back(std::move(change));
+            continue;
+        }
+
+        const uint8_t* previousImage = previousBytes + old->imageOffset;
+        for (const FieldInfo& field : entry.schema->GetFields()) {
+            if (sameLayout && std::memcmp(previousImage + field.offset, currentImage + field.offset, field.size) == 0) {
+                continue;
+            }
+
+            FieldPatch patch;
+            patch.offset = field.offset;
+            patch.size = field.size;
+            std::memcpy(patch.bytes, currentImage + field.offset, field.size);
+            change.patches.push_back(patch);
+        }
+
+        if (!change.patches.empty()) {
+            diff.components.push_back(std::move(change));
+        }
+    }
+
+    for (const ComponentEntry& entry : previous.components) {
+        auto kept = std::find_if(current.components.begin(), current.components.end(),
+            [&entry](const ComponentEntry& candidate) { return candidate.componentId == entry.componentId; });
+        if (kept == current.components.end()) {
+            diff.removedComponents.push_back(entry.schema->GetTypeName());
+        }
+    }
+
+    return diff;
+}
+
+const void* GameObjectBlueprint::GetComponentImage(size_t index) const {
+    if (index >= components.size()) {
+        return nullptr;
+    }
+    return reinterpret_cast<const uint8_t*>(image.data()) + components[index].imageOffset;
+}
+
+bool GameObjectBlueprint::IsCurrent(const ComponentFactory& componentFactory) const {
+    return schemaGeneration == componentFactory.GetSchemaGeneration();
+}
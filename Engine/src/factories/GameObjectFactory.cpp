@@ -2,9 +2,16 @@
 #include "../include/core/Scene.h"
 #include "../include/components/Transform.h"
 #include "../include/components/Behavior.h"
+#include "../include/systems/ThreadPool.h"
+#include "../include/factories/TemplateParser.h"
+#include "../include/io/MappedFile.h"
+#include "../include/io/ParseCache.h"
+#include "../include/io/IOService.h"
+#include "../include/io/AssetArchive.h"
 #include <iostream>
 #include <fstream>
-#include <sstream>
+#include <algorithm>
+#include <filesystem>
 
 // Static instance initialization
 GameObjectFactory* GameObjectFactory::instance = nullptr;
@@ -28,11 +35,37 @@ GameObjectFactory::GameObjectFactory() : componentFactory(ComponentFactory::GetI
 
 // Template registration
 void GameObjectFactory::RegisterTemplate(const GameObjectTemplate& gameObjectTemplate) {
-    templates[gameObjectTemplate.name] = gameObjectTemplate;
-    templatesRegistered++;
+    std::vector<std::string> errors;
+    StoreTemplate(gameObjectTemplate, errors);
+    for (const std::string& error : errors) {
+        std::cerr << "Template " << gameObjectTemplate.name << ": " << error << std::endl;
+    }
+
     std::cout << "Registered GameObject template: " << gameObjectTemplate.name << std::endl;
 }
 
+void GameObjectFactory::StoreTemplate(GameObjectTemplate gameObjectTemplate, std::vector<std::string>& errors) {
+    auto id = templateIds.emplace(gameObjectTemplate.name, nextTemplateId);
+    if (id.second) {
+        nextTemplateId++;
+    }
+
+    // Resolve types and properties once, not per spawn
+    auto blueprint = GameObjectBlueprint::Compile(gameObjectTemplate, componentFactory, errors, id.first->second);
+
+    // Direct CreateGameObject(template) calls reuse these compiled patches
+    for (ComponentConfig& config : gameObjectTemplate.components) {
+        if (const ComponentSchema* schema = componentFactory.GetSchema(config.typeName)) {
+            config.Compile(*schema);
+        }
+    }
+
+    const std::string name = gameObjectTemplate.name;
+    templates[name] = std::move(gameObjectTemplate);
+    blueprints[name] = std::move(blueprint);
+    templatesRegistered++;
+}
+
 void GameObjectFactory::RegisterTemplate(const std::string& name, const std::string& tag,
     const std::vector<ComponentConfig>& components) {
     GameObjectTemplate gameObjectTemplate(name, tag);
@@ -54,16 +87,34 @@ const GameObjectTemplate* GameObjectFactory::GetTemplate(const std::string& temp
     return nullptr;
 }
 
+const GameObjectBlueprint* GameObjectFactory::GetBlueprint(const std::string& templateName) {
+    auto it = blueprints.find(templateName);
+    if (it == blueprints.end()) {
+        return nullptr;
+    }
+
+    if (!it->second->IsCurrent(componentFactory)) {
+        std::vector<std::string> errors;
+        it->second = GameObjectBlueprint::Compile(templates[templateName], componentFactory, errors,
+            it->second->GetTemplateId());
+        for (const std::string& error : errors) {
+            std::cerr << "Template " << templateName << ": " << error << std::endl;
+        }
+    }
+    return it->second.get();
+}
+
 // GameObject creation from templates
 GameObjectCreationResult GameObjectFactory::CreateGameObject(const std::string& templateName) {
-    auto it = templates.find(templateName);
-    if (it == templates.end()) {
+    const GameObjectBlueprint* blueprint = GetBlueprint(templateName);
+    if (!blueprint) {
         GameObjectCreationResult result;
         result.AddError("Template not found: " + templateName);
         return result;
     }
 
-    return CreateGameObject(it->second);
+    objectsCreated++;
+    return GameObjectCreationResult(blueprint->Instantiate());
 }
 
 GameObjectCreationResult GameObjectFactory::CreateGameObject(const GameObjectTemplate& gameObjectTemplate) {
@@ -71,8 +122,9 @@ GameObjectCreationResult GameObjectFactory::CreateGameObject(const GameObjectTem
 
     auto gameObject = CreateGameObjectInternal(gameObjectTemplate, result);
     if (gameObject) {
+        // The object is still handed back when some components failed
         result.gameObject = std::move(gameObject);
-        result.success = true;
+        result.success = !result.HasErrors();
         objectsCreated++;
     }
 
@@ -93,15 +145,48 @@ GameObjectCreationResult GameObjectFactory::CreateGameObject(const std::string&
 // Batch GameObject creation
 std::vector<GameObjectCreationResult> GameObjectFactory::CreateGameObjects(const std::string& templateName, size_t count) {
     std::vector<GameObjectCreationResult> results;
-    results.reserve(count);
 
+    const GameObjectBlueprint* blueprint = GetBlueprint(templateName);
+    if (!blueprint) {
+        results.emplace_back();
+        results.back().AddError("Template not found: " + templateName);
+        return results;
+    }
+
+    results.reserve(count);
     for (size_t i = 0; i < count; ++i) {
-        results.push_back(CreateGameObject(templateName));
+        results.emplace_back(blueprint->Instantiate());
     }
+    objectsCreated += count;
 
     return results;
 }
 
+std::vector<std::unique_ptr<GameObject>> GameObjectFactory::InstantiateBatch(const GameObjectBlueprint& blueprint,
+    size_t count, const std::function<void(GameObject&, size_t)>& initializer) {
+    std::vector<std::unique_ptr<GameObject>> batch(count);
+    if (count == 0) return batch;
+
+    // One ID range for the whole batch keeps IDs independent of scheduling
+    size_t firstId = GameObject::ReserveIds(count);
+
+    auto build = [&blueprint, &initializer, &batch, firstId](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            batch[i] = blueprint.Instantiate(firstId + i);
+            if (initializer) {
+                initializer(*batch[i], i);
+            }
+        }
+        };
+
+    // A few chunks per worker to even out uneven initializers
+    size_t chunkCount = threadPool && count >= parallelThreshold ? threadPool->GetThreadCount() * 4 : 1;
+    ParallelFor(threadPool, count, chunkCount, build);
+
+    objectsCreated += count;
+    return batch;
+}
+
 std::vector<GameObjectCreationResult> GameObjectFactory::CreateGameObjectsFromFile(const std::string& filepath) {
     std::vector<GameObjectCreationResult> results;
 
@@ -159,6 +244,7 @@ void GameObjectFactory::RemoveTemplate(const std::string& templateName) {
     auto it = templates.find(templateName);
     if (it != templates.end()) {
         templates.erase(it);
+        blueprints.erase(templateName);
         std::cout << "Removed template: " << templateName << std::endl;
     }
 }
@@ -166,6 +252,7 @@ void GameObjectFactory::RemoveTemplate(const std::string& templateName) {
 void GameObjectFactory::ClearTemplates() {
     size_t count = templates.size();
     templates.clear();
+    blueprints.clear();
     std::cout << "Cleared " << count << " templates" << std::endl;
 }
 
@@ -204,7 +291,7 @@ bool GameObjectFactory::SaveTemplate(const std::string& templateName, const std:
     for (const auto& config : temp.components) {
         file << "  - Type:" << config.typeName << std::endl;
         for (const auto& prop : config.properties) {
-            file << "    " << prop.first << ":" << prop.second << std::endl;
+            file << "    " << prop.first << ":" << prop.second.ToString() << std::endl;
         }
     }
 
@@ -214,64 +301,215 @@ bool GameObjectFactory::SaveTemplate(const std::string& templateName, const std:
 }
 
 bool GameObjectFactory::LoadTemplate(const std::string& filepath) {
-    // Simple template loading implementation
-    std::ifstream file(filepath);
-    if (!file.is_open()) {
+    std::vector<GameObjectTemplate> fileTemplates;
+    std::vector<TemplateParseError> errors;
+    if (!ReadTemplateFile(filepath, TemplateFileFormat::Document, GetParseCacheVersion(TemplateFileFormat::Document),
+        fileTemplates, errors)) {
         std::cerr << "Failed to open template file: " << filepath << std::endl;
         return false;
     }
 
-    // Basic parsing (could be improved with JSON/XML parsing)
-    std::string line;
-    std::string name, tag;
-    bool active = true;
-    std::vector<ComponentConfig> components;
+    for (const TemplateParseError& error : errors) {
+        std::cerr << "Template parse error: " << error.ToString() << std::endl;
+    }
 
-    while (std::getline(file, line)) {
-        if (line.empty() || line[0] == '#') continue;
+    // Register whatever parsed cleanly, even if other lines had errors
+    for (const GameObjectTemplate& gameObjectTemplate : fileTemplates) {
+        RegisterTemplate(gameObjectTemplate);
+    }
+
+    return errors.empty() && !fileTemplates.empty();
+}
+
+TemplateLoadReport GameObjectFactory::LoadTemplatesFromDirectory(const std::string& directory,
+    const std::string& extension) {
+    namespace fs = std::filesystem;
+    TemplateLoadReport report;
 
-        if (line.find("Name:") == 0) {
-            name = line.substr(5);
+    // Enumerate (sorted, so registration order does not depend on the file system)
+    std::vector<std::string> files;
+    std::error_code error;
+    fs::recursive_directory_iterator it(directory, fs::directory_options::skip_permission_denied, error);
+    if (error) {
+        report.errors.push_back(directory + ": " + error.message());
+        report.PrintErrors();
+        return report;
+    }
+    for (const fs::recursive_directory_iterator end; it != end; it.increment(error)) {
+        if (error) {
+            report.errors.push_back(directory + ": " + error.message());
+            break;
         }
-        else if (line.find("Tag:") == 0) {
-            tag = line.substr(4);
+        std::error_code typeError;
+        if (it->is_regular_file(typeError) && it->path().extension() == extension) {
+            files.push_back(it->path().generic_string());
         }
-        else if (line.find("Active:") == 0) {
-            active = line.substr(7) == "true";
+    }
+    std::sort(files.begin(), files.end());
+    report.filesFound = files.size();
+
+    // Read and parse; each file writes only its own slot
+    std::vector<ParsedTemplateFile> parsed(files.size());
+
+    // Without a parse cache every file is needed in full: queue all reads in
+    // one batch so the I/O overlaps with parsing the files that already arrived
+    std::vector<std::future<IOResult>> reads;
+    if (!parseCache) {
+        std::vector<IORequest> requests;
+        requests.reserve(files.size());
+        for (const std::string& file : files) {
+            requests.push_back(IORequest::Read(file));
         }
-        // Component parsing would go here...
+        reads = IOService::GetInstance().Submit(std::move(requests));
     }
 
-    if (!name.empty()) {
-        GameObjectTemplate temp(name, tag);
-        temp.SetActive(active);
-        for (const auto& config : components) {
-            temp.AddComponent(config);
+    uint64_t cacheVersion = GetParseCacheVersion(TemplateFileFormat::Document);
+    ParseInParallel(files.size(), [this, &files, &parsed, &reads, cacheVersion](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (reads.empty()) {
+                parsed[i].opened = ReadTemplateFile(files[i], TemplateFileFormat::Document, cacheVersion,
+                    parsed[i].templates, parsed[i].errors);
+                continue;
+            }
+
+            IOResult read = reads[i].get();
+            parsed[i].opened = read.success;
+            if (read.success) {
+                std::string_view text(reinterpret_cast<const char*>(read.data.data()), read.data.size());
+                TemplateParser::ParseDocument(text, parsed[i].templates, parsed[i].errors, files[i]);
+            }
         }
-        RegisterTemplate(temp);
-        return true;
+        });
+
+    RegisterParsedFiles(files, parsed, report);
+
+    report.PrintErrors();
+    std::cout << "Loaded " << report.templatesRegistered << " templates from " << report.filesLoaded
+        << "/" << report.filesFound << " files in " << directory << std::endl;
+    return report;
+}
+
+TemplateLoadReport GameObjectFactory::LoadTemplatesFromArchive(const AssetArchive& archive, const std::string& extension) {
+    TemplateLoadReport report;
+
+    std::vector<const ArchiveEntry*> entries = archive.FindByExtension(extension);
+    std::vector<std::string> files;
+    files.reserve(entries.size());
+    for (const ArchiveEntry* entry : entries) {
+        files.emplace_back(archive.GetEntryPath(*entry));
     }
+    report.filesFound = files.size();
+
+    // Stored entries are parsed straight from the mapping
+    std::vector<ParsedTemplateFile> parsed(files.size());
+    ParseInParallel(files.size(), [&archive, &entries, &files, &parsed](size_t begin, size_t end) {
+        std::vector<uint8_t> scratch;
+        for (size_t i = begin; i < end; ++i) {
+            std::string_view text;
+            parsed[i].opened = archive.GetContents(*entries[i], text, scratch);
+            if (parsed[i].opened) {
+                TemplateParser::ParseDocument(text, parsed[i].templates, parsed[i].errors, files[i]);
+            }
+        }
+        });
+
+    RegisterParsedFiles(files, parsed, report);
 
-    return false;
+    report.PrintErrors();
+    std::cout << "Loaded " << report.templatesRegistered << " templates from " << report.filesLoaded
+        << "/" << report.filesFound << " entries in " << archive.GetPath() << std::endl;
+    return report;
 }
 
-bool GameObjectFactory::LoadTemplatesFromDirectory(const std::string& directory) {
-    // Directory traversal would require platform-specific code
-    // For now, just load a few common template files
-    std::vector<std::string> templateFiles = {
-        directory + "/player.template",
-        directory + "/enemy.template",
-        directory + "/objects.template"
-    };
+void GameObjectFactory::ParseInParallel(size_t count, const std::function<void(size_t, size_t)>& parse) const {
+    // Small chunks, file sizes vary a lot
+    size_t chunkCount = threadPool ? threadPool->GetThreadCount() * 4 : 1;
+    ParallelFor(threadPool, count, chunkCount, parse);
+}
 
-    bool anyLoaded = false;
-    for (const std::string& file : templateFiles) {
-        if (LoadTemplate(file)) {
-            anyLoaded = true;
+void GameObjectFactory::RegisterParsedFiles(const std::vector<std::string>& files,
+    std::vector<ParsedTemplateFile>& parsed, TemplateLoadReport& report) {
+    // Register in path order
+    std::unordered_map<std::string, size_t> definedIn;
+    std::vector<std::string> compileErrors;
+    for (size_t i = 0; i < files.size(); ++i) {
+        ParsedTemplateFile& file = parsed[i];
+        if (!file.opened) {
+            report.errors.push_back(files[i] + ": failed to open");
+            continue;
         }
+        report.filesLoaded++;
+
+        for (const TemplateParseError& parseError : file.errors) {
+            report.errors.push_back(parseError.ToString());
+        }
+
+        for (GameObjectTemplate& gameObjectTemplate : file.templates) {
+            auto [previous, inserted] = definedIn.emplace(gameObjectTemplate.name, i);
+            if (!inserted) {
+                report.errors.push_back(files[i] + ": template '" + gameObjectTemplate.name +
+                    "' overrides the one in " + files[previous->second]);
+                previous->second = i;
+            }
+
+            compileErrors.clear();
+            std::string name = gameObjectTemplate.name;
+            StoreTemplate(std::move(gameObjectTemplate), compileErrors);
+            for (const std::string& compileError : compileErrors) {
+                report.errors.push_back(files[i] + ": template " + name + ": " + compileError);
+            }
+            report.templatesRegistered++;
+        }
+    }
+}
+
+TemplateLoadReport GameObjectFactory::ReloadTemplateFile(const std::string& filepath, std::vector<BlueprintDiff>& diffs) {
+    TemplateLoadReport report;
+    report.filesFound = 1;
+
+    std::vector<GameObjectTemplate> fileTemplates;
+    std::vector<TemplateParseError> parseErrors;
+    if (!ReadTemplateFile(filepath, TemplateFileFormat::Document, GetParseCacheVersion(TemplateFileFormat::Document),
+        fileTemplates, parseErrors)) {
+        report.errors.push_back(filepath + ": failed to open");
+        return report;
     }
+    report.filesLoaded = 1;
 
-    return anyLoaded;
+    if (!parseErrors.empty()) {
+        for (const TemplateParseError& parseError : parseErrors) {
+            report.errors.push_back(parseError.ToString());
+        }
+        return report;
+    }
+
+    std::vector<std::string> compileErrors;
+    for (GameObjectTemplate& gameObjectTemplate : fileTemplates) {
+        std::string name = gameObjectTemplate.name;
+
+        // Keep the old compilation alive for the diff
+        std::unique_ptr<GameObjectBlueprint> previous;
+        auto it = blueprints.find(name);
+        if (it != blueprints.end()) {
+            previous = std::move(it->second);
+        }
+
+        compileErrors.clear();
+        StoreTemplate(std::move(gameObjectTemplate), compileErrors);
+        for (const std::string& compileError : compileErrors) {
+            report.errors.push_back(filepath + ": template " + name + ": " + compileError);
+        }
+        report.templatesRegistered++;
+
+        if (previous) {
+            BlueprintDiff diff = GameObjectBlueprint::Diff(*previous, *blueprints[name]);
+            if (!diff.IsEmpty()) {
+                diffs.push_back(std::move(diff));
+            }
+        }
+    }
+
+    return report;
 }
 
 // Data-driven creation from strings
@@ -284,14 +522,18 @@ GameObjectCreationResult GameObjectFactory::CreateFromString(const std::string&
 void GameObjectFactory::PopulateScene(Scene* scene, const std::string& templateName, size_t count) {
     if (!scene) return;
 
-    auto results = CreateGameObjects(templateName, count);
-    for (auto& result : results) {
-        if (result.success && result.gameObject) {
-            scene->AddGameObject(std::move(result.gameObject));
-        }
-        else {
-            result.PrintErrors();
-        }
+    const GameObjectBlueprint* blueprint = GetBlueprint(templateName);
+    if (!blueprint) {
+        std::cerr << "GameObject creation error: Template not found: " << templateName << std::endl;
+        return;
+    }
+
+    if (threadPool && count >= parallelThreshold) {
+        scene->AddGameObjects(InstantiateBatch(*blueprint, count));
+    }
+    else {
+        scene->SpawnBatch(*blueprint, count);
+        objectsCreated += count;
     }
 
     std::cout << "Populated scene with " << count << " objects of type " << templateName << std::endl;
@@ -351,7 +593,7 @@ void GameObjectFactory::PrintTemplate(const std::string& templateName) const {
     for (const auto& config : temp.components) {
         std::cout << "  - " << config.typeName << std::endl;
         for (const auto& prop : config.properties) {
-            std::cout << "    " << prop.first << ": " << prop.second << std::endl;
+            std::cout << "    " << prop.first << ": " << prop.second.ToString() << std::endl;
         }
     }
 }
@@ -370,41 +612,31 @@ std::unique_ptr<GameObject> GameObjectFactory::CreateGameObjectInternal(const Ga
 void GameObjectFactory::ApplyComponentsToGameObject(GameObject* gameObject,
     const std::vector<ComponentConfig>& components,
     GameObjectCreationResult& result) {
+    std::vector<uint64_t> image;
+
     for (const auto& config : components) {
-        auto component = componentFactory.CreateComponent(config.typeName, config);
-        if (component) {
-            // Add component to GameObject
-            // Note: This would require GameObject to have a method to add existing components
-            // For now, we'll use the template-based AddComponent method
-
-            if (config.typeName == "Transform") {
-                auto* transform = gameObject->AddComponent<Transform>(
-                    config.GetFloat("x", 0.0f),
-                    config.GetFloat("y", 0.0f),
-                    config.GetFloat("z", 0.0f)
-                );
-
-                // Apply additional properties
-                float rx = config.GetFloat("rotX", 0.0f);
-                float ry = config.GetFloat("rotY", 0.0f);
-                float rz = config.GetFloat("rotZ", 0.0f);
-                if (rx != 0.0f || ry != 0.0f || rz != 0.0f) {
-                    transform->SetRotation(rx, ry, rz);
-                }
-
-                float scale = config.GetFloat("scale", 1.0f);
-                if (scale != 1.0f) {
-                    transform->SetScale(scale);
-                }
-            }
-            else if (config.typeName == "Behavior") {
-                gameObject->AddComponent<Behavior>();
+        const ComponentSchema* schema = componentFactory.GetSchema(config.typeName);
+        if (!schema) {
+            result.AddError("Unknown component type: " + config.typeName);
+            continue;
+        }
+
+        // Data-driven types are constructed once, directly from the config image
+        if (!componentFactory.HasConfigCreator(config.typeName)) {
+            image.resize(schema->GetImageWords());
+            config.BuildImage(*schema, image.data());
+            if (!schema->EmplaceComponent(*gameObject, image.data())) {
+                result.AddError("Failed to create component: " + config.typeName);
             }
-            // Add more component types as needed
+            continue;
         }
-        else {
+
+        auto component = componentFactory.CreateComponent(config.typeName, config);
+        if (!component) {
             result.AddError("Failed to create component: " + config.typeName);
+            continue;
         }
+        gameObject->AttachComponent(std::move(component));
     }
 }
 
@@ -434,22 +666,10 @@ void GameObjectFactory::InitializeBuiltinTemplates() {
 
 GameObjectTemplate GameObjectFactory::ParseTemplateFromString(const std::string& data) const {
     // Simple parsing: "TemplateName:Tag:Component1,Component2"
-    std::stringstream ss(data);
-    std::string name, tag, componentsStr;
-
-    std::getline(ss, name, ':');
-    std::getline(ss, tag, ':');
-    std::getline(ss, componentsStr);
-
-    GameObjectTemplate temp(name, tag);
-
-    if (!componentsStr.empty()) {
-        std::stringstream compStream(componentsStr);
-        std::string component;
-
-        while (std::getline(compStream, component, ',')) {
-            temp.AddComponent(component);
-        }
+    GameObjectTemplate temp;
+    TemplateParseError error;
+    if (!TemplateParser::ParseTemplateLine(data, temp, &error)) {
+        std::cerr << "Invalid template data: " << error.ToString() << std::endl;
     }
 
     return temp;
@@ -457,20 +677,102 @@ GameObjectTemplate GameObjectFactory::ParseTemplateFromString(const std::string&
 
 std::vector<GameObjectTemplate> GameObjectFactory::ParseTemplatesFromFile(const std::string& filepath) const {
     std::vector<GameObjectTemplate> gameObjectTemplates;
-    std::ifstream file(filepath);
+    std::vector<TemplateParseError> errors;
 
-    if (!file.is_open()) {
+    if (!ReadTemplateFile(filepath, TemplateFileFormat::Lines, GetParseCacheVersion(TemplateFileFormat::Lines),
+        gameObjectTemplates, errors)) {
         std::cerr << "Failed to open file: " << filepath << std::endl;
         return gameObjectTemplates;
     }
 
-    std::string line;
-    while (std::getline(file, line)) {
-        if (!line.empty() && line[0] != '#') {
-            gameObjectTemplates.push_back(ParseTemplateFromString(line));
+    for (const TemplateParseError& error : errors) {
+        std::cerr << "Invalid template data: " << error.ToString() << std::endl;
+    }
+    return gameObjectTemplates;
+}
+
+void GameObjectFactory::ParseTemplateLines(std::string_view text, const std::string& source,
+    std::vector<GameObjectTemplate>& fileTemplates, std::vector<TemplateParseError>& errors) {
+    std::string_view line;
+    size_t lineNumber = 0;
+    TemplateParseError error;
+
+    while (TemplateParser::NextLine(text, line)) {
+        lineNumber++;
+        if (line.empty() || line[0] == '#') continue;
+
+        GameObjectTemplate temp;
+        if (!TemplateParser::ParseTemplateLine(line, temp, &error)) {
+            error.source = source;
+            error.line = lineNumber;
+            errors.push_back(error);
+            continue;
         }
+        fileTemplates.push_back(std::move(temp));
     }
+}
 
-    file.close();
-    return gameObjectTemplates;
+bool GameObjectFactory::ReadTemplateFile(const std::string& filepath, TemplateFileFormat format, uint64_t cacheVersion,
+    std::vector<GameObjectTemplate>& fileTemplates, std::vector<TemplateParseError>& errors) const {
+    size_t errorCount = errors.size();
+    auto parse = [&](std::string_view text) {
+        if (format == TemplateFileFormat::Document) {
+            TemplateParser::ParseDocument(text, fileTemplates, errors, filepath);
+        }
+        else {
+            ParseTemplateLines(text, filepath, fileTemplates, errors);
+        }
+        };
+
+    if (parseCache) {
+        ParseCache::Entry entry;
+        if (!parseCache->Lookup(filepath, cacheVersion, entry)) {
+            return false;
+        }
+        if (entry.hit && TemplateParser::DecodeTemplates(entry.payload, entry.payloadSize, fileTemplates)) {
+            return true;
+        }
+
+        if (!entry.hit) {
+            size_t firstTemplate = fileTemplates.size();
+            parse(entry.GetSourceText());
+
+            // Only clean parses are cached, so errors are reported on every load
+            if (errors.size() == errorCount) {
+                std::vector<GameObjectTemplate> parsedTemplates(fileTemplates.begin() + firstTemplate, fileTemplates.end());
+                std::vector<uint8_t> payload;
+                TemplateParser::EncodeTemplates(parsedTemplates, payload);
+                parseCache->Store(entry, payload);
+            }
+            return true;
+        }
+        // Unreadable entry, fall through and parse the source directly
+    }
+
+    // Empty files cannot be mapped but are valid (no templates)
+    std::error_code sizeError;
+    if (std::filesystem::file_size(filepath, sizeError) == 0 && !sizeError) {
+        return true;
+    }
+
+    MappedFile file;
+    if (!file.Open(filepath)) {
+        return false;
+    }
+    parse(std::string_view(reinterpret_cast<const char*>(file.GetData()), file.GetSize()));
+    return true;
+}
+
+uint64_t GameObjectFactory::GetParseCacheVersion(TemplateFileFormat format) const {
+    if (!parseCache) {
+        return 0;
+    }
+
+    // Payload layout, file format and component schemas
+    uint64_t key[3] = {
+        TemplateParser::BinaryVersion,
+        static_cast<uint64_t>(format),
+        componentFactory.GetSchemaFingerprint()
+    };
+    return ParseCache::HashBytes(key, sizeof(key));
 }
\ No newline at end of file
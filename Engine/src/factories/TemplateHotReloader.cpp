@@ -0,0 +1,140 @@
+#include "../include/factories/TemplateHotReloader.h"
+#include "../include/core/Scene.h"
+#include <iostream>
+#include <filesystem>
+#include <chrono>
+
+TemplateHotReloader::TemplateHotReloader(GameObjectFactory& gameObjectFactory)
+    : factory(gameObjectFactory) {
+}
+
+bool TemplateHotReloader::Watch(const std::string& directory, const std::string& fileExtension) {
+    extension = fileExtension;
+    if (!watcher.Watch(directory)) {
+        return false;
+    }
+
+    std::cout << "Watching templates in " << directory << std::endl;
+    return true;
+}
+
+TemplateLoadReport TemplateHotReloader::ReloadFile(const std::string& filepath) {
+    std::vector<BlueprintDiff> diffs;
+    TemplateLoadReport report = factory.ReloadTemplateFile(filepath, diffs);
+    if (report.templatesRegistered == 0) {
+        return report;
+    }
+
+    filesReloaded++;
+    for (BlueprintDiff& diff : diffs) {
+        for (const std::string& removed : diff.removedComponents) {
+            std::cerr << "Hot reload: " << diff.templateName << " no longer has " << removed
+                << ", live instances keep it" << std::endl;
+        }
+
+        PendingPatch patch;
+        patch.diff = std::move(diff);
+        pending.push_back(std::move(patch));
+    }
+
+    std::cout << "Reloaded " << report.templatesRegistered << " templates from " << filepath
+        << " (" << diffs.size() << " changed)" << std::endl;
+    return report;
+}
+
+size_t TemplateHotReloader::Update(Scene& scene, const SceneLoadBudget& budget) {
+    std::vector<std::string> changedFiles;
+    if (watcher.Poll(changedFiles) > 0) {
+        for (const std::string& file : changedFiles) {
+            if (std::filesystem::path(file).extension() != extension) continue;
+            ReloadFile(file).PrintErrors();
+        }
+    }
+
+    if (pending.empty()) {
+        return 0;
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    auto outOfBudget = [&](size_t patched) {
+        if (budget.maxObjects > 0 && patched >= budget.maxObjects) return true;
+        if (budget.maxMicroseconds > 0) {
+            auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::high_resolution_clock::now() - start).count();
+            return static_cast<size_t>(elapsed) >= budget.maxMicroseconds;
+        }
+        return false;
+        };
+
+    size_t patched = 0;
+    bool componentsAdded = false;
+
+    while (!pending.empty() && !outOfBudget(patched)) {
+        PendingPatch& patch = pending.front();
+        if (patch.scene != &scene) {
+            CollectInstances(patch, scene);
+        }
+
+        bool addsComponents = false;
+        for (const BlueprintDiff::ComponentChange& change : patch.diff.components) {
+            addsComponents = addsComponents || change.added;
+        }
+
+        while (patch.nextObject < patch.objectIds.size() && !outOfBudget(patched)) {
+            GameObject* gameObject = scene.FindGameObjectById(patch.objectIds[patch.nextObject++]);
+            if (gameObject && gameObject->GetTemplateId() == patch.diff.templateId) {
+                PatchObject(*gameObject, patch.diff);
+                componentsAdded = componentsAdded || addsComponents;
+                patched++;
+            }
+        }
+
+        if (patch.nextObject == patch.objectIds.size()) {
+            pending.pop_front();
+        }
+    }
+
+    // New components are not in the scene's batch caches yet
+    if (componentsAdded) {
+        scene.RefreshComponentCaches();
+    }
+
+    objectsPatched += patched;
+    return patched;
+}
+
+void TemplateHotReloader::CollectInstances(PendingPatch& patch, Scene& scene) {
+    patch.scene = &scene;
+    patch.objectIds.clear();
+    patch.nextObject = 0;
+
+    for (const auto& gameObject : scene.GetAllGameObjects()) {
+        if (gameObject && gameObject->GetTemplateId() == patch.diff.templateId) {
+            patch.objectIds.push_back(gameObject->GetId());
+        }
+    }
+}
+
+void TemplateHotReloader::PatchObject(GameObject& gameObject, const BlueprintDiff& diff) {
+    for (const BlueprintDiff::ComponentChange& change : diff.components) {
+        Component* component = gameObject.GetComponent(change.schema->GetTypeIndex());
+
+        if (!component) {
+            if (change.added && change.config) {
+                gameObject.AttachComponent(ComponentFactory::GetInstance().CreateComponent(change.componentId, *change.config));
+            }
+            else if (change.added) {
+                change.schema->EmplaceComponent(gameObject, change.image.data());
+            }
+            continue;
+        }
+
+        if (change.patches.empty()) continue;
+
+        // Read back the live values so fields the template did not change keep their state
+        scratchImage.assign(change.schema->GetImageWords(), 0);
+        change.schema->CaptureComponent(*component, scratchImage.data());
+        ComponentSchema::ApplyPatches(scratchImage.data(), change.patches);
+        change.schema->ApplyToComponent(*component, scratchImage.data());
+    }
+}
@@ -0,0 +1,469 @@
+#include "../include/factories/TemplateParser.h"
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+    bool IsSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    std::string_view TrimLeft(std::string_view text) {
+        size_t begin = 0;
+        while (begin < text.size() && IsSpace(text[begin])) begin++;
+        return text.substr(begin);
+    }
+
+    std::string_view TrimRight(std::string_view text) {
+        size_t end = text.size();
+        while (end > 0 && IsSpace(text[end - 1])) end--;
+        return text.substr(0, end);
+    }
+
+    std::string_view Trim(std::string_view text) {
+        return TrimRight(TrimLeft(text));
+    }
+
+    // from_chars rejects a leading '+', accept it like strtof does
+    std::string_view StripPlus(std::string_view text) {
+        return (text.size() > 1 && text[0] == '+') ? text.substr(1) : text;
+    }
+
+    bool ParseIntView(std::string_view text, int32_t& value) {
+        text = StripPlus(text);
+        const char* end = text.data() + text.size();
+        auto result = std::from_chars(text.data(), end, value);
+        return result.ec == std::errc() && result.ptr == end && !text.empty();
+    }
+
+    bool ParseFloatView(std::string_view text, float& value) {
+        text = StripPlus(text);
+        const char* end = text.data() + text.size();
+        auto result = std::from_chars(text.data(), end, value);
+        return result.ec == std::errc() && result.ptr == end && !text.empty();
+    }
+
+    bool ParseVectorView(std::string_view text, Vector3& value) {
+        float components[3];
+        for (size_t i = 0; i < 3; ++i) {
+            size_t comma = text.find(',');
+            if ((i < 2) == (comma == std::string_view::npos)) return false;
+
+            if (!ParseFloatView(Trim(text.substr(0, comma)), components[i])) return false;
+            text = comma == std::string_view::npos ? std::string_view() : text.substr(comma + 1);
+        }
+        value = Vector3(components[0], components[1], components[2]);
+        return true;
+    }
+
+    // 1-based column of a token that views into 'line'
+    size_t ColumnOf(std::string_view line, std::string_view token) {
+        return static_cast<size_t>(token.data() - line.data()) + 1;
+    }
+
+    // Binary encoding helpers: strings are a uint32 length plus bytes
+    void WriteBytes(std::vector<uint8_t>& bytes, const void* source, size_t count) {
+        const uint8_t* begin = static_cast<const uint8_t*>(source);
+        bytes.insert(bytes.end(), begin, begin + count);
+    }
+
+    template<typename T>
+    void WritePod(std::vector<uint8_t>& bytes, const T& value) {
+        WriteBytes(bytes, &value, sizeof(T));
+    }
+
+    void WriteString(std::vector<uint8_t>& bytes, const std::string& value) {
+        WritePod(bytes, static_cast<uint32_t>(value.size()));
+        WriteBytes(bytes, value.data(), value.size());
+    }
+
+    class ByteReader {
+    private:
+        const uint8_t* cursor;
+        const uint8_t* end;
+
+    public:
+        ByteReader(const uint8_t* data, size_t size) : cursor(data), end(data + size) {}
+
+        bool IsAtEnd() const { return cursor == end; }
+        size_t GetRemaining() const { return static_cast<size_t>(end - cursor); }
+
+        template<typename T>
+        bool ReadPod(T& value) {
+            if (static_cast<size_t>(end - cursor) < sizeof(T)) return false;
+            std::memcpy(&value, cursor, sizeof(T));
+            cursor += sizeof(T);
+            return true;
+        }
+
+        bool ReadString(std::string& value) {
+            uint32_t length;
+            if (!ReadPod(length) || static_cast<size_t>(end - cursor) < length) return false;
+            value.assign(reinterpret_cast<const char*>(cursor), length);
+            cursor += length;
+            return true;
+        }
+    };
+
+    void SetError(TemplateParseError* error, size_t column, const std::string& message) {
+        if (error) {
+            error->source = "<string>";
+            error->line = 1;
+            error->column = column;
+            error->message = message;
+        }
+    }
+}
+
+std::string TemplateParseError::ToString() const {
+    return source + ":" + std::to_string(line) + ":" + std::to_string(column) + ": " + message;
+}
+
+bool TemplateParser::NextLine(std::string_view& text, std::string_view& line) {
+    if (text.empty()) return false;
+
+    size_t end = text.find('\n');
+    if (end == std::string_view::npos) {
+        line = text;
+        text = std::string_view();
+    }
+    else {
+        line = text.substr(0, end);
+        text = text.substr(end + 1);
+    }
+
+    if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+    }
+    return true;
+}
+
+PropertyValue TemplateParser::ParseValue(std::string_view text) {
+    text = Trim(text);
+
+    if (text == "true") return PropertyValue::FromBool(true);
+    if (text == "false") return PropertyValue::FromBool(false);
+
+    int32_t intValue;
+    if (ParseIntView(text, intValue)) return PropertyValue::FromInt(intValue);
+
+    float floatValue;
+    if (ParseFloatView(text, floatValue)) return PropertyValue::FromFloat(floatValue);
+
+    Vector3 vectorValue;
+    if (text.find(',') != std::string_view::npos && ParseVectorView(text, vectorValue)) {
+        return PropertyValue::FromVector3(vectorValue);
+    }
+
+    return PropertyValue::FromString(std::string(text));
+}
+
+bool TemplateParser::ParseDocument(std::string_view text, std::vector<GameObjectTemplate>& templates,
+    std::vector<TemplateParseError>& errors, std::string_view sourceName) {
+    size_t errorCount = errors.size();
+    size_t lineNumber = 0;
+
+    // Index rather than pointer, 'templates' grows while parsing
+    size_t current = templates.size();
+    bool hasTemplate = false;
+    ComponentConfig* component = nullptr;
+
+    std::string_view rest = text;
+    std::string_view line;
+    while (NextLine(rest, line)) {
+        lineNumber++;
+
+        auto report = [&](std::string_view at, const std::string& message) {
+            errors.push_back({ std::string(sourceName), lineNumber, ColumnOf(line, at), message });
+            };
+
+        std::string_view content = TrimRight(TrimLeft(line));
+        if (content.empty() || content[0] == '#') continue;
+        bool indented = content.data() != line.data();
+
+        // Component entry: "- Type:Name"
+        if (content[0] == '-') {
+            std::string_view item = TrimLeft(content.substr(1));
+            size_t colon = item.find(':');
+            if (colon == std::string_view::npos || TrimRight(item.substr(0, colon)) != "Type") {
+                report(item, "Expected 'Type:<component>' after '-'");
+                continue;
+            }
+            std::string_view typeName = Trim(item.substr(colon + 1));
+            if (typeName.empty()) {
+                report(item, "Missing component type");
+                continue;
+            }
+            if (!hasTemplate) {
+                report(content, "Component outside of a template (missing Name:)");
+                continue;
+            }
+            templates[current].components.emplace_back(std::string(typeName));
+            component = &templates[current].components.back();
+            continue;
+        }
+
+        size_t colon = content.find(':');
+        if (colon == std::string_view::npos) {
+            report(content, "Expected 'key:value'");
+            continue;
+        }
+        std::string_view key = TrimRight(content.substr(0, colon));
+        std::string_view value = Trim(content.substr(colon + 1));
+        if (key.empty()) {
+            report(content, "Missing key before ':'");
+            continue;
+        }
+
+        // Indented lines under a component are its properties
+        if (indented && component) {
+            component->SetValue(std::string(key), ParseValue(value));
+            continue;
+        }
+
+        if (key == "Name") {
+            if (value.empty()) {
+                report(content, "Template name is empty");
+                hasTemplate = false;
+                component = nullptr;
+                continue;
+            }
+            templates.emplace_back(std::string(value));
+            current = templates.size() - 1;
+            hasTemplate = true;
+            component = nullptr;
+            continue;
+        }
+
+        if (!hasTemplate) {
+            report(key, "'" + std::string(key) + "' before the template's Name:");
+            continue;
+        }
+
+        GameObjectTemplate& gameObjectTemplate = templates[current];
+        if (key == "Tag") {
+            gameObjectTemplate.tag = std::string(value);
+        }
+        else if (key == "Active") {
+            if (value == "true" || value == "false") {
+                gameObjectTemplate.active = value == "true";
+            }
+            else {
+                report(value.empty() ? key : value, "Active must be 'true' or 'false'");
+            }
+        }
+        else if (key == "Components") {
+            component = nullptr;
+        }
+        else {
+            report(key, "Unknown template key '" + std::string(key) + "'");
+        }
+    }
+
+    return errors.size() == errorCount;
+}
+
+bool TemplateParser::ParseTemplateLine(std::string_view line, GameObjectTemplate& gameObjectTemplate,
+    TemplateParseError* error) {
+    size_t nameEnd = line.find(':');
+    std::string_view name = Trim(line.substr(0, nameEnd));
+    if (name.empty()) {
+        SetError(error, 1, "Template name is empty");
+        return false;
+    }
+
+    std::string_view tag;
+    std::string_view components;
+    if (nameEnd != std::string_view::npos) {
+        std::string_view rest = line.substr(nameEnd + 1);
+        size_t tagEnd = rest.find(':');
+        tag = Trim(rest.substr(0, tagEnd));
+        if (tagEnd != std::string_view::npos) {
+            components = rest.substr(tagEnd + 1);
+        }
+    }
+
+    gameObjectTemplate = GameObjectTemplate(std::string(name), std::string(tag));
+
+    while (!components.empty()) {
+        size_t comma = components.find(',');
+        std::string_view typeName = Trim(components.substr(0, comma));
+        if (!typeName.empty()) {
+            gameObjectTemplate.AddComponent(std::string(typeName));
+        }
+        components = comma == std::string_view::npos ? std::string_view() : components.substr(comma + 1);
+    }
+
+    return true;
+}
+
+bool TemplateParser::ParseComponentString(std::string_view text, ComponentConfig& config,
+    TemplateParseError* error) {
+    size_t typeEnd = text.find(':');
+    std::string_view typeName = Trim(text.substr(0, typeEnd));
+    if (typeName.empty()) {
+        SetError(error, 1, "Missing component type");
+        return false;
+    }
+
+    config = ComponentConfig(std::string(typeName));
+    if (typeEnd == std::string_view::npos) {
+        return true;
+    }
+
+    // Split on commas; a segment without '=' continues the previous value
+    // (so "scale=1,2,3" stays one vector)
+    std::string_view properties = text.substr(typeEnd + 1);
+    std::string_view key;
+    const char* valueBegin = nullptr;
+    const char* valueEnd = nullptr;
+
+    auto flush = [&]() {
+        if (valueBegin) {
+            config.SetValue(std::string(key), ParseValue(std::string_view(valueBegin, valueEnd - valueBegin)));
+        }
+        };
+
+    while (!properties.empty()) {
+        size_t comma = properties.find(',');
+        std::string_view segment = properties.substr(0, comma);
+        size_t equals = segment.find('=');
+
+        if (equals != std::string_view::npos) {
+            flush();
+            key = Trim(segment.substr(0, equals));
+            if (key.empty()) {
+                SetError(error, ColumnOf(text, segment), "Missing property name before '='");
+                return false;
+            }
+            valueBegin = segment.data() + equals + 1;
+            valueEnd = segment.data() + segment.size();
+        }
+        else if (valueBegin) {
+            valueEnd = segment.data() + segment.size();
+        }
+        else if (!Trim(segment).empty()) {
+            SetError(error, ColumnOf(text, segment), "Expected 'property=value'");
+            return false;
+        }
+
+        properties = comma == std::string_view::npos ? std::string_view() : properties.substr(comma + 1);
+    }
+    flush();
+
+    return true;
+}
+
+void TemplateParser::EncodeTemplates(const std::vector<GameObjectTemplate>& templates, std::vector<uint8_t>& bytes) {
+    WritePod(bytes, static_cast<uint32_t>(templates.size()));
+    for (const GameObjectTemplate& gameObjectTemplate : templates) {
+        WriteString(bytes, gameObjectTemplate.name);
+        WriteString(bytes, gameObjectTemplate.tag);
+        WritePod(bytes, static_cast<uint8_t>(gameObjectTemplate.active ? 1 : 0));
+
+        WritePod(bytes, static_cast<uint32_t>(gameObjectTemplate.components.size()));
+        for (const ComponentConfig& config : gameObjectTemplate.components) {
+            WriteString(bytes, config.typeName);
+
+            WritePod(bytes, static_cast<uint32_t>(config.properties.size()));
+            for (const auto& property : config.properties) {
+                const PropertyValue& value = property.second;
+                WriteString(bytes, property.first);
+                WritePod(bytes, static_cast<uint8_t>(value.type));
+
+                switch (value.type) {
+                case FieldType::Bool:    WritePod(bytes, static_cast<uint8_t>(value.boolValue ? 1 : 0)); break;
+                case FieldType::Int:     WritePod(bytes, value.intValue); break;
+                case FieldType::Float:   WritePod(bytes, value.floatValue); break;
+                case FieldType::Vector3: WriteBytes(bytes, value.vectorValue, sizeof(value.vectorValue)); break;
+                case FieldType::String:  WriteString(bytes, value.stringValue); break;
+                }
+            }
+        }
+    }
+}
+
+bool TemplateParser::DecodeTemplates(const uint8_t* data, size_t size, std::vector<GameObjectTemplate>& templates) {
+    ByteReader reader(data, size);
+    size_t firstTemplate = templates.size();
+
+    auto fail = [&]() {
+        templates.resize(firstTemplate);
+        return false;
+        };
+
+    // Smallest encodings (empty strings, a bool value), to reject corrupt
+    // counts before anything is sized from them
+    const size_t minComponentBytes = sizeof(uint32_t) + sizeof(uint32_t);
+    const size_t minPropertyBytes = sizeof(uint32_t) + sizeof(uint8_t) + sizeof(uint8_t);
+
+    uint32_t templateCount;
+    if (!reader.ReadPod(templateCount)) return fail();
+
+    for (uint32_t t = 0; t < templateCount; ++t) {
+        GameObjectTemplate& gameObjectTemplate = templates.emplace_back();
+        uint8_t active;
+        uint32_t componentCount;
+        if (!reader.ReadString(gameObjectTemplate.name) || !reader.ReadString(gameObjectTemplate.tag) ||
+            !reader.ReadPod(active) || !reader.ReadPod(componentCount) ||
+            componentCount > reader.GetRemaining() / minComponentBytes) {
+            return fail();
+        }
+        gameObjectTemplate.active = active != 0;
+
+        for (uint32_t c = 0; c < componentCount; ++c) {
+            ComponentConfig& config = gameObjectTemplate.components.emplace_back();
+            uint32_t propertyCount;
+            if (!reader.ReadString(config.typeName) || !reader.ReadPod(propertyCount) ||
+                propertyCount > reader.GetRemaining() / minPropertyBytes) {
+                return fail();
+            }
+
+            config.properties.reserve(propertyCount);
+            for (uint32_t p = 0; p < propertyCount; ++p) {
+                std::string key;
+                uint8_t type;
+                if (!reader.ReadString(key) || !reader.ReadPod(type)) return fail();
+
+                PropertyValue value;
+                bool read = false;
+                switch (static_cast<FieldType>(type)) {
+                case FieldType::Bool: {
+                    uint8_t boolValue;
+                    read = reader.ReadPod(boolValue);
+                    value = PropertyValue::FromBool(boolValue != 0);
+                    break;
+                }
+                case FieldType::Int: {
+                    int32_t intValue;
+                    read = reader.ReadPod(intValue);
+                    value = PropertyValue::FromInt(intValue);
+                    break;
+                }
+                case FieldType::Float: {
+                    float floatValue;
+                    read = reader.ReadPod(floatValue);
+                    value = PropertyValue::FromFloat(floatValue);
+                    break;
+                }
+                case FieldType::Vector3: {
+                    float vectorValue[3];
+                    read = reader.ReadPod(vectorValue);
+                    value = PropertyValue::FromVector3(Vector3(vectorValue[0], vectorValue[1], vectorValue[2]));
+                    break;
+                }
+                case FieldType::String: {
+                    std::string stringValue;
+                    read = reader.ReadString(stringValue);
+                    value = PropertyValue::FromString(stringValue);
+                    break;
+                }
+                }
+                if (!read) return fail();
+                config.properties.emplace(std::move(key), std::move(value));
+            }
+        }
+    }
+
+    return reader.IsAtEnd() ? true : fail();
+}
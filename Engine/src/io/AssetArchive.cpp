@@ -0,0 +1,356 @@
+#include "../include/io/AssetArchive.h"
+#include "../include/io/BlockCompression.h"
+#include "../include/io/ParseCache.h"
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <limits>
+#include <cstring>
+
+namespace {
+    constexpr char ArchiveMagic[4] = { 'G', 'P', 'A', 'K' };
+
+    // Compressed blobs must save at least 1/8 to be worth the decode
+    bool WorthCompressing(size_t compressedSize, size_t size) {
+        return compressedSize < size - size / 8;
+    }
+
+    // Largest original size a compressed blob of 'storedSize' bytes can
+    // claim: a block expands each input byte to at most 255 output bytes and
+    // never holds more than MaxBlockSize
+    uint64_t MaxDecompressedSize(uint64_t storedSize) {
+        uint64_t limit = BlockCompression::MaxBlockSize;
+        return storedSize >= limit / 255 ? limit : std::min(storedSize * 255, limit);
+    }
+
+    size_t AlignUp(size_t value, size_t alignment) {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    // Index order: by hash, equal hashes by path
+    bool EntryLess(uint64_t hash, std::string_view path, uint64_t otherHash, std::string_view otherPath) {
+        return hash != otherHash ? hash < otherHash : path < otherPath;
+    }
+}
+
+// AssetArchive
+bool AssetArchive::Open(const std::string& filepath) {
+    Close();
+
+    if (!file.Open(filepath)) {
+        std::cerr << "Failed to open asset archive: " << filepath << std::endl;
+        return false;
+    }
+
+    const uint8_t* data = file.GetData();
+    size_t size = file.GetSize();
+    const ArchiveHeader* header = reinterpret_cast<const ArchiveHeader*>(data);
+
+    bool valid = size >= sizeof(ArchiveHeader) &&
+        std::memcmp(header->magic, ArchiveMagic, sizeof(ArchiveMagic)) == 0 &&
+        header->formatVersion == FormatVersion &&
+        header->fileSize == size &&
+        header->entryCount <= (size - sizeof(ArchiveHeader)) / sizeof(ArchiveEntry) &&
+        header->pathsOffset == sizeof(ArchiveHeader) + header->entryCount * sizeof(ArchiveEntry) &&
+        header->pathsSize <= size - header->pathsOffset &&
+        header->dataOffset >= header->pathsOffset + header->pathsSize &&
+        header->dataOffset <= size;
+
+    if (valid) {
+        const ArchiveEntry* index = reinterpret_cast<const ArchiveEntry*>(data + sizeof(ArchiveHeader));
+        for (size_t i = 0; valid && i < header->entryCount; ++i) {
+            const ArchiveEntry& entry = index[i];
+            valid = static_cast<uint64_t>(entry.pathOffset) + entry.pathLength <= header->pathsSize &&
+                entry.offset >= header->dataOffset && entry.offset <= size &&
+                entry.storedSize <= size - entry.offset &&
+                entry.compression <= ArchiveEntry::Block &&
+                (entry.compression != ArchiveEntry::Stored || entry.storedSize == entry.size) &&
+                (entry.compression != ArchiveEntry::Block || entry.size <= MaxDecompressedSize(entry.storedSize));
+        }
+    }
+
+    if (!valid) {
+        std::cerr << "Invalid asset archive: " << filepath << std::endl;
+        file.Close();
+        return false;
+    }
+
+    archivePath = filepath;
+    entries = reinterpret_cast<const ArchiveEntry*>(data + sizeof(ArchiveHeader));
+    entryCount = static_cast<size_t>(header->entryCount);
+    paths = reinterpret_cast<const char*>(data + header->pathsOffset);
+    return true;
+}
+
+void AssetArchive::Close() {
+    file.Close();
+    archivePath.clear();
+    entries = nullptr;
+    entryCount = 0;
+    paths = nullptr;
+}
+
+const ArchiveEntry* AssetArchive::Find(std::string_view path) const {
+    uint64_t hash = HashPath(path);
+    const ArchiveEntry* end = entries + entryCount;
+    const ArchiveEntry* it = std::lower_bound(entries, end, hash,
+        [this, path](const ArchiveEntry& entry, uint64_t value) {
+            return EntryLess(entry.pathHash, GetEntryPath(entry), value, path);
+        });
+
+    if (it != end && it->pathHash == hash && GetEntryPath(*it) == path) {
+        return it;
+    }
+    return nullptr;
+}
+
+std::string_view AssetArchive::GetStoredData(const ArchiveEntry& entry) const {
+    return std::string_view(reinterpret_cast<const char*>(file.GetData() + entry.offset),
+        static_cast<size_t>(entry.storedSize));
+}
+
+std::string_view AssetArchive::GetEntryPath(const ArchiveEntry& entry) const {
+    return std::string_view(paths + entry.pathOffset, entry.pathLength);
+}
+
+bool AssetArchive::GetContents(std::string_view path, std::string_view& contents, std::vector<uint8_t>& scratch) const {
+    const ArchiveEntry* entry = Find(path);
+    return entry && GetContents(*entry, contents, scratch);
+}
+
+bool AssetArchive::GetContents(const ArchiveEntry& entry, std::string_view& contents, std::vector<uint8_t>& scratch) const {
+    std::string_view stored = GetStoredData(entry);
+    if (entry.compression == ArchiveEntry::Stored) {
+        contents = stored;
+        return true;
+    }
+
+    scratch.resize(static_cast<size_t>(entry.size));
+    if (!BlockCompression::Decompress(reinterpret_cast<const uint8_t*>(stored.data()), stored.size(),
+        scratch.data(), scratch.size())) {
+        std::cerr << "Corrupt entry " << GetEntryPath(entry) << " in " << archivePath << std::endl;
+        return false;
+    }
+    contents = std::string_view(reinterpret_cast<const char*>(scratch.data()), scratch.size());
+    return true;
+}
+
+std::vector<const ArchiveEntry*> AssetArchive::FindByExtension(std::string_view extension) const {
+    std::vector<const ArchiveEntry*> found;
+    for (size_t i = 0; i < entryCount; ++i) {
+        std::string_view path = GetEntryPath(entries[i]);
+        if (path.size() >= extension.size() && path.substr(path.size() - extension.size()) == extension) {
+            found.push_back(&entries[i]);
+        }
+    }
+
+    std::sort(found.begin(), found.end(), [this](const ArchiveEntry* a, const ArchiveEntry* b) {
+        return GetEntryPath(*a) < GetEntryPath(*b);
+        });
+    return found;
+}
+
+uint64_t AssetArchive::HashPath(std::string_view path) {
+    return ParseCache::HashBytes(path.data(), path.size());
+}
+
+// AssetArchiveBuilder
+bool AssetArchiveBuilder::AddData(const std::string& path, std::vector<uint8_t> data, bool compress) {
+    std::string normalized = NormalizePath(path);
+    if (normalized.empty() || normalized.size() > std::numeric_limits<uint16_t>::max()) {
+        std::cerr << "Invalid archive path: " << path << std::endl;
+        return false;
+    }
+
+    auto [it, inserted] = pathIndices.emplace(normalized, pending.size());
+    if (!inserted) {
+        pending[it->second].data = std::move(data);
+        pending[it->second].compress = compress;
+        return true;
+    }
+
+    PendingEntry entry;
+    entry.path = std::move(normalized);
+    entry.data = std::move(data);
+    entry.compress = compress;
+    pending.push_back(std::move(entry));
+    return true;
+}
+
+bool AssetArchiveBuilder::AddFile(const std::string& path, const std::string& sourcePath, bool compress) {
+    std::vector<uint8_t> data;
+    std::error_code error;
+    if (std::filesystem::file_size(sourcePath, error) > 0 && !error) {
+        MappedFile source;
+        if (!source.Open(sourcePath)) {
+            return false;
+        }
+        data.assign(source.GetData(), source.GetData() + source.GetSize());
+    }
+    else if (error) {
+        std::cerr << "Failed to read " << sourcePath << ": " << error.message() << std::endl;
+        return false;
+    }
+
+    return AddData(path, std::move(data), compress);
+}
+
+size_t AssetArchiveBuilder::AddDirectory(const std::string& directory, const std::string& prefix,
+    const std::string& extension, bool compress) {
+    namespace fs = std::filesystem;
+
+    std::vector<fs::path> files;
+    std::error_code error;
+    fs::recursive_directory_iterator it(directory, fs::directory_options::skip_permission_denied, error);
+    for (const fs::recursive_directory_iterator end; !error && it != end; it.increment(error)) {
+        std::error_code typeError;
+        if (it->is_regular_file(typeError) && (extension.empty() || it->path().extension() == extension)) {
+            files.push_back(it->path());
+        }
+    }
+    if (error) {
+        std::cerr << "Failed to read directory " << directory << ": " << error.message() << std::endl;
+    }
+    std::sort(files.begin(), files.end());
+
+    size_t added = 0;
+    for (const fs::path& file : files) {
+        std::string relative = file.lexically_relative(directory).generic_string();
+        if (AddFile(prefix + relative, file.string(), compress)) {
+            added++;
+        }
+    }
+    return added;
+}
+
+void AssetArchiveBuilder::Clear() {
+    pending.clear();
+    pathIndices.clear();
+}
+
+bool AssetArchiveBuilder::Write(const std::string& filepath) {
+    bytesIn = 0;
+    bytesStored = 0;
+    entriesCompressed = 0;
+
+    // Compress where requested and worthwhile
+    std::vector<std::vector<uint8_t>> compressed(pending.size());
+    for (size_t i = 0; i < pending.size(); ++i) {
+        const PendingEntry& source = pending[i];
+        bytesIn += source.data.size();
+        if (!source.compress || source.data.empty()) continue;
+
+        std::vector<uint8_t>& block = compressed[i];
+        block.resize(BlockCompression::GetMaxCompressedSize(source.data.size()));
+        size_t blockSize = BlockCompression::Compress(source.data.data(), source.data.size(), block.data(), block.size());
+        if (blockSize == 0 || !WorthCompressing(blockSize, source.data.size())) {
+            block.clear();
+            continue;
+        }
+        block.resize(blockSize);
+        entriesCompressed++;
+    }
+
+    // Index order
+    std::vector<size_t> order(pending.size());
+    std::vector<uint64_t> hashes(pending.size());
+    for (size_t i = 0; i < pending.size(); ++i) {
+        order[i] = i;
+        hashes[i] = AssetArchive::HashPath(pending[i].path);
+    }
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return EntryLess(hashes[a], pending[a].path, hashes[b], pending[b].path);
+        });
+
+    // Lay out paths and blobs
+    ArchiveHeader header = {};
+    std::memcpy(header.magic, ArchiveMagic, sizeof(ArchiveMagic));
+    header.formatVersion = AssetArchive::FormatVersion;
+    header.entryCount = pending.size();
+    header.pathsOffset = sizeof(ArchiveHeader) + pending.size() * sizeof(ArchiveEntry);
+
+    std::vector<ArchiveEntry> index(pending.size());
+    std::string pathData;
+    for (size_t slot = 0; slot < order.size(); ++slot) {
+        const PendingEntry& source = pending[order[slot]];
+        ArchiveEntry& entry = index[slot];
+        entry.pathHash = hashes[order[slot]];
+        entry.pathOffset = static_cast<uint32_t>(pathData.size());
+        entry.pathLength = static_cast<uint16_t>(source.path.size());
+        pathData += source.path;
+    }
+    if (pathData.size() > std::numeric_limits<uint32_t>::max()) {
+        std::cerr << "Too many archive paths for " << filepath << std::endl;
+        return false;
+    }
+    header.pathsSize = pathData.size();
+    header.dataOffset = AlignUp(static_cast<size_t>(header.pathsOffset + header.pathsSize), AssetArchive::BlobAlignment);
+
+    uint64_t offset = header.dataOffset;
+    for (size_t slot = 0; slot < order.size(); ++slot) {
+        size_t i = order[slot];
+        ArchiveEntry& entry = index[slot];
+        bool isCompressed = !compressed[i].empty();
+        entry.compression = isCompressed ? ArchiveEntry::Block : ArchiveEntry::Stored;
+        entry.size = pending[i].data.size();
+        entry.storedSize = isCompressed ? compressed[i].size() : pending[i].data.size();
+        entry.offset = offset;
+        offset = AlignUp(static_cast<size_t>(offset + entry.storedSize), AssetArchive::BlobAlignment);
+        bytesStored += static_cast<size_t>(entry.storedSize);
+    }
+    header.fileSize = offset;
+
+    std::string tempPath = filepath + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            std::cerr << "Failed to write asset archive: " << tempPath << std::endl;
+            return false;
+        }
+
+        static const char padding[AssetArchive::BlobAlignment] = {};
+        uint64_t written = 0;
+        auto write = [&](const void* data, size_t size) {
+            out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+            written += size;
+            };
+        auto pad = [&](uint64_t target) {
+            write(padding, static_cast<size_t>(target - written));
+            };
+
+        write(&header, sizeof(header));
+        write(index.data(), index.size() * sizeof(ArchiveEntry));
+        write(pathData.data(), pathData.size());
+        for (size_t slot = 0; slot < order.size(); ++slot) {
+            size_t i = order[slot];
+            pad(index[slot].offset);
+            const std::vector<uint8_t>& blob = compressed[i].empty() ? pending[i].data : compressed[i];
+            write(blob.data(), blob.size());
+        }
+        pad(header.fileSize);
+
+        if (!out.good()) {
+            std::cerr << "Failed to write asset archive: " << tempPath << std::endl;
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, filepath, error);
+    if (error) {
+        std::cerr << "Failed to replace " << filepath << ": " << error.message() << std::endl;
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+    return true;
+}
+
+std::string AssetArchiveBuilder::NormalizePath(const std::string& path) {
+    std::string normalized = std::filesystem::path(path).lexically_normal().generic_string();
+    while (normalized.compare(0, 2, "./") == 0) {
+        normalized.erase(0, 2);
+    }
+    size_t start = normalized.find_first_not_of('/');
+    return start == std::string::npos ? std::string() : normalized.substr(start);
+}
@@ -0,0 +1,372 @@
+#include "../include/io/BlockCompression.h"
+#include "../include/systems/ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace {
+    constexpr size_t MinMatch = 4;
+    constexpr size_t LastLiterals = 5;          // Always emitted as literals
+    constexpr size_t MatchStartLimit = 12;      // No match starts in the last 12 bytes
+    constexpr size_t MaxOffset = 65535;
+    constexpr int HashBits = 12;
+    constexpr int SkipTrigger = 6;              // Search step grows after 2^6 misses
+
+    uint32_t Read32(const uint8_t* bytes) {
+        uint32_t value;
+        std::memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+
+    uint64_t Read64(const uint8_t* bytes) {
+        uint64_t value;
+        std::memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+
+    uint32_t HashSequence(uint32_t sequence) {
+        return (sequence * 2654435761u) >> (32 - HashBits);
+    }
+
+    // Number of equal bytes at 'position' and 'reference', stopping at 'limit'
+    size_t CountMatch(const uint8_t* position, const uint8_t* reference, const uint8_t* limit) {
+        const uint8_t* start = position;
+        while (position + sizeof(uint64_t) <= limit) {
+            if (Read64(position) != Read64(reference)) break;
+            position += sizeof(uint64_t);
+            reference += sizeof(uint64_t);
+        }
+        while (position < limit && *position == *reference) {
+            ++position;
+            ++reference;
+        }
+        return static_cast<size_t>(position - start);
+    }
+
+    uint8_t* WriteLength(uint8_t* out, size_t length) {
+        while (length >= 255) {
+            *out++ = 255;
+            length -= 255;
+        }
+        *out++ = static_cast<uint8_t>(length);
+        return out;
+    }
+
+    uint8_t* WriteLiterals(uint8_t* out, uint8_t* token, const uint8_t* literals, size_t length) {
+        if (length >= 15) {
+            *token = 15 << 4;
+            out = WriteLength(out, length - 15);
+        }
+        else {
+            *token = static_cast<uint8_t>(length << 4);
+        }
+        if (length > 0) {
+            std::memcpy(out, literals, length);
+        }
+        return out + length;
+    }
+
+    constexpr char FrameMagic[4] = { 'L', 'Z', 'F', 'R' };
+    constexpr uint32_t RawBlockFlag = 0x80000000u;   // Set in a stored size: block kept uncompressed
+
+    struct FrameHeader {
+        char magic[4];
+        uint32_t blockSize;
+        uint64_t contentSize;
+        uint64_t blockCount;
+    };
+
+    static_assert(sizeof(FrameHeader) == 24, "FrameHeader layout changed");
+
+    // A couple of block ranges per thread (the caller's included) evens out
+    // blocks that compress at different speeds
+    size_t GetChunkCount(ThreadPool* pool) {
+        return pool ? (pool->GetThreadCount() + 1) * 2 : 1;
+    }
+
+    // Continuation bytes of a length whose nibble was 15
+    bool ReadLength(const uint8_t*& in, const uint8_t* inEnd, size_t& length) {
+        uint8_t value;
+        do {
+            if (in >= inEnd) return false;
+            value = *in++;
+            length += value;
+        } while (value == 255);
+        return true;
+    }
+}
+
+size_t BlockCompression::Compress(const uint8_t* source, size_t sourceSize,
+    uint8_t* destination, size_t destinationCapacity) {
+    if (sourceSize > MaxBlockSize || destinationCapacity < GetMaxCompressedSize(sourceSize)) {
+        return 0;
+    }
+
+    const uint8_t* anchor = source;
+    const uint8_t* end = source + sourceSize;
+    uint8_t* out = destination;
+
+    if (sourceSize > MatchStartLimit) {
+        const uint8_t* matchLimit = end - LastLiterals;
+        const uint8_t* searchEnd = end - MatchStartLimit;
+
+        // Last position (relative to source) each 4-byte hash was seen at
+        uint32_t table[1 << HashBits] = {};
+        const uint8_t* position = source + 1;
+
+        while (position < searchEnd) {
+            // Find the next match; the step widens through incompressible data
+            const uint8_t* match = nullptr;
+            size_t attempts = size_t(1) << SkipTrigger;
+            while (position < searchEnd) {
+                uint32_t sequence = Read32(position);
+                uint32_t hash = HashSequence(sequence);
+                const uint8_t* candidate = source + table[hash];
+                table[hash] = static_cast<uint32_t>(position - source);
+                if (static_cast<size_t>(position - candidate) - 1 < MaxOffset && Read32(candidate) == sequence) {
+                    match = candidate;
+                    break;
+                }
+                position += attempts++ >> SkipTrigger;
+            }
+            if (!match) break;
+
+            // Grow the match backwards over pending literals
+            while (position > anchor && match > source && position[-1] == match[-1]) {
+                --position;
+                --match;
+            }
+
+            size_t matchLength = MinMatch + CountMatch(position + MinMatch, match + MinMatch, matchLimit);
+            uint8_t* token = out++;
+            out = WriteLiterals(out, token, anchor, static_cast<size_t>(position - anchor));
+
+            size_t offset = static_cast<size_t>(position - match);
+            out[0] = static_cast<uint8_t>(offset);
+            out[1] = static_cast<uint8_t>(offset >> 8);
+            out += 2;
+
+            if (matchLength - MinMatch >= 15) {
+                *token |= 15;
+                out = WriteLength(out, matchLength - MinMatch - 15);
+            }
+            else {
+                *token |= static_cast<uint8_t>(matchLength - MinMatch);
+            }
+
+            position += matchLength;
+            anchor = position;
+
+            // Index inside the match so the next search finds nearby repeats
+            if (position < searchEnd) {
+                table[HashSequence(Read32(position - 2))] = static_cast<uint32_t>(position - 2 - source);
+            }
+        }
+    }
+
+    uint8_t* token = out++;
+    out = WriteLiterals(out, token, anchor, static_cast<size_t>(end - anchor));
+    return static_cast<size_t>(out - destination);
+}
+
+bool BlockCompression::Decompress(const uint8_t* source, size_t sourceSize,
+    uint8_t* destination, size_t destinationSize) {
+    const uint8_t* in = source;
+    const uint8_t* inEnd = source + sourceSize;
+    uint8_t* out = destination;
+    uint8_t* outEnd = destination + destinationSize;
+
+    while (in < inEnd) {
+        unsigned token = *in++;
+
+        // Literals
+        size_t literalLength = token >> 4;
+        if (literalLength == 15 && !ReadLength(in, inEnd, literalLength)) {
+            return false;
+        }
+        if (literalLength > static_cast<size_t>(inEnd - in) || literalLength > static_cast<size_t>(outEnd - out)) {
+            return false;
+        }
+        if (literalLength <= 16 && inEnd - in >= 16 && outEnd - out >= 16) {
+            std::memcpy(out, in, 16);
+        }
+        else {
+            std::memcpy(out, in, literalLength);
+        }
+        in += literalLength;
+        out += literalLength;
+
+        // The last sequence has no match
+        if (in == inEnd) {
+            return out == outEnd;
+        }
+
+        // Match
+        if (inEnd - in < 2) return false;
+        size_t offset = static_cast<size_t>(in[0]) | (static_cast<size_t>(in[1]) << 8);
+        in += 2;
+        if (offset == 0 || offset > static_cast<size_t>(out - destination)) {
+            return false;
+        }
+
+        size_t matchLength = token & 15;
+        if (matchLength == 15 && !ReadLength(in, inEnd, matchLength)) {
+            return false;
+        }
+        matchLength += MinMatch;
+        if (matchLength > static_cast<size_t>(outEnd - out)) {
+            return false;
+        }
+
+        const uint8_t* match = out - offset;
+        uint8_t* matchEnd = out + matchLength;
+
+        if (static_cast<size_t>(outEnd - matchEnd) < sizeof(uint64_t)) {
+            // Near the end of the block: no room for wide copies
+            while (out < matchEnd) {
+                *out++ = *match++;
+            }
+            continue;
+        }
+
+        if (offset < sizeof(uint64_t)) {
+            // Short period: lay down the first 8 bytes one at a time, then copy
+            // from a whole number of periods back, which is at least 8 bytes away
+            for (size_t i = 0; i < sizeof(uint64_t); ++i) {
+                out[i] = match[i];
+            }
+            size_t period = offset * ((sizeof(uint64_t) + offset - 1) / offset);
+            out += sizeof(uint64_t);
+            match = out - period;
+        }
+
+        // 8 bytes at a time; may write up to 7 bytes past the match, which the
+        // next sequence overwrites
+        while (out < matchEnd) {
+            std::memcpy(out, match, sizeof(uint64_t));
+            out += sizeof(uint64_t);
+            match += sizeof(uint64_t);
+        }
+        out = matchEnd;
+    }
+
+    return false;
+}
+
+void BlockCompression::CompressFrame(const uint8_t* source, size_t sourceSize, std::vector<uint8_t>& frame,
+    ThreadPool* pool, size_t blockSize) {
+    blockSize = std::min(std::max(blockSize, static_cast<size_t>(1024)), MaxBlockSize);
+    size_t blockCount = (sourceSize + blockSize - 1) / blockSize;
+    size_t blockBound = GetMaxCompressedSize(blockSize);
+
+    // Compress each block into its own slot, then pack the slots
+    std::vector<uint8_t> scratch(blockCount * blockBound);
+    std::vector<uint32_t> storedSizes(blockCount);
+
+    ParallelFor(pool, blockCount, GetChunkCount(pool), [&](size_t begin, size_t end) {
+        for (size_t b = begin; b < end; ++b) {
+            const uint8_t* block = source + b * blockSize;
+            size_t length = std::min(blockSize, sourceSize - b * blockSize);
+            uint8_t* slot = scratch.data() + b * blockBound;
+
+            size_t compressedSize = Compress(block, length, slot, blockBound);
+            if (compressedSize == 0 || compressedSize >= length) {
+                std::memcpy(slot, block, length);
+                storedSizes[b] = static_cast<uint32_t>(length) | RawBlockFlag;
+            }
+            else {
+                storedSizes[b] = static_cast<uint32_t>(compressedSize);
+            }
+        }
+        });
+
+    FrameHeader header = {};
+    std::memcpy(header.magic, FrameMagic, sizeof(FrameMagic));
+    header.blockSize = static_cast<uint32_t>(blockSize);
+    header.contentSize = sourceSize;
+    header.blockCount = blockCount;
+
+    size_t frameSize = sizeof(FrameHeader) + blockCount * sizeof(uint32_t);
+    for (uint32_t storedSize : storedSizes) {
+        frameSize += storedSize & ~RawBlockFlag;
+    }
+
+    frame.resize(frameSize);
+    uint8_t* out = frame.data();
+    std::memcpy(out, &header, sizeof(header));
+    out += sizeof(header);
+    if (blockCount > 0) {
+        std::memcpy(out, storedSizes.data(), blockCount * sizeof(uint32_t));
+        out += blockCount * sizeof(uint32_t);
+    }
+    for (size_t b = 0; b < blockCount; ++b) {
+        size_t length = storedSizes[b] & ~RawBlockFlag;
+        std::memcpy(out, scratch.data() + b * blockBound, length);
+        out += length;
+    }
+}
+
+bool BlockCompression::DecompressFrame(const uint8_t* frame, size_t frameSize, std::vector<uint8_t>& content,
+    ThreadPool* pool) {
+    if (!IsFrame(frame, frameSize)) {
+        return false;
+    }
+
+    FrameHeader header;
+    std::memcpy(&header, frame, sizeof(header));
+    if (header.blockSize == 0 || header.blockSize > MaxBlockSize ||
+        header.blockCount != (header.contentSize + header.blockSize - 1) / header.blockSize ||
+        header.blockCount > (frameSize - sizeof(FrameHeader)) / sizeof(uint32_t)) {
+        return false;
+    }
+
+    size_t blockCount = static_cast<size_t>(header.blockCount);
+    size_t blockSize = header.blockSize;
+    std::vector<uint32_t> storedSizes(blockCount);
+    if (blockCount > 0) {
+        std::memcpy(storedSizes.data(), frame + sizeof(FrameHeader), blockCount * sizeof(uint32_t));
+    }
+
+    // Block offsets, checked against the frame before any work is handed out
+    std::vector<size_t> offsets(blockCount);
+    size_t offset = sizeof(FrameHeader) + blockCount * sizeof(uint32_t);
+    for (size_t b = 0; b < blockCount; ++b) {
+        size_t length = storedSizes[b] & ~RawBlockFlag;
+        if (length > frameSize - offset) return false;
+        offsets[b] = offset;
+        offset += length;
+    }
+
+    content.resize(static_cast<size_t>(header.contentSize));
+    std::atomic<bool> failed{ false };
+
+    ParallelFor(pool, blockCount, GetChunkCount(pool), [&](size_t begin, size_t end) {
+        for (size_t b = begin; b < end && !failed.load(std::memory_order_relaxed); ++b) {
+            size_t length = std::min(blockSize, content.size() - b * blockSize);
+            uint8_t* destination = content.data() + b * blockSize;
+            const uint8_t* block = frame + offsets[b];
+            size_t storedSize = storedSizes[b] & ~RawBlockFlag;
+
+            bool decoded = false;
+            if (storedSizes[b] & RawBlockFlag) {
+                decoded = storedSize == length;
+                if (decoded) {
+                    std::memcpy(destination, block, length);
+                }
+            }
+            else {
+                decoded = Decompress(block, storedSize, destination, length);
+            }
+
+            if (!decoded) {
+                failed.store(true, std::memory_order_relaxed);
+            }
+        }
+        });
+
+    return !failed.load();
+}
+
+bool BlockCompression::IsFrame(const uint8_t* data, size_t size) {
+    return data && size >= sizeof(FrameHeader) && std::memcmp(data, FrameMagic, sizeof(FrameMagic)) == 0;
+}
@@ -0,0 +1,194 @@
+#include "../include/io/FileWatcher.h"
+#include <iostream>
+#include <filesystem>
+#include <unordered_set>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace {
+    // Every regular file below 'directory'
+    void ListFiles(const std::string& directory, std::vector<std::string>& files) {
+        std::error_code error;
+        std::filesystem::recursive_directory_iterator it(directory,
+            std::filesystem::directory_options::skip_permission_denied, error);
+        for (const std::filesystem::recursive_directory_iterator end; !error && it != end; it.increment(error)) {
+            std::error_code typeError;
+            if (it->is_regular_file(typeError)) {
+                files.push_back(it->path().generic_string());
+            }
+        }
+    }
+}
+
+FileWatcher::~FileWatcher() {
+    Close();
+}
+
+bool FileWatcher::Watch(const std::string& directory) {
+    std::error_code error;
+    if (!std::filesystem::is_directory(directory, error)) {
+        std::cerr << "Cannot watch missing directory: " << directory << std::endl;
+        return false;
+    }
+
+#ifdef __linux__
+    if (inotifyFd < 0) {
+        inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (inotifyFd < 0) {
+            std::cerr << "Failed to initialize inotify: " << std::strerror(errno) << std::endl;
+            return false;
+        }
+    }
+    AddWatchTree(directory, nullptr);
+#else
+    Scan(directory, nullptr);
+#endif
+
+    roots.push_back(directory);
+    return true;
+}
+
+void FileWatcher::Close() {
+#ifdef __linux__
+    if (inotifyFd >= 0) {
+        close(inotifyFd);
+        inotifyFd = -1;
+    }
+    watchDirectories.clear();
+#else
+    modificationTimes.clear();
+#endif
+    roots.clear();
+}
+
+#ifdef __linux__
+
+size_t FileWatcher::Poll(std::vector<std::string>& changedFiles) {
+    if (inotifyFd < 0) return 0;
+
+    size_t firstChange = changedFiles.size();
+    std::unordered_set<std::string> seen;
+    auto report = [&](std::string path) {
+        if (seen.insert(path).second) {
+            changedFiles.push_back(std::move(path));
+        }
+        };
+
+    bool overflowed = false;
+    alignas(inotify_event) char buffer[4096];
+
+    while (true) {
+        ssize_t length = read(inotifyFd, buffer, sizeof(buffer));
+        if (length <= 0) break;    // EAGAIN: queue drained
+
+        for (char* cursor = buffer; cursor < buffer + length;) {
+            const inotify_event* event = reinterpret_cast<const inotify_event*>(cursor);
+            cursor += sizeof(inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                overflowed = true;
+                continue;
+            }
+            if (event->mask & IN_IGNORED) {
+                watchDirectories.erase(event->wd);
+                continue;
+            }
+
+            auto it = watchDirectories.find(event->wd);
+            if (it == watchDirectories.end() || event->len == 0) continue;
+            std::string path = it->second + "/" + event->name;
+
+            if (event->mask & IN_ISDIR) {
+                // New subtree; files may have landed before the watch existed
+                if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                    std::vector<std::string> existingFiles;
+                    AddWatchTree(path, &existingFiles);
+                    for (std::string& file : existingFiles) {
+                        report(std::move(file));
+                    }
+                }
+            }
+            else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) {
+                report(std::move(path));
+            }
+        }
+    }
+
+    // Events were dropped, report everything
+    if (overflowed) {
+        std::vector<std::string> allFiles;
+        for (const std::string& root : roots) {
+            ListFiles(root, allFiles);
+        }
+        for (std::string& file : allFiles) {
+            report(std::move(file));
+        }
+    }
+
+    return changedFiles.size() - firstChange;
+}
+
+bool FileWatcher::AddWatch(const std::string& directory) {
+    int watch = inotify_add_watch(inotifyFd, directory.c_str(),
+        IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_ONLYDIR);
+    if (watch < 0) {
+        std::cerr << "Failed to watch directory " << directory << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    watchDirectories[watch] = directory;
+    return true;
+}
+
+void FileWatcher::AddWatchTree(const std::string& directory, std::vector<std::string>* existingFiles) {
+    AddWatch(directory);
+
+    std::error_code error;
+    std::filesystem::recursive_directory_iterator it(directory,
+        std::filesystem::directory_options::skip_permission_denied, error);
+    for (const std::filesystem::recursive_directory_iterator end; !error && it != end; it.increment(error)) {
+        std::error_code typeError;
+        if (it->is_directory(typeError)) {
+            AddWatch(it->path().generic_string());
+        }
+        else if (existingFiles && it->is_regular_file(typeError)) {
+            existingFiles->push_back(it->path().generic_string());
+        }
+    }
+}
+
+#else
+
+size_t FileWatcher::Poll(std::vector<std::string>& changedFiles) {
+    size_t firstChange = changedFiles.size();
+    for (const std::string& root : roots) {
+        Scan(root, &changedFiles);
+    }
+    return changedFiles.size() - firstChange;
+}
+
+void FileWatcher::Scan(const std::string& directory, std::vector<std::string>* changedFiles) {
+    std::vector<std::string> files;
+    ListFiles(directory, files);
+
+    for (std::string& file : files) {
+        std::error_code error;
+        auto writeTime = std::filesystem::last_write_time(file, error);
+        if (error) continue;
+
+        int64_t time = static_cast<int64_t>(writeTime.time_since_epoch().count());
+        auto it = modificationTimes.find(file);
+        if (it != modificationTimes.end() && it->second == time) continue;
+
+        modificationTimes[file] = time;
+        if (changedFiles) {
+            changedFiles->push_back(std::move(file));
+        }
+    }
+}
+
+#endif
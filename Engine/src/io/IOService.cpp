@@ -0,0 +1,562 @@
+#include "../include/io/IOService.h"
+#include "../include/systems/ThreadPool.h"
+#include <iostream>
+#include <algorithm>
+#include <cstdio>
+#include <cerrno>
+#include <cstring>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define ENGINE_HAS_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    // Push a stdio stream's data to stable storage
+    bool SyncFile(std::FILE* file) {
+        if (std::fflush(file) != 0) return false;
+#if defined(_WIN32)
+        return _commit(_fileno(file)) == 0;
+#elif defined(__linux__)
+        return fdatasync(fileno(file)) == 0;
+#else
+        return fsync(fileno(file)) == 0;
+#endif
+    }
+}
+
+// Static instance initialization
+IOService* IOService::instance = nullptr;
+
+IOService& IOService::GetInstance() {
+    if (instance == nullptr) {
+        instance = new IOService();
+    }
+    return *instance;
+}
+
+void IOService::DestroyInstance() {
+    delete instance;
+    instance = nullptr;
+}
+
+IORequest IORequest::Read(const std::string& filepath, IOCallback onComplete) {
+    IORequest request;
+    request.type = Type::Read;
+    request.path = filepath;
+    request.callback = std::move(onComplete);
+    return request;
+}
+
+IORequest IORequest::Write(const std::string& filepath, std::vector<uint8_t> payload, IOCallback onComplete) {
+    IORequest request;
+    request.type = Type::Write;
+    request.path = filepath;
+    request.data = std::move(payload);
+    request.callback = std::move(onComplete);
+    return request;
+}
+
+IORequest IORequest::Append(const std::string& filepath, std::vector<uint8_t> payload, IOCallback onComplete) {
+    IORequest request;
+    request.type = Type::Append;
+    request.path = filepath;
+    request.data = std::move(payload);
+    request.callback = std::move(onComplete);
+    return request;
+}
+
+#ifdef ENGINE_HAS_IO_URING
+
+// Minimal io_uring driver over the raw syscalls (no liburing dependency).
+// Only the submission thread touches it.
+struct IOService::Ring {
+    int fd = -1;
+    unsigned entries = 0;
+
+    void* sqMemory = nullptr;
+    size_t sqMemorySize = 0;
+    void* cqMemory = nullptr;
+    size_t cqMemorySize = 0;
+    io_uring_sqe* sqes = nullptr;
+    size_t sqesSize = 0;
+
+    unsigned* sqHead = nullptr;
+    unsigned* sqTail = nullptr;
+    unsigned* sqMask = nullptr;
+    unsigned* sqArray = nullptr;
+    unsigned* cqHead = nullptr;
+    unsigned* cqTail = nullptr;
+    unsigned* cqMask = nullptr;
+    io_uring_cqe* cqes = nullptr;
+
+    unsigned toSubmit = 0;
+
+    bool Setup(unsigned requestedEntries) {
+        io_uring_params params = {};
+        fd = static_cast<int>(syscall(__NR_io_uring_setup, requestedEntries, &params));
+        if (fd < 0) return false;
+
+        // IORING_OP_READ/WRITE arrived together with this feature (Linux 5.6)
+        if (!(params.features & IORING_FEAT_RW_CUR_POS)) {
+            Teardown();
+            return false;
+        }
+
+        entries = params.sq_entries;
+        sqMemorySize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqMemorySize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (singleMap) {
+            sqMemorySize = cqMemorySize = std::max(sqMemorySize, cqMemorySize);
+        }
+
+        sqMemory = mmap(nullptr, sqMemorySize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+        if (sqMemory == MAP_FAILED) {
+            sqMemory = nullptr;
+            Teardown();
+            return false;
+        }
+        if (singleMap) {
+            cqMemory = sqMemory;
+        }
+        else {
+            cqMemory = mmap(nullptr, cqMemorySize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+            if (cqMemory == MAP_FAILED) {
+                cqMemory = nullptr;
+                Teardown();
+                return false;
+            }
+        }
+
+        sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqeMemory = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+        if (sqeMemory == MAP_FAILED) {
+            Teardown();
+            return false;
+        }
+        sqes = static_cast<io_uring_sqe*>(sqeMemory);
+
+        uint8_t* sq = static_cast<uint8_t*>(sqMemory);
+        sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sqMask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+        uint8_t* cq = static_cast<uint8_t*>(cqMemory);
+        cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cqMask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        return true;
+    }
+
+    void Teardown() {
+        if (sqes) munmap(sqes, sqesSize);
+        if (cqMemory && cqMemory != sqMemory) munmap(cqMemory, cqMemorySize);
+        if (sqMemory) munmap(sqMemory, sqMemorySize);
+        if (fd >= 0) close(fd);
+        sqes = nullptr;
+        sqMemory = cqMemory = nullptr;
+        fd = -1;
+    }
+
+    // Queue a read/write of 'length' bytes at 'offset' (or an fsync); the
+    // caller keeps at most 'entries' operations in flight, so the SQ never
+    // overflows
+    void Prepare(uint8_t opcode, int fileDescriptor, void* buffer, uint32_t length, uint64_t offset, uint64_t userData,
+        uint32_t opFlags = 0) {
+        unsigned tail = *sqTail;
+        unsigned index = tail & *sqMask;
+
+        io_uring_sqe* sqe = &sqes[index];
+        std::memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = opcode;
+        sqe->fd = fileDescriptor;
+        sqe->off = offset;
+        sqe->addr = reinterpret_cast<uint64_t>(buffer);
+        sqe->len = length;
+        sqe->fsync_flags = opFlags;
+        sqe->user_data = userData;
+
+        sqArray[index] = index;
+        __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+        toSubmit++;
+    }
+
+    // Submit queued SQEs and optionally wait for at least one completion
+    bool Enter(unsigned waitFor) {
+        while (true) {
+            unsigned flags = waitFor > 0 ? IORING_ENTER_GETEVENTS : 0;
+            long submitted = syscall(__NR_io_uring_enter, fd, toSubmit, waitFor, flags, nullptr, 0);
+            if (submitted >= 0) {
+                toSubmit -= static_cast<unsigned>(submitted);
+                return true;
+            }
+            if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+                return false;
+            }
+        }
+    }
+
+    template<typename F>
+    void Reap(F&& handler) {
+        unsigned head = *cqHead;
+        unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+        while (head != tail) {
+            const io_uring_cqe& cqe = cqes[head & *cqMask];
+            handler(cqe.user_data, cqe.res);
+            head++;
+        }
+        __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+    }
+};
+
+#else
+
+struct IOService::Ring {};
+
+#endif
+
+IOService::IOService(size_t workerThreads, unsigned maxInFlight, bool allowIoUring)
+    : queueDepth(std::max(maxInFlight, 1u)) {
+#ifdef ENGINE_HAS_IO_URING
+    if (allowIoUring) {
+        auto candidate = std::make_unique<Ring>();
+        if (candidate->Setup(queueDepth)) {
+            ring = std::move(candidate);
+            queueDepth = std::min(queueDepth, ring->entries);
+            backend = Backend::IoUring;
+            ringThread = std::thread(&IOService::RingLoop, this);
+        }
+    }
+#endif
+
+    if (backend == Backend::ThreadPool) {
+        workers = std::make_unique<ThreadPool>(std::max(workerThreads, static_cast<size_t>(1)));
+    }
+
+    std::cout << "IOService initialized (" << GetBackendName() << ")" << std::endl;
+}
+
+IOService::~IOService() {
+    if (ringThread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            stopping = true;
+        }
+        queueCondition.notify_all();
+        ringThread.join();
+    }
+
+#ifdef ENGINE_HAS_IO_URING
+    if (ring) {
+        ring->Teardown();
+    }
+#endif
+
+    // ThreadPool drains its queue on destruction
+    workers.reset();
+}
+
+const char* IOService::GetBackendName() const {
+    return backend == Backend::IoUring ? "io_uring" : "thread pool";
+}
+
+std::future<IOResult> IOService::ReadFile(const std::string& filepath) {
+    std::vector<IORequest> requests;
+    requests.push_back(IORequest::Read(filepath));
+    return std::move(Submit(std::move(requests)).front());
+}
+
+std::future<IOResult> IOService::WriteFile(const std::string& filepath, std::vector<uint8_t> data) {
+    std::vector<IORequest> requests;
+    requests.push_back(IORequest::Write(filepath, std::move(data)));
+    return std::move(Submit(std::move(requests)).front());
+}
+
+void IOService::ReadFile(const std::string& filepath, IOCallback callback) {
+    std::vector<IORequest> requests;
+    requests.push_back(IORequest::Read(filepath, std::move(callback)));
+    Submit(std::move(requests));
+}
+
+void IOService::WriteFile(const std::string& filepath, std::vector<uint8_t> data, IOCallback callback) {
+    std::vector<IORequest> requests;
+    requests.push_back(IORequest::Write(filepath, std::move(data), std::move(callback)));
+    Submit(std::move(requests));
+}
+
+std::vector<std::future<IOResult>> IOService::Submit(std::vector<IORequest> requests) {
+    std::vector<std::future<IOResult>> futures;
+    futures.reserve(requests.size());
+
+    std::vector<std::unique_ptr<Pending>> batch;
+    batch.reserve(requests.size());
+    for (IORequest& request : requests) {
+        auto pending = std::make_unique<Pending>();
+        pending->request = std::move(request);
+        futures.push_back(pending->promise.get_future());
+        batch.push_back(std::move(pending));
+    }
+
+    if (backend == Backend::IoUring) {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            for (auto& pending : batch) {
+                queue.push_back(std::move(pending));
+            }
+        }
+        queueCondition.notify_one();
+    }
+    else {
+        for (auto& pending : batch) {
+            std::shared_ptr<Pending> shared(std::move(pending));
+            workers->EnqueueTask([this, shared]() { ExecuteBlocking(*shared); });
+        }
+    }
+
+    return futures;
+}
+
+void IOService::Complete(Pending& pending, IOResult& result) {
+    if (result.success) {
+        requestsCompleted++;
+        (pending.request.type == IORequest::Type::Read ? bytesRead : bytesWritten) += result.bytesTransferred;
+    }
+    else {
+        requestsFailed++;
+    }
+
+    if (pending.request.callback) {
+        pending.request.callback(result);
+    }
+    pending.promise.set_value(std::move(result));
+}
+
+void IOService::ExecuteBlocking(Pending& pending) {
+    IORequest& request = pending.request;
+    IOResult result;
+    result.path = request.path;
+
+    if (request.type == IORequest::Type::Read) {
+        std::FILE* file = std::fopen(request.path.c_str(), "rb");
+        if (file && std::fseek(file, 0, SEEK_END) == 0) {
+            long size = std::ftell(file);
+            if (size >= 0 && std::fseek(file, 0, SEEK_SET) == 0) {
+                result.data.resize(static_cast<size_t>(size));
+                result.bytesTransferred = std::fread(result.data.data(), 1, result.data.size(), file);
+                result.data.resize(result.bytesTransferred);
+                result.success = std::ferror(file) == 0;
+            }
+        }
+        if (!result.success) {
+            result.error = errno ? errno : EIO;
+        }
+        if (file) std::fclose(file);
+    }
+    else {
+        bool append = request.type == IORequest::Type::Append;
+        std::FILE* file = std::fopen(request.path.c_str(), append ? "ab" : "wb");
+        if (file) {
+            result.bytesTransferred = std::fwrite(request.data.data(), 1, request.data.size(), file);
+            result.success = result.bytesTransferred == request.data.size();
+            if (result.success && request.sync) {
+                result.success = SyncFile(file);
+            }
+            result.success = (std::fclose(file) == 0) && result.success;
+        }
+        if (!result.success) {
+            result.error = errno ? errno : EIO;
+        }
+    }
+
+    Complete(pending, result);
+}
+
+void IOService::RingLoop() {
+#ifdef ENGINE_HAS_IO_URING
+    // One slot per in-flight request; the slot index is the SQE user_data
+    struct Operation {
+        std::unique_ptr<Pending> pending;
+        IOResult result;
+        int fd = -1;
+        uint8_t* buffer = nullptr;
+        size_t size = 0;
+        size_t offset = 0;
+        bool syncing = false;       // Data written, fdatasync in flight
+    };
+
+    std::vector<Operation> slots(queueDepth);
+    std::vector<size_t> freeSlots;
+    for (size_t i = queueDepth; i > 0; --i) {
+        freeSlots.push_back(i - 1);
+    }
+    size_t inFlight = 0;
+
+    auto finish = [&](size_t slot, bool success, int error) {
+        Operation& operation = slots[slot];
+        if (operation.fd >= 0) {
+            // close reports deferred write errors
+            if (close(operation.fd) != 0 && success && operation.pending->request.type != IORequest::Type::Read) {
+                success = false;
+                error = errno;
+            }
+        }
+        operation.result.success = success;
+        operation.result.error = success ? 0 : error;
+        operation.result.bytesTransferred = operation.offset;
+        if (operation.pending->request.type == IORequest::Type::Read) {
+            operation.result.data.resize(operation.offset);
+        }
+
+        Complete(*operation.pending, operation.result);
+        operation = Operation();
+        freeSlots.push_back(slot);
+        };
+
+    auto submitChunk = [&](size_t slot) {
+        Operation& operation = slots[slot];
+        uint32_t length = static_cast<uint32_t>(std::min(operation.size - operation.offset, static_cast<size_t>(1) << 30));
+        bool isRead = operation.pending->request.type == IORequest::Type::Read;
+        ring->Prepare(isRead ? IORING_OP_READ : IORING_OP_WRITE, operation.fd,
+            operation.buffer + operation.offset, length, operation.offset, slot);
+        };
+
+    auto submitSync = [&](size_t slot) {
+        Operation& operation = slots[slot];
+        operation.syncing = true;
+        ring->Prepare(IORING_OP_FSYNC, operation.fd, nullptr, 0, 0, slot, IORING_FSYNC_DATASYNC);
+        };
+
+    auto start = [&](std::unique_ptr<Pending> pending) {
+        size_t slot = freeSlots.back();
+        freeSlots.pop_back();
+        Operation& operation = slots[slot];
+        operation.result.path = pending->request.path;
+        operation.pending = std::move(pending);
+
+        IORequest& request = operation.pending->request;
+        if (request.type == IORequest::Type::Read) {
+            operation.fd = open(request.path.c_str(), O_RDONLY | O_CLOEXEC);
+            struct stat fileStat;
+            if (operation.fd < 0 || fstat(operation.fd, &fileStat) != 0) {
+                finish(slot, false, errno);
+                return;
+            }
+            operation.result.data.resize(static_cast<size_t>(fileStat.st_size));
+            operation.buffer = operation.result.data.data();
+            operation.size = operation.result.data.size();
+        }
+        else {
+            int mode = request.type == IORequest::Type::Append ? O_APPEND : O_TRUNC;
+            operation.fd = open(request.path.c_str(), O_WRONLY | O_CREAT | mode | O_CLOEXEC, 0644);
+            if (operation.fd < 0) {
+                finish(slot, false, errno);
+                return;
+            }
+            operation.buffer = request.data.data();
+            operation.size = request.data.size();
+        }
+
+        if (operation.size == 0) {
+            if (request.sync) {
+                submitSync(slot);
+                inFlight++;
+            }
+            else {
+                finish(slot, true, 0);
+            }
+            return;
+        }
+        submitChunk(slot);
+        inFlight++;
+        };
+
+    while (true) {
+        std::vector<std::unique_ptr<Pending>> starting;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            if (inFlight == 0) {
+                queueCondition.wait(lock, [this]() { return stopping || !queue.empty(); });
+                if (stopping && queue.empty()) break;
+            }
+            while (!queue.empty() && starting.size() < freeSlots.size()) {
+                starting.push_back(std::move(queue.front()));
+                queue.pop_front();
+            }
+        }
+
+        for (auto& pending : starting) {
+            start(std::move(pending));
+        }
+        if (inFlight == 0) continue;
+
+        if (!ring->Enter(1)) {
+            // The ring is unusable; fail what is in flight rather than hang
+            int error = errno;
+            for (size_t slot = 0; slot < slots.size(); ++slot) {
+                if (slots[slot].pending) {
+                    finish(slot, false, error);
+                }
+            }
+            inFlight = 0;
+            ring->toSubmit = 0;
+            continue;
+        }
+
+        ring->Reap([&](uint64_t userData, int32_t res) {
+            size_t slot = static_cast<size_t>(userData);
+            Operation& operation = slots[slot];
+
+            if (res == -EINTR || res == -EAGAIN) {
+                if (operation.syncing) {
+                    submitSync(slot);
+                }
+                else {
+                    submitChunk(slot);
+                }
+                return;
+            }
+
+            inFlight--;
+            if (res < 0) {
+                finish(slot, false, -res);
+                return;
+            }
+            if (operation.syncing) {
+                finish(slot, true, 0);
+                return;
+            }
+
+            operation.offset += static_cast<size_t>(res);
+            if (res == 0 || operation.offset >= operation.size) {
+                // res == 0: the file shrank since fstat (reads) or the device is full (writes)
+                bool complete = operation.offset >= operation.size || operation.pending->request.type == IORequest::Type::Read;
+                if (complete && operation.pending->request.sync) {
+                    submitSync(slot);
+                    inFlight++;
+                    return;
+                }
+                finish(slot, complete, complete ? 0 : ENOSPC);
+                return;
+            }
+
+            // Short transfer, continue where it stopped
+            submitChunk(slot);
+            inFlight++;
+            });
+    }
+#endif
+}
@@ -0,0 +1,139 @@
+#include "../include/io/MappedFile.h"
+#include <iostream>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::string& filepath) {
+    Open(filepath);
+}
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        Close();
+        data = other.data;
+        size = other.size;
+#ifdef _WIN32
+        fileHandle = other.fileHandle;
+        mappingHandle = other.mappingHandle;
+#else
+        fileDescriptor = other.fileDescriptor;
+#endif
+        other.Reset();
+    }
+    return *this;
+}
+
+bool MappedFile::Open(const std::string& filepath) {
+    Close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        std::cerr << "Failed to open file for mapping: " << filepath << std::endl;
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        std::cerr << "Cannot map empty file: " << filepath << std::endl;
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        std::cerr << "Failed to map file: " << filepath << std::endl;
+        return false;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        std::cerr << "Failed to map file: " << filepath << std::endl;
+        return false;
+    }
+
+    fileHandle = file;
+    mappingHandle = mapping;
+    data = static_cast<const uint8_t*>(view);
+    size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = open(filepath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Failed to open file for mapping: " << filepath << std::endl;
+        return false;
+    }
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0) {
+        close(fd);
+        std::cerr << "Cannot map empty file: " << filepath << std::endl;
+        return false;
+    }
+
+    void* view = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    if (view == MAP_FAILED) {
+        close(fd);
+        std::cerr << "Failed to map file: " << filepath << std::endl;
+        return false;
+    }
+
+    // Loaders walk the file front to back, let the kernel read ahead aggressively
+    madvise(view, static_cast<size_t>(fileStat.st_size), MADV_SEQUENTIAL);
+    madvise(view, static_cast<size_t>(fileStat.st_size), MADV_WILLNEED);
+
+    fileDescriptor = fd;
+    data = static_cast<const uint8_t*>(view);
+    size = static_cast<size_t>(fileStat.st_size);
+#endif
+
+    return true;
+}
+
+void MappedFile::Close() {
+    if (!data) return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(data);
+    CloseHandle(static_cast<HANDLE>(mappingHandle));
+    CloseHandle(static_cast<HANDLE>(fileHandle));
+#else
+    munmap(const_cast<uint8_t*>(data), size);
+    close(fileDescriptor);
+#endif
+
+    Reset();
+}
+
+void MappedFile::Reset() {
+    data = nullptr;
+    size = 0;
+#ifdef _WIN32
+    fileHandle = nullptr;
+    mappingHandle = nullptr;
+#else
+    fileDescriptor = -1;
+#endif
+}
@@ -0,0 +1,214 @@
+#include "../include/io/ParseCache.h"
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <thread>
+#include <cstring>
+
+namespace {
+    constexpr char CacheMagic[4] = { 'P', 'C', 'C', 'H' };
+
+    struct CacheHeader {
+        char magic[4];
+        uint32_t formatVersion;
+        uint64_t version;
+        uint64_t contentHash;
+        uint64_t sourceSize;
+        int64_t sourceTime;
+        uint64_t payloadSize;
+    };
+
+    static_assert(sizeof(CacheHeader) == 48, "CacheHeader layout changed");
+
+    uint64_t RotateLeft(uint64_t value, int bits) {
+        return (value << bits) | (value >> (64 - bits));
+    }
+
+    uint64_t FinalMix(uint64_t value) {
+        value ^= value >> 33;
+        value *= 0xff51afd7ed558ccdULL;
+        value ^= value >> 33;
+        value *= 0xc4ceb9fe1a85ec53ULL;
+        value ^= value >> 33;
+        return value;
+    }
+
+    bool GetSourceInfo(const std::string& path, uint64_t& size, int64_t& time) {
+        std::error_code error;
+        size = static_cast<uint64_t>(std::filesystem::file_size(path, error));
+        if (error) return false;
+
+        auto writeTime = std::filesystem::last_write_time(path, error);
+        if (error) return false;
+        time = static_cast<int64_t>(writeTime.time_since_epoch().count());
+        return true;
+    }
+
+    // Map an existing entry quietly (a missing entry is a normal miss)
+    const CacheHeader* MapEntry(const std::string& cachePath, MappedFile& file, uint64_t version) {
+        std::error_code error;
+        if (std::filesystem::file_size(cachePath, error) < sizeof(CacheHeader) || error) {
+            return nullptr;
+        }
+        if (!file.Open(cachePath)) {
+            return nullptr;
+        }
+
+        const CacheHeader* header = reinterpret_cast<const CacheHeader*>(file.GetData());
+        if (std::memcmp(header->magic, CacheMagic, sizeof(CacheMagic)) != 0 ||
+            header->formatVersion != ParseCache::FormatVersion ||
+            header->version != version ||
+            header->payloadSize != file.GetSize() - sizeof(CacheHeader)) {
+            file.Close();
+            return nullptr;
+        }
+        return header;
+    }
+}
+
+ParseCache::ParseCache(const std::string& directory) : cacheDirectory(directory) {
+}
+
+bool ParseCache::Lookup(const std::string& sourcePath, uint64_t version, Entry& entry) {
+    entry = Entry();
+    entry.sourcePath = sourcePath;
+    entry.version = version;
+    entry.cachePath = GetCachePath(sourcePath);
+
+    if (!GetSourceInfo(sourcePath, entry.sourceSize, entry.sourceTime)) {
+        std::cerr << "Failed to read source file: " << sourcePath << std::endl;
+        return false;
+    }
+
+    const CacheHeader* header = MapEntry(entry.cachePath, entry.cacheFile, version);
+
+    // Fast path: same size and mtime as when the entry was written
+    if (header && header->sourceSize == entry.sourceSize && header->sourceTime == entry.sourceTime) {
+        entry.contentHash = header->contentHash;
+    }
+    else {
+        if (entry.sourceSize > 0 && !entry.source.Open(sourcePath)) {
+            return false;
+        }
+        entry.contentHash = HashBytes(entry.source.GetData(), entry.source.GetSize());
+
+        if (!header || header->sourceSize != entry.sourceSize || header->contentHash != entry.contentHash) {
+            entry.cacheFile.Close();
+            misses++;
+            return true;
+        }
+
+        // Touched but unchanged; refresh the stored mtime so the next lookup skips the hash
+        CacheHeader refreshed = *header;
+        refreshed.sourceTime = entry.sourceTime;
+        std::fstream file(entry.cachePath, std::ios::in | std::ios::out | std::ios::binary);
+        if (file.is_open()) {
+            file.write(reinterpret_cast<const char*>(&refreshed), sizeof(refreshed));
+        }
+        entry.source.Close();
+        rehashedHits++;
+    }
+
+    entry.hit = true;
+    entry.payload = entry.cacheFile.GetData() + sizeof(CacheHeader);
+    entry.payloadSize = entry.cacheFile.GetSize() - sizeof(CacheHeader);
+    hits++;
+    return true;
+}
+
+bool ParseCache::Store(const Entry& entry, const std::vector<uint8_t>& payload) {
+    CacheHeader header = {};
+    std::memcpy(header.magic, CacheMagic, sizeof(CacheMagic));
+    header.formatVersion = FormatVersion;
+    header.version = entry.version;
+    header.contentHash = entry.contentHash;
+    header.sourceSize = entry.sourceSize;
+    header.sourceTime = entry.sourceTime;
+    header.payloadSize = payload.size();
+
+    std::error_code error;
+    if (!cacheDirectory.empty()) {
+        std::filesystem::create_directories(cacheDirectory, error);
+    }
+
+    // Per-thread temp name, the same source may be stored from two threads
+    std::string tempPath = entry.cachePath + "." +
+        std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "Failed to write parse cache entry: " << tempPath << std::endl;
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        if (!payload.empty()) {
+            file.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+        }
+        if (!file) {
+            std::cerr << "Failed to write parse cache entry: " << tempPath << std::endl;
+            file.close();
+            std::filesystem::remove(tempPath, error);
+            return false;
+        }
+    }
+
+    std::filesystem::rename(tempPath, entry.cachePath, error);
+    if (error) {
+        std::cerr << "Failed to write parse cache entry: " << entry.cachePath << " (" << error.message() << ")" << std::endl;
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+    return true;
+}
+
+void ParseCache::ResetStatistics() {
+    hits = 0;
+    rehashedHits = 0;
+    misses = 0;
+}
+
+uint64_t ParseCache::HashBytes(const void* data, size_t size, uint64_t seed) {
+    constexpr uint64_t Prime1 = 0x9e3779b185ebca87ULL;
+    constexpr uint64_t Prime2 = 0xc2b2ae3d27d4eb4fULL;
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint64_t hash = seed ^ (static_cast<uint64_t>(size) * Prime1);
+
+    // One 8-byte word per step
+    while (size >= sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, bytes, sizeof(word));
+        hash = RotateLeft(hash ^ (word * Prime2), 31) * Prime1;
+        bytes += sizeof(word);
+        size -= sizeof(word);
+    }
+    if (size > 0) {
+        uint64_t word = 0;
+        std::memcpy(&word, bytes, size);
+        hash = RotateLeft(hash ^ (word * Prime2), 31) * Prime1;
+    }
+
+    return FinalMix(hash);
+}
+
+std::string ParseCache::GetCachePath(const std::string& sourcePath) const {
+    if (cacheDirectory.empty()) {
+        return sourcePath + ".pcache";
+    }
+
+    // Flat directory, named by the hash of the absolute source path
+    std::error_code error;
+    std::string absolute = std::filesystem::absolute(sourcePath, error).generic_string();
+    if (error) {
+        absolute = sourcePath;
+    }
+
+    char name[17];
+    uint64_t pathHash = HashBytes(absolute.data(), absolute.size());
+    for (int i = 15; i >= 0; --i) {
+        name[i] = "0123456789abcdef"[pathHash & 0xF];
+        pathHash >>= 4;
+    }
+    name[16] = '\0';
+    return cacheDirectory + "/" + name + ".pcache";
+}
@@ -0,0 +1,491 @@
+#include "../include/io/SharedSceneView.h"
+#include "../include/core/Scene.h"
+#include <iostream>
+#include <algorithm>
+#include <limits>
+#include <new>
+#include <cstring>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace SharedViewFormat;
+
+namespace {
+    constexpr uint32_t NoTag = std::numeric_limits<uint32_t>::max();
+
+    size_t AlignUp(size_t value, size_t alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+#ifndef _WIN32
+    // POSIX shared memory names are a single path component after a slash
+    std::string GetPosixName(const std::string& name) {
+        return name.empty() || name[0] != '/' ? "/" + name : name;
+    }
+#endif
+}
+
+// ===== SharedMemoryRegion =====
+
+SharedMemoryRegion::~SharedMemoryRegion() {
+    Close();
+}
+
+bool SharedMemoryRegion::Create(const std::string& regionName, size_t regionSize) {
+    Close();
+
+#ifdef _WIN32
+    HANDLE mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+        static_cast<DWORD>(static_cast<uint64_t>(regionSize) >> 32), static_cast<DWORD>(regionSize),
+        regionName.c_str());
+    if (!mapping) {
+        std::cerr << "Failed to create shared memory: " << regionName << std::endl;
+        return false;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, regionSize);
+    if (!view) {
+        CloseHandle(mapping);
+        std::cerr << "Failed to map shared memory: " << regionName << std::endl;
+        return false;
+    }
+    mappingHandle = mapping;
+#else
+    // A region left behind by a crashed run is replaced, not reused
+    std::string posixName = GetPosixName(regionName);
+    shm_unlink(posixName.c_str());
+
+    int fd = shm_open(posixName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        std::cerr << "Failed to create shared memory: " << regionName << std::endl;
+        return false;
+    }
+
+    if (ftruncate(fd, static_cast<off_t>(regionSize)) != 0) {
+        close(fd);
+        shm_unlink(posixName.c_str());
+        std::cerr << "Failed to size shared memory: " << regionName << std::endl;
+        return false;
+    }
+
+    void* view = mmap(nullptr, regionSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED) {
+        shm_unlink(posixName.c_str());
+        std::cerr << "Failed to map shared memory: " << regionName << std::endl;
+        return false;
+    }
+#endif
+
+    data = static_cast<uint8_t*>(view);
+    size = regionSize;
+    name = regionName;
+    owner = true;
+    return true;
+}
+
+bool SharedMemoryRegion::OpenReadOnly(const std::string& regionName) {
+    Close();
+
+#ifdef _WIN32
+    HANDLE mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, regionName.c_str());
+    if (!mapping) {
+        std::cerr << "Failed to open shared memory: " << regionName << std::endl;
+        return false;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    MEMORY_BASIC_INFORMATION info;
+    if (!view || VirtualQuery(view, &info, sizeof(info)) == 0) {
+        if (view) UnmapViewOfFile(view);
+        CloseHandle(mapping);
+        std::cerr << "Failed to map shared memory: " << regionName << std::endl;
+        return false;
+    }
+    mappingHandle = mapping;
+    size_t regionSize = static_cast<size_t>(info.RegionSize);
+#else
+    int fd = shm_open(GetPosixName(regionName).c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        std::cerr << "Failed to open shared memory: " << regionName << std::endl;
+        return false;
+    }
+
+    struct stat regionStat;
+    if (fstat(fd, &regionStat) != 0 || regionStat.st_size == 0) {
+        close(fd);
+        std::cerr << "Shared memory is empty: " << regionName << std::endl;
+        return false;
+    }
+    size_t regionSize = static_cast<size_t>(regionStat.st_size);
+
+    void* view = mmap(nullptr, regionSize, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED) {
+        std::cerr << "Failed to map shared memory: " << regionName << std::endl;
+        return false;
+    }
+#endif
+
+    data = static_cast<uint8_t*>(view);
+    size = regionSize;
+    name = regionName;
+    owner = false;
+    return true;
+}
+
+void SharedMemoryRegion::Close() {
+    if (!data) return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(data);
+    CloseHandle(static_cast<HANDLE>(mappingHandle));
+    mappingHandle = nullptr;
+#else
+    munmap(data, size);
+    if (owner) {
+        shm_unlink(GetPosixName(name).c_str());
+    }
+#endif
+
+    data = nullptr;
+    size = 0;
+    name.clear();
+    owner = false;
+}
+
+// ===== SharedScenePublisher =====
+
+bool SharedScenePublisher::Open(const SharedSceneViewConfig& viewConfig) {
+    Close();
+
+    if (viewConfig.capacity == 0 || viewConfig.capacity > std::numeric_limits<uint32_t>::max() ||
+        viewConfig.maxTags >= std::numeric_limits<uint32_t>::max() ||
+        viewConfig.maxTagBytes > std::numeric_limits<uint32_t>::max()) {
+        std::cerr << "Invalid shared scene view configuration" << std::endl;
+        return false;
+    }
+
+    config = viewConfig;
+    config.columns &= AllColumns;
+    bool hasTags = (config.columns & Tags) != 0;
+
+    // Columns are laid out back to back, each 64-byte aligned
+    size_t capacity = config.capacity;
+    size_t offset = AlignUp(sizeof(SharedViewBuffer), 64);
+    auto place = [&offset](uint32_t column, uint32_t mask, size_t bytes) -> uint64_t {
+        if ((column & mask) == 0) return 0;
+        uint64_t placed = offset;
+        offset = AlignUp(offset + bytes, 64);
+        return placed;
+        };
+
+    SharedViewHeader layout{};
+    layout.idOffset = place(config.columns, Ids, capacity * sizeof(uint64_t));
+    for (uint64_t& positionOffset : layout.positionOffsets) {
+        positionOffset = place(config.columns, Positions, capacity * sizeof(float));
+    }
+    layout.activeOffset = place(config.columns, ActiveFlags, capacity);
+    layout.tagIndexOffset = place(config.columns, Tags, capacity * sizeof(uint32_t));
+    layout.tagOffsetsOffset = place(config.columns, Tags, (config.maxTags + 1) * sizeof(uint32_t));
+    layout.tagCharsOffset = place(config.columns, Tags, config.maxTagBytes);
+    layout.bufferSize = offset;
+
+    size_t headerSize = AlignUp(sizeof(SharedViewHeader), 64);
+    size_t regionSize = headerSize + 2 * offset;
+    if (!region.Create(config.name, regionSize)) {
+        return false;
+    }
+
+    // Fresh mappings are zeroed: both sequences start even and empty
+    header = new (region.GetData()) SharedViewHeader();
+    header->version = Version;
+    header->columns = config.columns;
+    header->capacity = static_cast<uint32_t>(capacity);
+    header->maxTags = hasTags ? static_cast<uint32_t>(config.maxTags) : 0;
+    header->maxTagBytes = hasTags ? static_cast<uint32_t>(config.maxTagBytes) : 0;
+    header->bufferSize = layout.bufferSize;
+    header->bufferOffsets[0] = headerSize;
+    header->bufferOffsets[1] = headerSize + offset;
+    header->idOffset = layout.idOffset;
+    std::copy(std::begin(layout.positionOffsets), std::end(layout.positionOffsets), header->positionOffsets);
+    header->activeOffset = layout.activeOffset;
+    header->tagIndexOffset = layout.tagIndexOffset;
+    header->tagOffsetsOffset = layout.tagOffsetsOffset;
+    header->tagCharsOffset = layout.tagCharsOffset;
+    for (uint64_t bufferOffset : header->bufferOffsets) {
+        new (region.GetData() + bufferOffset) SharedViewBuffer();
+    }
+    header->latest.store(0, std::memory_order_relaxed);
+    header->publishCount.store(0, std::memory_order_relaxed);
+
+    // The magic goes in last so a reader never validates a half-written header
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(header->magic, Magic, sizeof(Magic));
+
+    framesSincePublish = 0;
+    tagIndices.clear();
+    tagOffsets.assign(1, 0);
+    tagChars.clear();
+    return true;
+}
+
+void SharedScenePublisher::Close() {
+    header = nullptr;
+    region.Close();
+}
+
+bool SharedScenePublisher::ShouldPublish() {
+    if (!header) return false;
+
+    if (++framesSincePublish >= std::max<size_t>(config.publishIntervalFrames, 1)) {
+        framesSincePublish = 0;
+        return true;
+    }
+    return false;
+}
+
+void SharedScenePublisher::Update(const Scene& scene, uint64_t frameNumber) {
+    if (ShouldPublish()) {
+        Publish(scene, frameNumber);
+    }
+}
+
+void SharedScenePublisher::Update(const FrameSnapshot& snapshot) {
+    if (ShouldPublish()) {
+        Publish(snapshot);
+    }
+}
+
+void SharedScenePublisher::Publish(const Scene& scene, uint64_t frameNumber) {
+    if (!header) return;
+
+    sceneSnapshot.Capture(scene, frameNumber, 0.0f);
+    Publish(sceneSnapshot);
+}
+
+void SharedScenePublisher::Publish(const FrameSnapshot& snapshot) {
+    WriteTarget target;
+    if (!BeginWrite(target)) return;
+
+    size_t count = std::min(snapshot.GetObjectCount(), target.capacity);
+    if (target.ids) {
+        std::memcpy(target.ids, snapshot.ids.data(), count * sizeof(uint64_t));
+    }
+    if (target.positions[0]) {
+        for (size_t i = 0; i < count; ++i) {
+            target.positions[0][i] = snapshot.positions[i].x;
+            target.positions[1][i] = snapshot.positions[i].y;
+            target.positions[2][i] = snapshot.positions[i].z;
+        }
+    }
+    if (target.active) {
+        std::memcpy(target.active, snapshot.active.data(), count);
+    }
+    if (target.tags) {
+        // The snapshot has its own (small) tag table; map it onto ours
+        snapshotTagMap.resize(snapshot.tags.size());
+        for (size_t i = 0; i < snapshot.tags.size(); ++i) {
+            snapshotTagMap[i] = GetTagIndex(snapshot.tags[i]);
+        }
+        for (size_t i = 0; i < count; ++i) {
+            target.tags[i] = snapshotTagMap[snapshot.tagIndices[i]];
+        }
+    }
+
+    EndWrite(target, snapshot.frame, count, snapshot.GetObjectCount() > count);
+}
+
+bool SharedScenePublisher::BeginWrite(WriteTarget& target) {
+    if (!header) return false;
+
+    // Write the buffer readers are not pointed at
+    target.index = header->latest.load(std::memory_order_relaxed) ^ 1u;
+    target.base = region.GetData() + header->bufferOffsets[target.index];
+    target.buffer = reinterpret_cast<SharedViewBuffer*>(target.base);
+
+    target.sequence = target.buffer->sequence.load(std::memory_order_relaxed);
+    target.buffer->sequence.store(target.sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    uint8_t* base = target.base;
+    target.capacity = header->capacity;
+    target.ids = header->idOffset ? reinterpret_cast<uint64_t*>(base + header->idOffset) : nullptr;
+    for (size_t axis = 0; axis < 3; ++axis) {
+        target.positions[axis] = header->positionOffsets[0]
+            ? reinterpret_cast<float*>(base + header->positionOffsets[axis]) : nullptr;
+    }
+    target.active = header->activeOffset ? base + header->activeOffset : nullptr;
+    target.tags = header->tagIndexOffset ? reinterpret_cast<uint32_t*>(base + header->tagIndexOffset) : nullptr;
+
+    // Stale tags are dropped only when the table is full
+    if (target.tags && (tagIndices.size() >= config.maxTags || tagChars.size() >= config.maxTagBytes)) {
+        tagIndices.clear();
+        tagOffsets.assign(1, 0);
+        tagChars.clear();
+    }
+    return true;
+}
+
+void SharedScenePublisher::EndWrite(WriteTarget& target, uint64_t frameNumber, size_t count, bool truncated) {
+    SharedViewBuffer* buffer = target.buffer;
+    buffer->frame = frameNumber;
+    buffer->objectCount = static_cast<uint32_t>(count);
+    buffer->truncated = truncated ? 1 : 0;
+    if (target.tags) {
+        std::memcpy(target.base + header->tagOffsetsOffset, tagOffsets.data(), tagOffsets.size() * sizeof(uint32_t));
+        std::memcpy(target.base + header->tagCharsOffset, tagChars.data(), tagChars.size());
+        buffer->tagCount = static_cast<uint32_t>(tagOffsets.size() - 1);
+        buffer->tagBytes = static_cast<uint32_t>(tagChars.size());
+    }
+
+    buffer->sequence.store(target.sequence + 2, std::memory_order_release);
+    header->latest.store(target.index, std::memory_order_release);
+    header->publishCount.fetch_add(1, std::memory_order_release);
+}
+
+uint64_t SharedScenePublisher::GetPublishCount() const {
+    return header ? header->publishCount.load(std::memory_order_relaxed) : 0;
+}
+
+uint32_t SharedScenePublisher::GetTagIndex(const std::string& tag) {
+    auto found = tagIndices.find(tag);
+    if (found != tagIndices.end()) {
+        return found->second;
+    }
+
+    // Tags that don't fit read back as empty
+    if (tagIndices.size() >= config.maxTags || tagChars.size() + tag.size() > config.maxTagBytes) {
+        return NoTag;
+    }
+
+    uint32_t index = static_cast<uint32_t>(tagOffsets.size() - 1);
+    tagChars += tag;
+    tagOffsets.push_back(static_cast<uint32_t>(tagChars.size()));
+    tagIndices.emplace(tag, index);
+    return index;
+}
+
+// ===== SharedSceneFrame =====
+
+std::string SharedSceneFrame::GetTag(size_t objectIndex) const {
+    if (!tagIndices || objectIndex >= objectCount) return std::string();
+
+    size_t index = tagIndices[objectIndex];
+    if (index >= tagCount) return std::string();
+
+    size_t begin = tagOffsets[index];
+    size_t end = tagOffsets[index + 1];
+    if (begin > end || end > tagBytes) return std::string();
+    return std::string(tagChars + begin, end - begin);
+}
+
+// ===== SharedSceneReader =====
+
+bool SharedSceneReader::Open(const std::string& name) {
+    Close();
+
+    if (!region.OpenReadOnly(name)) {
+        return false;
+    }
+
+    // Validate the layout once; buffers are bounds-checked against it per read
+    const auto* candidate = reinterpret_cast<const SharedViewHeader*>(region.GetData());
+    size_t regionSize = region.GetSize();
+    bool valid = regionSize >= sizeof(SharedViewHeader) &&
+        std::memcmp(candidate->magic, Magic, sizeof(Magic)) == 0 &&
+        candidate->version == Version;
+
+    if (valid) {
+        uint64_t bufferSize = candidate->bufferSize;
+        uint64_t capacity = candidate->capacity;
+        auto fits = [bufferSize](uint64_t offset, uint64_t bytes) {
+            return offset == 0 || (offset >= sizeof(SharedViewBuffer) && offset <= bufferSize && bytes <= bufferSize - offset);
+            };
+
+        for (uint64_t bufferOffset : candidate->bufferOffsets) {
+            valid = valid && bufferOffset >= sizeof(SharedViewHeader) && bufferOffset % 8 == 0 &&
+                bufferOffset <= regionSize && bufferSize <= regionSize - bufferOffset;
+        }
+        valid = valid && bufferSize >= sizeof(SharedViewBuffer) &&
+            fits(candidate->idOffset, capacity * sizeof(uint64_t)) &&
+            fits(candidate->activeOffset, capacity) &&
+            fits(candidate->tagIndexOffset, capacity * sizeof(uint32_t)) &&
+            fits(candidate->tagOffsetsOffset, (uint64_t(candidate->maxTags) + 1) * sizeof(uint32_t)) &&
+            fits(candidate->tagCharsOffset, candidate->maxTagBytes);
+        for (uint64_t positionOffset : candidate->positionOffsets) {
+            valid = valid && fits(positionOffset, capacity * sizeof(float));
+        }
+        valid = valid && (candidate->tagIndexOffset == 0 ||
+            (candidate->tagOffsetsOffset != 0 && candidate->tagCharsOffset != 0));
+    }
+
+    if (!valid) {
+        std::cerr << "Not a shared scene view: " << name << std::endl;
+        region.Close();
+        return false;
+    }
+
+    header = candidate;
+    return true;
+}
+
+void SharedSceneReader::Close() {
+    header = nullptr;
+    region.Close();
+}
+
+uint64_t SharedSceneReader::GetPublishCount() const {
+    return header ? header->publishCount.load(std::memory_order_acquire) : 0;
+}
+
+const SharedViewBuffer* SharedSceneReader::GetBuffer(uint32_t buffer) const {
+    return reinterpret_cast<const SharedViewBuffer*>(region.GetData() + header->bufferOffsets[buffer & 1]);
+}
+
+bool SharedSceneReader::BeginRead(SharedSceneFrame& frame, uint32_t& buffer, uint64_t& sequence) const {
+    if (!header || header->publishCount.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+
+    buffer = header->latest.load(std::memory_order_acquire) & 1;
+    const SharedViewBuffer* view = GetBuffer(buffer);
+    sequence = view->sequence.load(std::memory_order_acquire);
+    if (sequence & 1) {
+        return false;
+    }
+
+    // Counts are clamped so a torn frame can't point past the region
+    const uint8_t* base = reinterpret_cast<const uint8_t*>(view);
+    auto column = [base](uint64_t offset) { return offset ? base + offset : nullptr; };
+
+    frame.frame = view->frame;
+    frame.objectCount = std::min<size_t>(view->objectCount, header->capacity);
+    frame.truncated = view->truncated != 0;
+    frame.ids = reinterpret_cast<const uint64_t*>(column(header->idOffset));
+    frame.positionX = reinterpret_cast<const float*>(column(header->positionOffsets[0]));
+    frame.positionY = reinterpret_cast<const float*>(column(header->positionOffsets[1]));
+    frame.positionZ = reinterpret_cast<const float*>(column(header->positionOffsets[2]));
+    frame.active = column(header->activeOffset);
+    frame.tagIndices = reinterpret_cast<const uint32_t*>(column(header->tagIndexOffset));
+    frame.tagCount = std::min<size_t>(view->tagCount, header->maxTags);
+    frame.tagOffsets = reinterpret_cast<const uint32_t*>(column(header->tagOffsetsOffset));
+    frame.tagChars = reinterpret_cast<const char*>(column(header->tagCharsOffset));
+    frame.tagBytes = std::min<size_t>(view->tagBytes, header->maxTagBytes);
+    return true;
+}
+
+bool SharedSceneReader::EndRead(uint32_t buffer, uint64_t sequence) const {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return GetBuffer(buffer)->sequence.load(std::memory_order_relaxed) == sequence;
+}
@@ -0,0 +1,665 @@
+#include "../include/serialization/SceneFormat.h"
+#include "../include/serialization/SceneStreamReader.h"
+#include "../include/io/MappedFile.h"
+#include "../include/io/IOService.h"
+#include "../include/io/AssetArchive.h"
+#include "../include/io/BlockCompression.h"
+#include "../include/core/Scene.h"
+#include "../include/components/Transform.h"
+#include "../include/factories/ComponentFactory.h"
+#include <iostream>
+#include <unordered_map>
+#include <cstring>
+#include <algorithm>
+#include <chrono>
+#include <atomic>
+
+namespace {
+    std::atomic<bool> compressionEnabled{ false };
+    std::atomic<ThreadPool*> codingPool{ nullptr };
+
+    class ByteWriter {
+    public:
+        std::vector<uint8_t> bytes;
+
+        void Write(const void* source, size_t count) {
+            const uint8_t* begin = static_cast<const uint8_t*>(source);
+            bytes.insert(bytes.end(), begin, begin + count);
+        }
+
+        template<typename T>
+        void WritePod(const T& value) {
+            static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+            Write(&value, sizeof(T));
+        }
+
+        template<typename T>
+        void WriteArray(const std::vector<T>& values) {
+            static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+            if (!values.empty()) {
+                Write(values.data(), values.size() * sizeof(T));
+            }
+        }
+
+        void Pad(size_t alignment) {
+            bytes.resize(SceneFormat::AlignSize(bytes.size(), alignment), 0);
+        }
+    };
+
+    // Deduplicated strings; index 0 is always the empty string. Holds views,
+    // the interned strings must outlive the builder.
+    class StringTableBuilder {
+    private:
+        std::unordered_map<std::string_view, uint32_t> indices;
+        std::vector<std::string_view> strings;
+
+    public:
+        StringTableBuilder() { Intern(""); }
+
+        uint32_t Intern(std::string_view value) {
+            auto it = indices.find(value);
+            if (it != indices.end()) {
+                return it->second;
+            }
+
+            uint32_t index = static_cast<uint32_t>(strings.size());
+            indices.emplace(value, index);
+            strings.push_back(value);
+            return index;
+        }
+
+        size_t GetCount() const { return strings.size(); }
+
+        void WriteTo(ByteWriter& writer) const {
+            uint32_t offset = 0;
+            for (std::string_view value : strings) {
+                writer.WritePod(offset);
+                offset += static_cast<uint32_t>(value.size());
+            }
+            writer.WritePod(offset);
+
+            for (std::string_view value : strings) {
+                writer.Write(value.data(), value.size());
+            }
+        }
+    };
+
+    struct PendingSection {
+        SceneFormat::SectionEntry entry = {};
+        ByteWriter body;
+
+        PendingSection(SceneFormat::SectionType type, uint32_t nameIndex, uint64_t count) {
+            entry.type = static_cast<uint32_t>(type);
+            entry.nameIndex = nameIndex;
+            entry.count = count;
+        }
+    };
+
+    // Component section prefix: object indices, active flags, padding to 4 bytes
+    void WriteColumnPrefix(ByteWriter& writer, const std::vector<uint32_t>& objectIndices, const std::vector<uint8_t>& activeFlags) {
+        writer.WriteArray(objectIndices);
+        writer.WriteArray(activeFlags);
+        writer.Pad(alignof(float));
+    }
+
+    size_t ColumnPrefixSize(size_t count) {
+        return SceneFormat::AlignSize(count * sizeof(uint32_t) + count, alignof(float));
+    }
+}
+
+// ===== SceneFileView =====
+
+bool SceneFileView::Open(const uint8_t* imageData, size_t imageSize) {
+    using namespace SceneFormat;
+
+    *this = SceneFileView();
+
+    if (!imageData || imageSize < sizeof(FileHeader)) {
+        std::cerr << "Scene image too small" << std::endl;
+        return false;
+    }
+
+    const FileHeader* fileHeader = reinterpret_cast<const FileHeader*>(imageData);
+    if (std::memcmp(fileHeader->magic, Magic, sizeof(Magic)) != 0) {
+        std::cerr << "Not a binary scene file" << std::endl;
+        return false;
+    }
+
+    if (fileHeader->version != Version) {
+        std::cerr << "Unsupported scene format version: " << fileHeader->version << std::endl;
+        return false;
+    }
+
+    if (fileHeader->fileSize > imageSize ||
+        sizeof(FileHeader) + static_cast<uint64_t>(fileHeader->sectionCount) * sizeof(SectionEntry) > fileHeader->fileSize) {
+        std::cerr << "Truncated scene file" << std::endl;
+        return false;
+    }
+
+    data = imageData;
+    size = static_cast<size_t>(fileHeader->fileSize);
+    sections = reinterpret_cast<const SectionEntry*>(imageData + sizeof(FileHeader));
+
+    size_t objectCount = static_cast<size_t>(fileHeader->objectCount);
+
+    for (uint32_t i = 0; i < fileHeader->sectionCount; ++i) {
+        const SectionEntry& section = sections[i];
+        if (section.offset % alignof(uint64_t) != 0 || section.offset > size || section.size > size - section.offset) {
+            std::cerr << "Scene section " << i << " out of bounds" << std::endl;
+            return false;
+        }
+
+        switch (static_cast<SectionType>(section.type)) {
+        case SectionType::Strings: {
+            // Checked before adding the end offset, so a huge count cannot wrap
+            if (section.count >= section.size / sizeof(uint32_t)) {
+                std::cerr << "Corrupt scene string table" << std::endl;
+                return false;
+            }
+            stringCount = static_cast<size_t>(section.count);
+            stringOffsets = SectionData<uint32_t>(section, 0, stringCount + 1);
+            if (!stringOffsets) return false;
+
+            size_t tableSize = (stringCount + 1) * sizeof(uint32_t);
+            stringChars = reinterpret_cast<const char*>(data + section.offset + tableSize);
+            stringBytes = static_cast<size_t>(section.size) - tableSize;
+
+            // Every string must lie inside the character data
+            for (size_t s = 0; s < stringCount; ++s) {
+                if (stringOffsets[s] > stringOffsets[s + 1]) {
+                    std::cerr << "Corrupt scene string table" << std::endl;
+                    return false;
+                }
+            }
+            if (stringOffsets[stringCount] > stringBytes) {
+                std::cerr << "Corrupt scene string table" << std::endl;
+                return false;
+            }
+            break;
+        }
+        case SectionType::Objects:
+            if (section.count != objectCount) return false;
+            objects = SectionData<ObjectRecord>(section, 0, objectCount);
+            if (!objects) return false;
+            break;
+
+        case SectionType::Components:
+            // Parsed below, field names need the string table
+            break;
+
+        case SectionType::Hierarchy:
+            if (section.count != objectCount) return false;
+            parentIndices = SectionData<int32_t>(section, 0, objectCount);
+            if (!parentIndices) return false;
+            break;
+
+        case SectionType::Tags:
+            tagCount = static_cast<size_t>(section.count);
+            tags = SectionData<TagRecord>(section, 0, tagCount);
+            if (!tags) return false;
+            {
+                size_t memberCount = 0;
+                for (size_t t = 0; t < tagCount; ++t) {
+                    if (tags[t].firstObject != memberCount) return false;
+                    memberCount += tags[t].objectCount;
+                }
+                tagObjectIndices = SectionData<uint32_t>(section, tagCount * sizeof(TagRecord), memberCount);
+                if (!tagObjectIndices) return false;
+            }
+            break;
+
+        default:
+            // Unknown sections are skipped for forward compatibility
+            break;
+        }
+    }
+
+    if (!stringOffsets || (objectCount > 0 && !objects)) {
+        std::cerr << "Scene file is missing required sections" << std::endl;
+        return false;
+    }
+
+    for (uint32_t i = 0; i < fileHeader->sectionCount; ++i) {
+        if (static_cast<SectionType>(sections[i].type) != SectionType::Components) continue;
+        if (!ParseComponentSection(sections[i], objectCount)) {
+            std::cerr << "Corrupt scene component section " << i << std::endl;
+            return false;
+        }
+    }
+
+    for (size_t i = 0; i < objectCount; ++i) {
+        if (objects[i].nameIndex >= stringCount || objects[i].tagIndex >= stringCount) {
+            std::cerr << "Corrupt scene object record: " << i << std::endl;
+            return false;
+        }
+        if (parentIndices && (parentIndices[i] < NoParent || parentIndices[i] >= static_cast<int64_t>(objectCount))) {
+            return false;
+        }
+    }
+
+    header = fileHeader;
+    return true;
+}
+
+std::string_view SceneFileView::GetString(uint32_t index) const {
+    if (index >= stringCount) {
+        return std::string_view();
+    }
+    uint32_t begin = stringOffsets[index];
+    uint32_t end = stringOffsets[index + 1];
+    if (begin > end || end > stringBytes) {
+        return std::string_view();
+    }
+    return std::string_view(stringChars + begin, end - begin);
+}
+
+const SceneComponentColumn* SceneFileView::FindComponentColumn(std::string_view typeName) const {
+    for (const SceneComponentColumn& column : componentColumns) {
+        if (column.typeName == typeName) {
+            return &column;
+        }
+    }
+    return nullptr;
+}
+
+bool SceneFileView::ParseComponentSection(const SceneFormat::SectionEntry& section, size_t objectCount) {
+    using namespace SceneFormat;
+
+    if (section.nameIndex >= stringCount) return false;
+
+    SceneComponentColumn column;
+    column.typeName = GetString(section.nameIndex);
+    column.count = static_cast<size_t>(section.count);
+    column.objectIndices = SectionData<uint32_t>(section, 0, column.count);
+    column.activeFlags = SectionData<uint8_t>(section, column.count * sizeof(uint32_t), column.count);
+    if (!column.objectIndices || !column.activeFlags) return false;
+
+    // Loaders walk columns with a cursor, indices must be strictly ascending
+    for (size_t c = 0; c < column.count; ++c) {
+        if (column.objectIndices[c] >= objectCount || (c > 0 && column.objectIndices[c] <= column.objectIndices[c - 1])) {
+            return false;
+        }
+    }
+
+    size_t offset = ColumnPrefixSize(column.count);
+    const uint32_t* fieldCount = SectionData<uint32_t>(section, offset, 1);
+    if (!fieldCount) return false;
+    offset += sizeof(uint32_t);
+
+    const FieldDescriptor* descriptors = SectionData<FieldDescriptor>(section, offset, *fieldCount);
+    if (!descriptors) return false;
+    offset += *fieldCount * sizeof(FieldDescriptor);
+
+    column.fields.reserve(*fieldCount);
+    for (uint32_t f = 0; f < *fieldCount; ++f) {
+        const FieldDescriptor& descriptor = descriptors[f];
+        if (descriptor.nameIndex >= stringCount || descriptor.size == 0 || descriptor.size > section.size) {
+            return false;
+        }
+
+        SceneFieldColumn field;
+        field.name = GetString(descriptor.nameIndex);
+        field.type = descriptor.type;
+        field.size = descriptor.size;
+        field.values = SectionData<uint8_t>(section, offset, column.count * descriptor.size);
+        if (!field.values) return false;
+        offset = AlignSize(offset + column.count * descriptor.size, alignof(float));
+
+        column.fields.push_back(field);
+    }
+
+    componentColumns.push_back(std::move(column));
+    return true;
+}
+
+template<typename T>
+const T* SceneFileView::SectionData(const SceneFormat::SectionEntry& section, size_t offset, size_t count) const {
+    if (offset > section.size || count > (section.size - offset) / sizeof(T)) {
+        std::cerr << "Scene section too small for its record count" << std::endl;
+        return nullptr;
+    }
+    return reinterpret_cast<const T*>(data + section.offset + offset);
+}
+
+// ===== SceneCapture =====
+
+void SceneCapture::Capture(const Scene& scene) {
+    using namespace SceneFormat;
+
+    Clear();
+
+    const auto& sceneObjects = scene.GetAllGameObjects();
+    size_t objectCount = sceneObjects.size();
+
+    objects.resize(objectCount);
+    names.resize(objectCount);
+    tags.resize(objectCount);
+    objectAddresses.resize(objectCount);
+    parentAddresses.resize(objectCount);
+
+    const ComponentFactory& componentFactory = ComponentFactory::GetInstance();
+    std::vector<uint64_t> componentImage;
+
+    for (size_t i = 0; i < objectCount; ++i) {
+        const GameObject* gameObject = sceneObjects[i].get();
+        uint32_t index = static_cast<uint32_t>(i);
+
+        // Names and tags are interned by Encode; assigning reuses the strings
+        ObjectRecord& record = objects[i];
+        record = {};
+        record.id = gameObject->GetId();
+        record.flags = gameObject->IsActive() ? static_cast<uint32_t>(ObjectActive) : 0u;
+        record.componentCount = static_cast<uint32_t>(gameObject->GetComponentCount());
+        names[i] = gameObject->GetName();
+        tags[i] = gameObject->GetTag();
+
+        objectAddresses[i] = gameObject;
+        parentAddresses[i] = nullptr;
+        const Transform* transform = gameObject->GetComponent<Transform>();
+        if (transform && transform->GetParent()) {
+            parentAddresses[i] = transform->GetParent()->GetOwner();
+        }
+
+        for (const auto& component : gameObject->GetAllComponents()) {
+            const Component& instance = *component;
+            const ComponentSchema* schema = componentFactory.GetSchema(std::type_index(typeid(instance)));
+            if (!schema) {
+                continue;
+            }
+
+            ComponentGroup& group = GetGroup(schema);
+            group.objectIndices.push_back(index);
+            group.activeFlags.push_back(instance.IsActive() ? 1 : 0);
+
+            if (schema->HasFields()) {
+                componentImage.resize(schema->GetImageWords());
+                schema->InitImage(componentImage.data());
+                schema->CaptureComponent(instance, componentImage.data());
+
+                const uint8_t* imageBytes = reinterpret_cast<const uint8_t*>(componentImage.data());
+                const auto& fields = schema->GetFields();
+                for (size_t f = 0; f < fields.size(); ++f) {
+                    const uint8_t* value = imageBytes + fields[f].offset;
+                    group.fieldColumns[f].insert(group.fieldColumns[f].end(), value, value + fields[f].size);
+                }
+            }
+        }
+    }
+
+    // Groups kept from an earlier capture may have gone unused
+    groups.erase(std::remove_if(groups.begin(), groups.end(), [](const ComponentGroup& group) {
+        return group.objectIndices.empty();
+        }), groups.end());
+}
+
+void SceneCapture::Clear() {
+    objects.clear();
+    objectAddresses.clear();
+    parentAddresses.clear();
+
+    // Keep the groups' columns allocated for the next capture
+    for (ComponentGroup& group : groups) {
+        group.objectIndices.clear();
+        group.activeFlags.clear();
+        for (auto& column : group.fieldColumns) {
+            column.clear();
+        }
+    }
+}
+
+size_t SceneCapture::GetComponentCount() const {
+    size_t count = 0;
+    for (const ComponentGroup& group : groups) {
+        count += group.objectIndices.size();
+    }
+    return count;
+}
+
+SceneCapture::ComponentGroup& SceneCapture::GetGroup(const ComponentSchema* schema) {
+    // Linear search, a scene has few component types
+    for (ComponentGroup& group : groups) {
+        if (group.schema == schema) {
+            return group;
+        }
+    }
+
+    groups.emplace_back();
+    groups.back().schema = schema;
+    groups.back().fieldColumns.resize(schema->GetFields().size());
+    return groups.back();
+}
+
+std::vector<uint8_t> SceneCapture::Encode(bool compress, ThreadPool* pool) const {
+    using namespace SceneFormat;
+
+    size_t objectCount = objects.size();
+
+    StringTableBuilder strings;
+    std::unordered_map<const GameObject*, uint32_t> objectIndices;
+    objectIndices.reserve(objectCount);
+
+    // Objects
+    PendingSection objectSection(SectionType::Objects, 0, objectCount);
+    objectSection.body.bytes.reserve(objectCount * sizeof(ObjectRecord));
+
+    // Tags, in first-seen order
+    std::vector<uint32_t> tagOrder;
+    std::unordered_map<uint32_t, std::vector<uint32_t>> tagMembers;
+
+    for (size_t i = 0; i < objectCount; ++i) {
+        uint32_t index = static_cast<uint32_t>(i);
+        objectIndices.emplace(objectAddresses[i], index);
+
+        ObjectRecord record = objects[i];
+        record.nameIndex = strings.Intern(names[i]);
+        record.tagIndex = strings.Intern(tags[i]);
+        objectSection.body.WritePod(record);
+
+        auto tagIt = tagMembers.find(record.tagIndex);
+        if (tagIt == tagMembers.end()) {
+            tagOrder.push_back(record.tagIndex);
+            tagIt = tagMembers.emplace(record.tagIndex, std::vector<uint32_t>()).first;
+        }
+        tagIt->second.push_back(index);
+    }
+
+    // Hierarchy (addresses are only compared, the objects may be gone by now)
+    PendingSection hierarchySection(SectionType::Hierarchy, 0, objectCount);
+    for (const GameObject* parent : parentAddresses) {
+        int32_t parentIndex = NoParent;
+        if (parent) {
+            auto it = objectIndices.find(parent);
+            if (it != objectIndices.end()) {
+                parentIndex = static_cast<int32_t>(it->second);
+            }
+        }
+        hierarchySection.body.WritePod(parentIndex);
+    }
+
+    std::vector<PendingSection> componentSections;
+
+    componentSections.reserve(groups.size());
+    for (const ComponentGroup& group : groups) {
+        const auto& fields = group.schema->GetFields();
+
+        PendingSection section(SectionType::Components, strings.Intern(group.schema->GetTypeName()), group.objectIndices.size());
+        WriteColumnPrefix(section.body, group.objectIndices, group.activeFlags);
+
+        section.body.WritePod(static_cast<uint32_t>(fields.size()));
+        for (const FieldInfo& field : fields) {
+            FieldDescriptor descriptor = {};
+            descriptor.nameIndex = strings.Intern(field.name);
+            descriptor.type = static_cast<uint32_t>(field.type);
+            descriptor.size = field.size;
+            section.body.WritePod(descriptor);
+        }
+
+        for (const auto& column : group.fieldColumns) {
+            section.body.WriteArray(column);
+            section.body.Pad(alignof(float));
+        }
+        componentSections.push_back(std::move(section));
+    }
+
+    // Tag table
+    PendingSection tagSection(SectionType::Tags, 0, tagOrder.size());
+    uint32_t firstObject = 0;
+    for (uint32_t tagIndex : tagOrder) {
+        TagRecord record = {};
+        record.tagIndex = tagIndex;
+        record.firstObject = firstObject;
+        record.objectCount = static_cast<uint32_t>(tagMembers[tagIndex].size());
+        tagSection.body.WritePod(record);
+        firstObject += record.objectCount;
+    }
+    for (uint32_t tagIndex : tagOrder) {
+        tagSection.body.WriteArray(tagMembers[tagIndex]);
+    }
+
+    // String table last, once every string is interned
+    PendingSection stringSection(SectionType::Strings, 0, strings.GetCount());
+    strings.WriteTo(stringSection.body);
+
+    std::vector<PendingSection*> ordered = { &stringSection, &objectSection };
+    for (PendingSection& section : componentSections) {
+        ordered.push_back(&section);
+    }
+    ordered.push_back(&hierarchySection);
+    ordered.push_back(&tagSection);
+
+    // Assemble: header, section table, aligned section bodies
+    size_t offset = AlignSize(sizeof(FileHeader) + ordered.size() * sizeof(SectionEntry));
+    for (PendingSection* section : ordered) {
+        section->entry.offset = offset;
+        section->entry.size = section->body.bytes.size();
+        offset = AlignSize(offset + section->body.bytes.size());
+    }
+
+    ByteWriter image;
+    image.bytes.reserve(offset);
+
+    FileHeader fileHeader = {};
+    std::memcpy(fileHeader.magic, Magic, sizeof(Magic));
+    fileHeader.version = Version;
+    fileHeader.fileSize = offset;
+    fileHeader.objectCount = objectCount;
+    fileHeader.sectionCount = static_cast<uint32_t>(ordered.size());
+    image.WritePod(fileHeader);
+
+    for (PendingSection* section : ordered) {
+        image.WritePod(section->entry);
+    }
+
+    for (PendingSection* section : ordered) {
+        image.Pad(SectionAlignment);
+        image.Write(section->body.bytes.data(), section->body.bytes.size());
+    }
+    image.Pad(SectionAlignment);
+
+    if (compress) {
+        std::vector<uint8_t> frame;
+        BlockCompression::CompressFrame(image.bytes.data(), image.bytes.size(), frame, pool);
+        return frame;
+    }
+    return std::move(image.bytes);
+}
+
+// ===== SceneSerializer =====
+
+std::vector<uint8_t> SceneSerializer::SaveToMemory(const Scene& scene, bool compress) {
+    SceneCapture capture;
+    capture.Capture(scene);
+    return capture.Encode(compress, GetThreadPool());
+}
+
+bool SceneSerializer::Save(const Scene& scene, const std::string& filepath) {
+    return Save(scene, filepath, IsCompressionEnabled());
+}
+
+bool SceneSerializer::Save(const Scene& scene, const std::string& filepath, bool compress) {
+    std::vector<uint8_t> image = SaveToMemory(scene, compress);
+    size_t imageSize = image.size();
+
+    // The image is handed to the I/O service without a copy
+    IOResult result = IOService::GetInstance().WriteFile(filepath, std::move(image)).get();
+    if (!result.success) {
+        std::cerr << "Failed to save scene to: " << filepath << " (" << std::strerror(result.error) << ")" << std::endl;
+        return false;
+    }
+
+    std::cout << "Scene saved to: " << filepath << " (" << scene.GetGameObjectCount()
+        << " objects, " << imageSize << " bytes)" << std::endl;
+    return true;
+}
+
+bool SceneSerializer::Load(Scene& scene, const std::string& filepath) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    MappedFile file;
+    if (!file.Open(filepath)) {
+        std::cerr << "Failed to load scene from: " << filepath << std::endl;
+        return false;
+    }
+
+    if (!LoadFromMemory(scene, file.GetData(), file.GetSize())) {
+        std::cerr << "Failed to load scene from: " << filepath << std::endl;
+        return false;
+    }
+
+    float loadTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    std::cout << "Scene loaded from: " << filepath << " (" << loadTime << "ms)" << std::endl;
+    return true;
+}
+
+bool SceneSerializer::Load(Scene& scene, const AssetArchive& archive, const std::string& path) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    // Stored entries load straight from the archive mapping
+    std::string_view contents;
+    std::vector<uint8_t> scratch;
+    if (!archive.GetContents(path, contents, scratch) ||
+        !LoadFromMemory(scene, reinterpret_cast<const uint8_t*>(contents.data()), contents.size())) {
+        std::cerr << "Failed to load scene " << path << " from: " << archive.GetPath() << std::endl;
+        return false;
+    }
+
+    float loadTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    std::cout << "Scene loaded from: " << archive.GetPath() << ":" << path << " (" << loadTime << "ms)" << std::endl;
+    return true;
+}
+
+bool SceneSerializer::LoadFromMemory(Scene& scene, const uint8_t* data, size_t size) {
+    SceneStreamReader reader;
+    if (!reader.OpenMemory(data, size, scene)) {
+        return false;
+    }
+    return reader.LoadAll();
+}
+
+std::vector<std::string> SceneSerializer::GetSupportedComponentTypes() {
+    const ComponentFactory& componentFactory = ComponentFactory::GetInstance();
+
+    std::vector<std::string> supported;
+    for (const std::string& typeName : componentFactory.GetRegisteredComponentNames()) {
+        if (componentFactory.GetSchema(typeName)) {
+            supported.push_back(typeName);
+        }
+    }
+    return supported;
+}
+
+void SceneSerializer::SetCompressionEnabled(bool enabled) {
+    compressionEnabled.store(enabled);
+}
+
+bool SceneSerializer::IsCompressionEnabled() {
+    return compressionEnabled.load();
+}
+
+void SceneSerializer::SetThreadPool(ThreadPool* pool) {
+    codingPool.store(pool);
+}
+
+ThreadPool* SceneSerializer::GetThreadPool() {
+    return codingPool.load();
+}
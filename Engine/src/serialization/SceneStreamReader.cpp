@@ -0,0 +1,235 @@
+#include "../include/serialization/SceneStreamReader.h"
+#include "../include/core/Scene.h"
+#include "../include/components/Transform.h"
+#include "../include/factories/ComponentFactory.h"
+#include "../include/io/BlockCompression.h"
+#include <iostream>
+#include <chrono>
+#include <cstring>
+#include <algorithm>
+
+namespace {
+    // Reading the clock costs about as much as a cheap object, so only check it periodically
+    const size_t kClockCheckInterval = 16;
+}
+
+SceneStreamReader::~SceneStreamReader() {
+    file.Close();
+}
+
+bool SceneStreamReader::Open(const std::string& filepath, const std::string& sceneName) {
+    sourceName = filepath;
+
+    if (!file.Open(filepath)) {
+        state = SceneLoadState::Failed;
+        return false;
+    }
+
+    stagingScene = std::make_unique<Scene>(sceneName);
+    return Begin(*stagingScene);
+}
+
+bool SceneStreamReader::OpenMemory(const uint8_t* data, size_t size, Scene& target) {
+    sourceName = "<memory>";
+
+    if (!OpenView(data, size)) {
+        state = SceneLoadState::Failed;
+        return false;
+    }
+
+    return Begin(target);
+}
+
+bool SceneStreamReader::OpenView(const uint8_t* data, size_t size) {
+    // Compressed scenes are expanded once up front; the loader then reads the
+    // image in place like an uncompressed file
+    if (BlockCompression::IsFrame(data, size)) {
+        if (!BlockCompression::DecompressFrame(data, size, decompressed, SceneSerializer::GetThreadPool())) {
+            std::cerr << "Corrupt compressed scene: " << sourceName << std::endl;
+            return false;
+        }
+        file.Close();
+        data = decompressed.data();
+        size = decompressed.size();
+    }
+
+    return view.Open(data, size);
+}
+
+bool SceneStreamReader::Begin(Scene& target) {
+    if (file.IsOpen() && !OpenView(file.GetData(), file.GetSize())) {
+        std::cerr << "Invalid scene file: " << sourceName << std::endl;
+        state = SceneLoadState::Failed;
+        return false;
+    }
+
+    targetScene = &target;
+    objectCount = view.GetObjectCount();
+
+    // Size every container once from the file's own tables
+    targetScene->Reserve(targetScene->GetGameObjectCount() + objectCount);
+    for (size_t i = 0; i < view.GetTagCount(); ++i) {
+        const SceneFormat::TagRecord& tag = view.GetTag(i);
+        targetScene->ReserveTag(std::string(view.GetString(tag.tagIndex)), tag.objectCount);
+    }
+
+    // Match file fields to the registered schemas once; fields that are missing
+    // or changed type keep the schema default
+    const ComponentFactory& componentFactory = ComponentFactory::GetInstance();
+    size_t imageWords = 0;
+    columns.clear();
+
+    for (const SceneComponentColumn& column : view.GetComponentColumns()) {
+        const ComponentSchema* schema = componentFactory.GetSchema(std::string(column.typeName));
+        if (!schema || column.count == 0) continue;
+
+        ColumnCursor entry;
+        entry.column = &column;
+        entry.schema = schema;
+        entry.isTransform = schema->GetTypeIndex() == std::type_index(typeid(Transform));
+
+        for (const SceneFieldColumn& fileField : column.fields) {
+            const FieldInfo* field = schema->FindField(fileField.name);
+            if (field && static_cast<uint32_t>(field->type) == fileField.type && field->size == fileField.size) {
+                entry.copies.push_back({ fileField.values, field->offset, field->size });
+            }
+        }
+
+        imageWords = std::max(imageWords, schema->GetImageWords());
+        columns.push_back(std::move(entry));
+    }
+    componentImage.assign(std::max<size_t>(imageWords, 1), 0);
+
+    loadedTransforms.assign(objectCount, nullptr);
+    state = SceneLoadState::Instantiating;
+    return true;
+}
+
+bool SceneStreamReader::Step(const SceneLoadBudget& budget) {
+    if (state == SceneLoadState::Idle) return false;
+    if (IsFinished()) return true;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    auto deadline = start + std::chrono::microseconds(budget.maxMicroseconds);
+    size_t work = 0;
+
+    auto hasBudget = [&]() {
+        if (budget.maxObjects > 0 && work >= budget.maxObjects) return false;
+        if (budget.maxMicroseconds > 0 && work > 0 && work % kClockCheckInterval == 0) {
+            return std::chrono::high_resolution_clock::now() < deadline;
+        }
+        return true;
+    };
+
+    if (state == SceneLoadState::Instantiating) {
+        while (nextObject < objectCount && hasBudget()) {
+            InstantiateObject(nextObject++);
+            work++;
+        }
+        if (nextObject == objectCount) {
+            state = SceneLoadState::Linking;
+        }
+    }
+
+    if (state == SceneLoadState::Linking) {
+        while (nextLink < objectCount && hasBudget()) {
+            LinkObject(nextLink++);
+            work++;
+        }
+        if (nextLink == objectCount) {
+            ReportSkippedColumns();
+            state = SceneLoadState::Complete;
+
+            // The mapping is no longer needed once every column has been copied
+            view = SceneFileView();
+            columns.clear();
+            loadedTransforms.clear();
+            loadedTransforms.shrink_to_fit();
+            file.Close();
+        }
+    }
+
+    float stepTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    stepCount++;
+    totalStepTime += stepTime;
+    longestStepTime = std::max(longestStepTime, stepTime);
+
+    return IsFinished();
+}
+
+bool SceneStreamReader::LoadAll() {
+    Step(SceneLoadBudget::Unlimited());
+    return IsComplete();
+}
+
+std::unique_ptr<Scene> SceneStreamReader::TakeScene() {
+    if (!IsComplete()) {
+        std::cerr << "Scene load not complete: " << sourceName << std::endl;
+        return nullptr;
+    }
+    targetScene = nullptr;
+    return std::move(stagingScene);
+}
+
+float SceneStreamReader::GetProgress() const {
+    if (IsComplete()) return 1.0f;
+    if (objectCount == 0) return 0.0f;
+
+    // Instantiation dominates the cost, linking is the last few percent
+    return 0.95f * static_cast<float>(nextObject) / objectCount +
+        0.05f * static_cast<float>(nextLink) / objectCount;
+}
+
+// Private helpers
+void SceneStreamReader::InstantiateObject(size_t index) {
+    const SceneFormat::ObjectRecord& record = view.GetObject(index);
+
+    auto gameObject = std::make_unique<GameObject>(
+        std::string(view.GetString(record.tagIndex)),
+        std::string(view.GetString(record.nameIndex)));
+
+    // Deactivate before attaching so components never see a spurious OnEnable
+    if (!(record.flags & SceneFormat::ObjectActive)) {
+        gameObject->SetActive(false);
+    }
+
+    for (ColumnCursor& entry : columns) {
+        const SceneComponentColumn& column = *entry.column;
+        if (entry.cursor >= column.count || column.objectIndices[entry.cursor] != index) continue;
+
+        // Defaults first, then every stored field straight from its column
+        uint8_t* image = reinterpret_cast<uint8_t*>(componentImage.data());
+        entry.schema->InitImage(image);
+        for (const FieldCopy& copy : entry.copies) {
+            std::memcpy(image + copy.offset, copy.values + entry.cursor * copy.size, copy.size);
+        }
+
+        Component* component = entry.schema->EmplaceComponent(*gameObject, image);
+        if (component) {
+            component->SetActive(column.activeFlags[entry.cursor] != 0);
+            if (entry.isTransform) {
+                loadedTransforms[index] = static_cast<Transform*>(component);
+            }
+        }
+        entry.cursor++;
+    }
+
+    targetScene->AddGameObject(std::move(gameObject));
+}
+
+void SceneStreamReader::LinkObject(size_t index) {
+    int32_t parentIndex = view.GetParentIndex(index);
+    if (parentIndex != SceneFormat::NoParent && loadedTransforms[index] && loadedTransforms[parentIndex]) {
+        loadedTransforms[index]->SetParent(loadedTransforms[parentIndex]);
+    }
+}
+
+void SceneStreamReader::ReportSkippedColumns() const {
+    const ComponentFactory& componentFactory = ComponentFactory::GetInstance();
+    for (const SceneComponentColumn& column : view.GetComponentColumns()) {
+        if (column.count > 0 && !componentFactory.GetSchema(std::string(column.typeName))) {
+            std::cerr << "Skipped unregistered component column: " << column.typeName
+                << " (" << column.count << " components)" << std::endl;
+        }
+    }
+}
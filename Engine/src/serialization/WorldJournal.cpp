@@ -0,0 +1,1049 @@
+#include "../include/serialization/WorldJournal.h"
+#include "../include/io/MappedFile.h"
+#include "../include/io/ParseCache.h"
+#include "../include/io/BlockCompression.h"
+#include "../include/core/Scene.h"
+#include "../include/components/Transform.h"
+#include "../include/factories/ComponentFactory.h"
+#include "../include/systems/ThreadPool.h"
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cerrno>
+#include <cstring>
+
+namespace {
+    using namespace JournalFormat;
+
+    template<typename T>
+    void Put(std::vector<uint8_t>& out, const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "Put requires trivially copyable data");
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    void PutBytes(std::vector<uint8_t>& out, const void* data, size_t size) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        out.insert(out.end(), bytes, bytes + size);
+    }
+
+    // Short name: u8 length (longer names are cut)
+    void PutShortString(std::vector<uint8_t>& out, const std::string& value) {
+        uint8_t length = static_cast<uint8_t>(std::min<size_t>(value.size(), 0xFF));
+        Put(out, length);
+        PutBytes(out, value.data(), length);
+    }
+
+    // Bounds-checked cursor over a batch payload
+    class ByteReader {
+    private:
+        const uint8_t* data;
+        size_t size;
+        size_t position = 0;
+
+    public:
+        ByteReader(const uint8_t* bytes, size_t length) : data(bytes), size(length) {}
+
+        bool AtEnd() const { return position == size; }
+
+        template<typename T>
+        bool Read(T& value) {
+            if (size - position < sizeof(T)) return false;
+            std::memcpy(&value, data + position, sizeof(T));
+            position += sizeof(T);
+            return true;
+        }
+
+        bool ReadBytes(size_t length, const uint8_t*& bytes) {
+            if (size - position < length) return false;
+            bytes = data + position;
+            position += length;
+            return true;
+        }
+
+        template<typename Length>
+        bool ReadString(std::string_view& value) {
+            Length length = 0;
+            const uint8_t* bytes = nullptr;
+            if (!Read(length) || !ReadBytes(length, bytes)) return false;
+            value = std::string_view(reinterpret_cast<const char*>(bytes), length);
+            return true;
+        }
+    };
+
+    // Applies journal records to a scene
+    class JournalReplayer {
+    private:
+        // Journal field resolved against the registered schema
+        struct ReplayField {
+            const FieldInfo* target = nullptr;  // Null: not in the schema (any more), skipped
+            uint32_t size = 0;
+        };
+
+        struct ReplayType {
+            const ComponentSchema* schema = nullptr;
+            std::vector<ReplayField> fields;
+            bool defined = false;
+        };
+
+        Scene& scene;
+        std::unordered_map<uint64_t, GameObject*> objects;
+        std::vector<ReplayType> types;
+        std::vector<uint64_t> image;
+
+        // Consecutive SetField records on one component patch one image
+        Component* patchComponent = nullptr;
+        const ComponentSchema* patchSchema = nullptr;
+
+        size_t recordCount = 0;
+
+    public:
+        explicit JournalReplayer(Scene& target) : scene(target) {}
+
+        void MapObject(uint64_t id, GameObject* gameObject) { objects[id] = gameObject; }
+        size_t GetRecordCount() const { return recordCount; }
+
+        bool ReplayBatch(const uint8_t* payload, size_t size) {
+            ByteReader reader(payload, size);
+            while (!reader.AtEnd()) {
+                uint8_t op = 0;
+                if (!reader.Read(op) || !ReplayRecord(static_cast<JournalOp>(op), reader)) {
+                    FlushPatch();
+                    return false;
+                }
+                recordCount++;
+            }
+            FlushPatch();
+            return true;
+        }
+
+    private:
+        GameObject* FindObject(uint64_t id) const {
+            auto it = objects.find(id);
+            return it != objects.end() ? it->second : nullptr;
+        }
+
+        const ReplayType* FindType(uint16_t typeId) const {
+            return typeId < types.size() && types[typeId].defined ? &types[typeId] : nullptr;
+        }
+
+        void FlushPatch() {
+            if (patchComponent) {
+                patchSchema->ApplyToComponent(*patchComponent, image.data());
+                patchComponent = nullptr;
+            }
+        }
+
+        void PrepareImage(const ComponentSchema& schema) {
+            image.resize(std::max<size_t>(schema.GetImageWords(), 1));
+            schema.InitImage(image.data());
+        }
+
+        // Field values of a component into 'image' (InitImage'd by the caller)
+        bool ReadFields(ByteReader& reader, const ReplayType& type) {
+            uint8_t* imageBytes = reinterpret_cast<uint8_t*>(image.data());
+            for (const ReplayField& field : type.fields) {
+                const uint8_t* value = nullptr;
+                if (!reader.ReadBytes(field.size, value)) return false;
+                if (field.target && type.schema) {
+                    std::memcpy(imageBytes + field.target->offset, value, field.size);
+                }
+            }
+            return true;
+        }
+
+        // u16 type, u8 active, fields; attaches the component when possible
+        bool ReadComponent(ByteReader& reader, GameObject* gameObject) {
+            uint16_t typeId = 0;
+            uint8_t active = 0;
+            if (!reader.Read(typeId) || !reader.Read(active)) return false;
+
+            const ReplayType* type = FindType(typeId);
+            if (!type) return false;
+
+            if (type->schema) {
+                PrepareImage(*type->schema);
+            }
+            if (!ReadFields(reader, *type)) return false;
+
+            if (gameObject && type->schema) {
+                Component* component = type->schema->EmplaceComponent(*gameObject, image.data());
+                if (component) {
+                    component->SetActive(active != 0);
+                }
+            }
+            return true;
+        }
+
+        bool DefineType(ByteReader& reader) {
+            uint16_t typeId = 0;
+            std::string_view typeName;
+            uint16_t fieldCount = 0;
+            if (!reader.Read(typeId) || !reader.ReadString<uint8_t>(typeName) || !reader.Read(fieldCount)) return false;
+
+            if (typeId >= types.size()) {
+                types.resize(typeId + 1);
+            }
+            ReplayType& type = types[typeId];
+            type.schema = ComponentFactory::GetInstance().GetSchema(std::string(typeName));
+            type.fields.assign(fieldCount, ReplayField());
+            type.defined = true;
+
+            if (!type.schema) {
+                std::cerr << "Journal replay: component type not registered, skipped: " << typeName << std::endl;
+            }
+
+            for (ReplayField& field : type.fields) {
+                std::string_view fieldName;
+                uint8_t fieldType = 0;
+                uint8_t fieldSize = 0;
+                if (!reader.ReadString<uint8_t>(fieldName) || !reader.Read(fieldType) || !reader.Read(fieldSize)) return false;
+
+                field.size = fieldSize;
+                const FieldInfo* target = type.schema ? type.schema->FindField(fieldName) : nullptr;
+                if (target && static_cast<uint8_t>(target->type) == fieldType && target->size == fieldSize) {
+                    field.target = target;
+                }
+            }
+            return true;
+        }
+
+        bool ReplayRecord(JournalOp op, ByteReader& reader) {
+            if (op == JournalOp::DefineType) {
+                FlushPatch();
+                return DefineType(reader);
+            }
+
+            uint64_t id = 0;
+            if (!reader.Read(id)) return false;
+
+            if (op == JournalOp::SetField) {
+                return SetField(reader, id);
+            }
+            FlushPatch();
+
+            GameObject* gameObject = FindObject(id);
+            switch (op) {
+            case JournalOp::Create: {
+                std::string_view name;
+                std::string_view tag;
+                uint8_t active = 0;
+                uint8_t componentCount = 0;
+                if (!reader.ReadString<uint16_t>(name) || !reader.ReadString<uint16_t>(tag) ||
+                    !reader.Read(active) || !reader.Read(componentCount)) return false;
+
+                auto created = std::make_unique<GameObject>(std::string(tag), std::string(name));
+
+                // Deactivate before attaching so components never see a spurious OnEnable
+                if (!active) {
+                    created->SetActive(false);
+                }
+                for (uint8_t i = 0; i < componentCount; ++i) {
+                    if (!ReadComponent(reader, created.get())) return false;
+                }
+
+                objects[id] = created.get();
+                scene.AddGameObject(std::move(created));
+                return true;
+            }
+
+            case JournalOp::Destroy:
+                if (gameObject) {
+                    objects.erase(id);
+                    scene.DestroyGameObject(gameObject);
+                }
+                return true;
+
+            case JournalOp::SetActive: {
+                uint8_t active = 0;
+                if (!reader.Read(active)) return false;
+                if (gameObject) {
+                    gameObject->SetActive(active != 0);
+                }
+                return true;
+            }
+
+            case JournalOp::SetParent: {
+                uint64_t parentId = 0;
+                if (!reader.Read(parentId)) return false;
+
+                Transform* transform = gameObject ? gameObject->GetComponent<Transform>() : nullptr;
+                GameObject* parent = parentId != 0 ? FindObject(parentId) : nullptr;
+                if (transform) {
+                    transform->SetParent(parent ? parent->GetComponent<Transform>() : nullptr);
+                }
+                return true;
+            }
+
+            case JournalOp::SetTag:
+            case JournalOp::SetName: {
+                std::string_view value;
+                if (!reader.ReadString<uint16_t>(value)) return false;
+                if (gameObject) {
+                    if (op == JournalOp::SetTag) {
+                        gameObject->SetTag(std::string(value));
+                    }
+                    else {
+                        gameObject->SetName(std::string(value));
+                    }
+                }
+                return true;
+            }
+
+            case JournalOp::AddComponent:
+                return ReadComponent(reader, gameObject);
+
+            case JournalOp::RemoveComponent:
+            case JournalOp::SetComponentActive: {
+                uint16_t typeId = 0;
+                uint8_t active = 0;
+                if (!reader.Read(typeId)) return false;
+                if (op == JournalOp::SetComponentActive && !reader.Read(active)) return false;
+
+                const ReplayType* type = FindType(typeId);
+                if (!type) return false;
+
+                Component* component = gameObject && type->schema ?
+                    gameObject->GetComponent(type->schema->GetTypeIndex()) : nullptr;
+                if (component) {
+                    if (op == JournalOp::RemoveComponent) {
+                        gameObject->RemoveComponent(component);
+                    }
+                    else {
+                        component->SetActive(active != 0);
+                    }
+                }
+                return true;
+            }
+
+            default:
+                return false;
+            }
+        }
+
+        bool SetField(ByteReader& reader, uint64_t id) {
+            uint16_t typeId = 0;
+            uint16_t fieldIndex = 0;
+            if (!reader.Read(typeId) || !reader.Read(fieldIndex)) return false;
+
+            const ReplayType* type = FindType(typeId);
+            if (!type || fieldIndex >= type->fields.size()) return false;
+
+            const ReplayField& field = type->fields[fieldIndex];
+            const uint8_t* value = nullptr;
+            if (!reader.ReadBytes(field.size, value)) return false;
+            if (!field.target) return true;
+
+            GameObject* gameObject = FindObject(id);
+            Component* component = gameObject ? gameObject->GetComponent(type->schema->GetTypeIndex()) : nullptr;
+            if (!component) return true;
+
+            if (component != patchComponent) {
+                FlushPatch();
+                PrepareImage(*type->schema);
+                type->schema->CaptureComponent(*component, image.data());
+                patchComponent = component;
+                patchSchema = type->schema;
+            }
+
+            std::memcpy(reinterpret_cast<uint8_t*>(image.data()) + field.target->offset, value, field.size);
+            return true;
+        }
+    };
+}
+
+// ===== TrackedState =====
+
+void WorldJournal::TrackedState::Clear() {
+    // Objects are resized by the scan, keeping their strings allocated
+    components.clear();
+    images.clear();
+    indices.clear();
+    indexed = false;
+}
+
+void WorldJournal::TrackedState::Index() {
+    if (indexed) return;
+
+    indices.clear();
+    indices.reserve(objects.size());
+    for (size_t i = 0; i < objects.size(); ++i) {
+        indices.emplace(objects[i].id, i);
+    }
+    indexed = true;
+}
+
+// ===== WorldJournal =====
+
+WorldJournal::~WorldJournal() {
+    Close();
+}
+
+bool WorldJournal::Open(const Scene& scene, const WorldJournalConfig& journalConfig, uint64_t frameNumber) {
+    Close();
+
+    config = journalConfig;
+    config.syncIntervalFrames = std::max<size_t>(config.syncIntervalFrames, 1);
+    open = true;
+
+    journalBytes = 0;
+    totalBatches = 0;
+    totalRecords = 0;
+    checkpointCount = 0;
+    writeErrors = 0;
+    durableFrame = 0;
+    journalStarted = false;
+
+    // The first checkpoint is written before returning, so a successful Open
+    // always leaves something to recover from
+    Checkpoint(scene, frameNumber);
+    Flush(true);
+
+    if (writeErrors > 0) {
+        std::cerr << "Failed to open world journal: " << config.journalPath << std::endl;
+        Close();
+        return false;
+    }
+
+    std::cout << "World journal opened: " << config.journalPath << " (" << current.objects.size()
+        << " objects, snapshot " << config.snapshotPath << ")" << std::endl;
+    return true;
+}
+
+void WorldJournal::Close() {
+    if (!open) return;
+
+    Flush(true);
+    open = false;
+
+    current.objects.clear();
+    current.Clear();
+    next.objects.clear();
+    next.Clear();
+    typeIds.clear();
+    records.clear();
+    recordCount = 0;
+    checkpointCapture.Clear();
+}
+
+void WorldJournal::RecordFrame(const Scene& scene, uint64_t frameNumber) {
+    if (!open) return;
+
+    PumpIO(false);
+
+    Scan(scene, true);
+    if (recordCount > 0) {
+        AppendBatch(frameNumber);
+    }
+
+    if (++framesSinceSync >= config.syncIntervalFrames && hasUnsynced) {
+        RequestSync();
+    }
+
+    bool checkpointDue =
+        (config.checkpointIntervalFrames > 0 && frameNumber - lastCheckpointFrame >= config.checkpointIntervalFrames) ||
+        (config.maxJournalBytes > 0 && journalBytes >= config.maxJournalBytes);
+    if (checkpointDue && !checkpointImage.valid()) {
+        Checkpoint(scene, frameNumber);
+    }
+
+    PumpIO(false);
+}
+
+void WorldJournal::Checkpoint(const Scene& scene, uint64_t frameNumber) {
+    if (!open) return;
+
+    // One checkpoint encodes at a time (they share the capture)
+    if (checkpointImage.valid()) {
+        StartCheckpointWrites(checkpointImage.get());
+    }
+
+    // The snapshot holds everything up to now and the new journal starts
+    // empty, but changes since the last frame also go to the current journal,
+    // which stays in use if the snapshot cannot be written
+    Scan(scene, journalStarted);
+    if (journalStarted && recordCount > 0) {
+        AppendBatch(frameNumber);
+    }
+    records.clear();
+    recordCount = 0;
+    typeIds.clear();
+
+    checkpointCapture.Capture(scene);
+    checkpointFrame = frameNumber;
+    lastCheckpointFrame = frameNumber;
+    checkpointTail.clear();
+    checkpointTailFrame = frameNumber;
+    replacedJournalBytes = journalBytes;
+    journalBytes = 0;
+
+    bool compress = config.compressSnapshots;
+    if (threadPool) {
+        // The pool only encodes; compression stays on that one worker
+        checkpointImage = threadPool->Enqueue([this, compress]() {
+            return checkpointCapture.Encode(compress);
+            });
+    }
+    else {
+        StartCheckpointWrites(checkpointCapture.Encode(compress));
+    }
+}
+
+void WorldJournal::Flush(bool sync) {
+    if (!open) return;
+
+    if (sync && hasUnsynced) {
+        RequestSync();
+    }
+    PumpIO(true);
+}
+
+// ===== Scanning =====
+
+void WorldJournal::Scan(const Scene& scene, bool emit) {
+    const auto& sceneObjects = scene.GetAllGameObjects();
+    size_t objectCount = sceneObjects.size();
+
+    // Schemas are looked up once per type and scan (registrations may change between scans)
+    schemaCache.clear();
+    transformSchema = ComponentFactory::GetInstance().GetSchema(std::type_index(typeid(Transform)));
+
+    next.Clear();
+    next.objects.resize(objectCount);
+    seen.assign(current.objects.size(), 0);
+    parentChanges.clear();
+
+    for (size_t i = 0; i < objectCount; ++i) {
+        const GameObject& gameObject = *sceneObjects[i];
+        uint64_t id = gameObject.GetId();
+
+        // Objects usually keep their position in the scene between frames
+        const TrackedObject* previous = nullptr;
+        if (i < current.objects.size() && current.objects[i].id == id) {
+            previous = &current.objects[i];
+            seen[i] = 1;
+        }
+        else {
+            current.Index();
+            auto it = current.indices.find(id);
+            if (it != current.indices.end()) {
+                previous = &current.objects[it->second];
+                seen[it->second] = 1;
+            }
+        }
+
+        TrackedObject& tracked = next.objects[i];
+        tracked.id = id;
+        tracked.active = gameObject.IsActive();
+
+        if (emit && previous) {
+            if (tracked.active != previous->active) {
+                BeginRecord(JournalOp::SetActive, id);
+                Put(records, static_cast<uint8_t>(tracked.active));
+            }
+            if (gameObject.GetTag() != previous->tag) {
+                BeginRecord(JournalOp::SetTag, id);
+                WriteString(gameObject.GetTag());
+            }
+            if (gameObject.GetName() != previous->name) {
+                BeginRecord(JournalOp::SetName, id);
+                WriteString(gameObject.GetName());
+            }
+        }
+        tracked.name = gameObject.GetName();
+        tracked.tag = gameObject.GetTag();
+
+        // Also reads the parent from the Transform
+        ScanComponents(gameObject, previous, tracked, emit);
+
+        // Parents are linked after the loop, once every new object exists
+        if (emit && tracked.parentId != (previous ? previous->parentId : 0)) {
+            parentChanges.emplace_back(id, tracked.parentId);
+        }
+    }
+
+    if (emit) {
+        for (const auto& change : parentChanges) {
+            BeginRecord(JournalOp::SetParent, change.first);
+            Put(records, change.second);
+        }
+
+        // Destroyed last, after children were moved away from them
+        for (size_t i = 0; i < current.objects.size(); ++i) {
+            if (!seen[i]) {
+                BeginRecord(JournalOp::Destroy, current.objects[i].id);
+            }
+        }
+    }
+
+    std::swap(current, next);
+}
+
+void WorldJournal::ScanComponents(const GameObject& gameObject, const TrackedObject* previous, TrackedObject& tracked, bool emit) {
+    tracked.firstComponent = static_cast<uint32_t>(next.components.size());
+    tracked.componentCount = 0;
+    tracked.parentId = 0;
+
+    // Capture the current state
+    for (const auto& component : gameObject.GetAllComponents()) {
+        const Component& instance = *component;
+        const ComponentSchema* schema = FindSchema(instance);
+        if (!schema) continue;
+
+        if (schema == transformSchema) {
+            const Transform* parent = static_cast<const Transform&>(instance).GetParent();
+            if (parent && parent->GetOwner()) {
+                tracked.parentId = parent->GetOwner()->GetId();
+            }
+        }
+
+        TrackedComponent entry;
+        entry.schema = schema;
+        entry.active = instance.IsActive();
+        entry.imageOffset = next.images.size();
+        next.images.resize(next.images.size() + schema->GetImageWords());
+        if (schema->HasFields()) {
+            uint64_t* image = next.images.data() + entry.imageOffset;
+            schema->InitImage(image);
+            schema->CaptureComponent(instance, image);
+        }
+
+        next.components.push_back(entry);
+        tracked.componentCount++;
+    }
+
+    if (!emit) return;
+
+    const TrackedComponent* components = next.components.data() + tracked.firstComponent;
+    const auto imageOf = [](const TrackedState& state, const TrackedComponent& component) {
+        return reinterpret_cast<const uint8_t*>(state.images.data() + component.imageOffset);
+        };
+
+    if (!previous) {
+        // Types are defined before the record that uses them
+        for (uint32_t k = 0; k < tracked.componentCount; ++k) {
+            GetTypeId(components[k].schema);
+        }
+
+        BeginRecord(JournalOp::Create, tracked.id);
+        WriteString(tracked.name);
+        WriteString(tracked.tag);
+        Put(records, static_cast<uint8_t>(tracked.active));
+        Put(records, static_cast<uint8_t>(std::min<uint32_t>(tracked.componentCount, 0xFF)));
+        for (uint32_t k = 0; k < tracked.componentCount && k < 0xFF; ++k) {
+            WriteComponent(components[k], imageOf(next, components[k]));
+        }
+        return;
+    }
+
+    const TrackedComponent* previousComponents = current.components.data() + previous->firstComponent;
+    size_t matched = 0;
+
+    for (uint32_t k = 0; k < tracked.componentCount; ++k) {
+        const TrackedComponent& component = components[k];
+        const ComponentSchema* schema = component.schema;
+
+        // Same slot in the common case, otherwise search
+        const TrackedComponent* before = nullptr;
+        if (k < previous->componentCount && previousComponents[k].schema == schema) {
+            before = &previousComponents[k];
+        }
+        else {
+            for (uint32_t p = 0; p < previous->componentCount; ++p) {
+                if (previousComponents[p].schema == schema) {
+                    before = &previousComponents[p];
+                    break;
+                }
+            }
+        }
+
+        if (!before) {
+            GetTypeId(schema);
+            BeginRecord(JournalOp::AddComponent, tracked.id);
+            WriteComponent(component, imageOf(next, component));
+            continue;
+        }
+        matched++;
+
+        if (component.active != before->active) {
+            uint16_t typeId = GetTypeId(schema);
+            BeginRecord(JournalOp::SetComponentActive, tracked.id);
+            Put(records, typeId);
+            Put(records, static_cast<uint8_t>(component.active));
+        }
+
+        // Whole image first, fields only when something changed
+        const uint8_t* oldImage = imageOf(current, *before);
+        const uint8_t* newImage = imageOf(next, component);
+        if (!schema->HasFields() || std::memcmp(oldImage, newImage, schema->GetImageSize()) == 0) {
+            continue;
+        }
+
+        const auto& fields = schema->GetFields();
+        for (size_t f = 0; f < fields.size(); ++f) {
+            const FieldInfo& field = fields[f];
+            if (std::memcmp(oldImage + field.offset, newImage + field.offset, field.size) == 0) continue;
+
+            uint16_t typeId = GetTypeId(schema);
+            BeginRecord(JournalOp::SetField, tracked.id);
+            Put(records, typeId);
+            Put(records, static_cast<uint16_t>(f));
+            PutBytes(records, newImage + field.offset, field.size);
+        }
+    }
+
+    if (matched < previous->componentCount) {
+        for (uint32_t p = 0; p < previous->componentCount; ++p) {
+            const ComponentSchema* schema = previousComponents[p].schema;
+            bool kept = std::any_of(components, components + tracked.componentCount, [schema](const TrackedComponent& component) {
+                return component.schema == schema;
+                });
+            if (!kept) {
+                uint16_t typeId = GetTypeId(schema);
+                BeginRecord(JournalOp::RemoveComponent, tracked.id);
+                Put(records, typeId);
+            }
+        }
+    }
+}
+
+const ComponentSchema* WorldJournal::FindSchema(const Component& component) {
+    const std::type_info* type = &typeid(component);
+    for (const auto& entry : schemaCache) {
+        if (entry.first == type) {
+            return entry.second;
+        }
+    }
+
+    const ComponentSchema* schema = ComponentFactory::GetInstance().GetSchema(std::type_index(*type));
+    schemaCache.emplace_back(type, schema);
+    return schema;
+}
+
+// ===== Record encoding =====
+
+uint16_t WorldJournal::GetTypeId(const ComponentSchema* schema) {
+    auto it = typeIds.find(schema);
+    if (it != typeIds.end()) {
+        return it->second;
+    }
+
+    uint16_t typeId = static_cast<uint16_t>(typeIds.size());
+    typeIds.emplace(schema, typeId);
+
+    const auto& fields = schema->GetFields();
+    Put(records, static_cast<uint8_t>(JournalOp::DefineType));
+    Put(records, typeId);
+    PutShortString(records, schema->GetTypeName());
+    Put(records, static_cast<uint16_t>(fields.size()));
+    for (const FieldInfo& field : fields) {
+        PutShortString(records, field.name);
+        Put(records, static_cast<uint8_t>(field.type));
+        Put(records, static_cast<uint8_t>(field.size));
+    }
+    recordCount++;
+    return typeId;
+}
+
+void WorldJournal::BeginRecord(JournalOp op, uint64_t objectId) {
+    Put(records, static_cast<uint8_t>(op));
+    Put(records, objectId);
+    recordCount++;
+}
+
+void WorldJournal::WriteComponent(const TrackedComponent& component, const uint8_t* image) {
+    Put(records, GetTypeId(component.schema));
+    Put(records, static_cast<uint8_t>(component.active));
+    for (const FieldInfo& field : component.schema->GetFields()) {
+        PutBytes(records, image + field.offset, field.size);
+    }
+}
+
+void WorldJournal::WriteString(const std::string& value) {
+    uint16_t length = static_cast<uint16_t>(std::min<size_t>(value.size(), 0xFFFF));
+    Put(records, length);
+    PutBytes(records, value.data(), length);
+}
+
+// ===== Batches and ordered I/O =====
+
+void WorldJournal::AppendBatch(uint64_t frameNumber) {
+    JournalBatchHeader header = {};
+    header.magic = BatchMagic;
+    header.payloadSize = static_cast<uint32_t>(records.size());
+    header.frame = frameNumber;
+    header.payloadHash = ParseCache::HashBytes(records.data(), records.size(), frameNumber);
+
+    std::vector<uint8_t> batch;
+    batch.reserve(sizeof(header) + records.size());
+    Put(batch, header);
+    PutBytes(batch, records.data(), records.size());
+
+    totalBatches++;
+    totalRecords += recordCount;
+    lastBatchFrame = frameNumber;
+    records.clear();
+    recordCount = 0;
+
+    // While a checkpoint encodes, batches belong to the journal that follows it
+    if (checkpointImage.valid()) {
+        checkpointTail.insert(checkpointTail.end(), batch.begin(), batch.end());
+        checkpointTailFrame = frameNumber;
+        journalBytes += batch.size();
+        return;
+    }
+    QueueAppend(std::move(batch), frameNumber);
+}
+
+void WorldJournal::QueueAppend(std::vector<uint8_t> bytes, uint64_t lastFrame) {
+    journalBytes += bytes.size();
+    hasUnsynced = true;
+
+    // Merge into an append that has not been submitted yet
+    if (!ioQueue.empty() && ioQueue.back().request.type == IORequest::Type::Append) {
+        IOStep& step = ioQueue.back();
+        step.request.data.insert(step.request.data.end(), bytes.begin(), bytes.end());
+        step.lastFrame = lastFrame;
+        return;
+    }
+
+    IOStep step;
+    step.request = IORequest::Append(config.journalPath, std::move(bytes));
+    step.lastFrame = lastFrame;
+    ioQueue.push_back(std::move(step));
+}
+
+void WorldJournal::RequestSync() {
+    framesSinceSync = 0;
+    hasUnsynced = false;
+
+    if (ioQueue.empty() || ioQueue.back().request.type != IORequest::Type::Append) {
+        IOStep step;
+        step.request = IORequest::Append(config.journalPath, std::vector<uint8_t>());
+        step.lastFrame = lastBatchFrame;
+        ioQueue.push_back(std::move(step));
+    }
+    ioQueue.back().request.sync = true;
+}
+
+void WorldJournal::StartCheckpointWrites(std::vector<uint8_t> image) {
+    JournalHeader header = {};
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = Version;
+    header.snapshotHash = ParseCache::HashBytes(image.data(), image.size());
+    header.snapshotSize = image.size();
+    header.snapshotFrame = checkpointFrame;
+
+    // Snapshot first (synced, then renamed over the old one)...
+    IOStep snapshotStep;
+    snapshotStep.request = IORequest::Write(config.snapshotPath + ".tmp", std::move(image));
+    snapshotStep.request.sync = true;
+    snapshotStep.renameTo = config.snapshotPath;
+    snapshotStep.lastFrame = checkpointFrame;
+    snapshotStep.snapshot = true;
+    ioQueue.push_back(std::move(snapshotStep));
+
+    // ...then the journal that follows it, with what was recorded meanwhile
+    std::vector<uint8_t> journal;
+    journal.reserve(sizeof(header) + checkpointTail.size());
+    Put(journal, header);
+    PutBytes(journal, checkpointTail.data(), checkpointTail.size());
+    journalBytes = journal.size();
+
+    IOStep journalStep;
+    journalStep.request = IORequest::Write(config.journalPath, std::move(journal));
+    journalStep.request.sync = true;
+    journalStep.lastFrame = checkpointTailFrame;
+    journalStep.newJournal = true;
+    journalStep.previousJournalBytes = replacedJournalBytes;
+    ioQueue.push_back(std::move(journalStep));
+
+    checkpointTail.clear();
+    checkpointCount++;
+    framesSinceSync = 0;
+    hasUnsynced = false;
+}
+
+void WorldJournal::PumpIO(bool wait) {
+    const auto isReady = [](const auto& future) {
+        return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        };
+
+    while (true) {
+        if (checkpointImage.valid() && (wait || isReady(checkpointImage))) {
+            StartCheckpointWrites(checkpointImage.get());
+        }
+
+        if (ioInFlight.valid()) {
+            if (!wait && !isReady(ioInFlight)) return;
+
+            IOResult result = ioInFlight.get();
+            if (result.success && !ioRenameTo.empty() && std::rename(result.path.c_str(), ioRenameTo.c_str()) != 0) {
+                result.success = false;
+                result.error = errno;
+            }
+
+            if (!result.success) {
+                writeErrors++;
+                std::cerr << "World journal write failed: " << result.path << " (" << std::strerror(result.error)
+                    << ")" << std::endl;
+                if (ioSnapshot) {
+                    KeepJournalAfterFailedSnapshot();
+                }
+            }
+            else {
+                if (ioSyncing) {
+                    durableFrame = std::max(durableFrame, ioLastFrame);
+                }
+                if (ioNewJournal) {
+                    journalStarted = true;
+                }
+            }
+        }
+
+        if (ioQueue.empty()) return;
+
+        IOStep step = std::move(ioQueue.front());
+        ioQueue.pop_front();
+        ioRenameTo = step.renameTo;
+        ioLastFrame = step.lastFrame;
+        ioSyncing = step.request.sync;
+        ioSnapshot = step.snapshot;
+        ioNewJournal = step.newJournal;
+
+        std::vector<IORequest> requests;
+        requests.push_back(std::move(step.request));
+        ioInFlight = std::move(IOService::GetInstance().Submit(std::move(requests)).front());
+    }
+}
+
+void WorldJournal::KeepJournalAfterFailedSnapshot() {
+    // The journal step queued right behind the snapshot would replace a
+    // journal that still follows the old snapshot on disk
+    if (ioQueue.empty() || !ioQueue.front().newJournal) return;
+
+    IOStep& step = ioQueue.front();
+    if (!journalStarted) {
+        // Nothing of this session to keep (first checkpoint of Open)
+        ioQueue.pop_front();
+        return;
+    }
+
+    // Append what was recorded since the checkpoint to the old journal
+    // instead; its type definitions restart, which replay allows
+    std::vector<uint8_t> tail(step.request.data.begin() + sizeof(JournalHeader), step.request.data.end());
+    journalBytes += step.previousJournalBytes - sizeof(JournalHeader);
+    step.request = IORequest::Append(config.journalPath, std::move(tail));
+    step.request.sync = true;
+    step.newJournal = false;
+
+    // Retry when the checkpoint is next due
+    checkpointCount--;
+    std::cerr << "World checkpoint failed, keeping the current journal: " << config.journalPath << std::endl;
+}
+
+// ===== Recovery =====
+
+bool WorldJournal::Recover(Scene& scene, const std::string& snapshotPath, const std::string& journalPath,
+    JournalReplayStats* stats) {
+    JournalReplayStats result;
+    auto start = std::chrono::high_resolution_clock::now();
+
+    MappedFile snapshotFile;
+    if (!snapshotFile.Open(snapshotPath)) {
+        std::cerr << "World recovery failed, no snapshot: " << snapshotPath << std::endl;
+        return false;
+    }
+
+    // Expand a compressed snapshot once; the view and the loader share it
+    const uint8_t* image = snapshotFile.GetData();
+    size_t imageSize = snapshotFile.GetSize();
+    std::vector<uint8_t> expanded;
+    if (BlockCompression::IsFrame(image, imageSize)) {
+        if (!BlockCompression::DecompressFrame(image, imageSize, expanded, SceneSerializer::GetThreadPool())) {
+            std::cerr << "World recovery failed, corrupt snapshot: " << snapshotPath << std::endl;
+            return false;
+        }
+        image = expanded.data();
+        imageSize = expanded.size();
+    }
+
+    SceneFileView view;
+    size_t firstObject = scene.GetGameObjectCount();
+    if (!view.Open(image, imageSize) || !SceneSerializer::LoadFromMemory(scene, image, imageSize) ||
+        scene.GetGameObjectCount() - firstObject != view.GetObjectCount()) {
+        std::cerr << "World recovery failed, unreadable snapshot: " << snapshotPath << std::endl;
+        return false;
+    }
+
+    // Journal records name objects by their IDs at snapshot time
+    JournalReplayer replayer(scene);
+    const auto& sceneObjects = scene.GetAllGameObjects();
+    for (size_t i = 0; i < view.GetObjectCount(); ++i) {
+        replayer.MapObject(view.GetObject(i).id, sceneObjects[firstObject + i].get());
+    }
+
+    result.snapshotLoaded = true;
+    result.snapshotObjects = view.GetObjectCount();
+    auto loaded = std::chrono::high_resolution_clock::now();
+    result.snapshotLoadTime = std::chrono::duration<float, std::milli>(loaded - start).count();
+
+    MappedFile journalFile;
+    const JournalHeader* header = nullptr;
+    if (journalFile.Open(journalPath) && journalFile.GetSize() >= sizeof(JournalHeader)) {
+        header = reinterpret_cast<const JournalHeader*>(journalFile.GetData());
+        bool matches = std::memcmp(header->magic, Magic, sizeof(Magic)) == 0 && header->version == Version &&
+            header->snapshotSize == snapshotFile.GetSize() &&
+            header->snapshotHash == ParseCache::HashBytes(snapshotFile.GetData(), snapshotFile.GetSize());
+        if (!matches) {
+            // Crash between writing a snapshot and its journal: the snapshot is newer
+            std::cerr << "World journal does not follow the snapshot, ignored: " << journalPath << std::endl;
+            header = nullptr;
+        }
+    }
+
+    if (header) {
+        result.journalUsed = true;
+        result.snapshotFrame = header->snapshotFrame;
+        result.lastFrame = header->snapshotFrame;
+
+        const uint8_t* data = journalFile.GetData();
+        size_t size = journalFile.GetSize();
+        size_t position = sizeof(JournalHeader);
+
+        while (position < size) {
+            JournalBatchHeader batch;
+            if (size - position < sizeof(batch)) {
+                result.tornTail = true;
+                break;
+            }
+            std::memcpy(&batch, data + position, sizeof(batch));
+            position += sizeof(batch);
+
+            const uint8_t* payload = data + position;
+            if (batch.magic != BatchMagic || size - position < batch.payloadSize ||
+                ParseCache::HashBytes(payload, batch.payloadSize, batch.frame) != batch.payloadHash ||
+                !replayer.ReplayBatch(payload, batch.payloadSize)) {
+                result.tornTail = true;
+                break;
+            }
+            position += batch.payloadSize;
+
+            result.batches++;
+            result.lastFrame = batch.frame;
+        }
+        result.records = replayer.GetRecordCount();
+    }
+
+    result.replayTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - loaded).count();
+
+    std::cout << "World recovered: " << result.snapshotObjects << " objects from " << snapshotPath << " ("
+        << result.snapshotLoadTime << "ms), " << result.batches << " journal batches / " << result.records
+        << " records (" << result.replayTime << "ms)" << (result.tornTail ? ", torn tail dropped" : "") << std::endl;
+
+    if (stats) {
+        *stats = result;
+    }
+    return true;
+}
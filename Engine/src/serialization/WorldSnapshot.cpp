@@ -0,0 +1,517 @@
+#include "../include/serialization/WorldSnapshot.h"
+#include "../include/core/Scene.h"
+#include "../include/factories/ComponentFactory.h"
+#include "../include/io/BlockCompression.h"
+#include <iostream>
+#include <cstring>
+#include <algorithm>
+#include <typeindex>
+
+namespace {
+    // Encoded layout (native endianness):
+    //   char magic[4] | uint32 flags | uint64 frame | uint32 objectCount | uint32 wordCount
+    //   keyframes only: uint64 objectIds[objectCount] | uint32 setCount
+    //                   | per set: uint32 wordsPerObject | uint32 nameLength | char name[nameLength]
+    //   tokens until wordCount words are covered:
+    //     varint zeroRun | varint literalCount | uint32 literals[literalCount]
+    // With kCompressedFlag everything after the header is one BlockCompression frame.
+    const char kSnapshotMagic[4] = { 'W', 'S', 'N', 'P' };
+    const uint32_t kKeyframeFlag = 1 << 0;
+    const uint32_t kCompressedFlag = 1 << 1;
+    const size_t kHeaderSize = 4 + sizeof(uint32_t) + sizeof(uint64_t) + 2 * sizeof(uint32_t);
+
+    const size_t kNoSet = static_cast<size_t>(-1);
+
+    size_t FindSetIndex(const std::vector<WorldSnapshot::ColumnSet>& sets, const ComponentSchema* schema) {
+        // Linear search, a scene has few component types
+        for (size_t i = 0; i < sets.size(); ++i) {
+            if (sets[i].schema == schema) {
+                return i;
+            }
+        }
+        return kNoSet;
+    }
+
+    template<typename T>
+    void AppendPod(std::vector<uint8_t>& out, const T& value) {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    template<typename T>
+    bool ReadPod(const uint8_t* data, size_t size, size_t& offset, T& value) {
+        if (offset + sizeof(T) > size) return false;
+        std::memcpy(&value, data + offset, sizeof(T));
+        offset += sizeof(T);
+        return true;
+    }
+
+    void AppendVarint(std::vector<uint8_t>& out, size_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    bool ReadVarint(const uint8_t* data, size_t size, size_t& offset, size_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (offset >= size) return false;
+            uint8_t byte = data[offset++];
+            value |= static_cast<size_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return true;
+        }
+        return false;
+    }
+
+    // Zero-run / literal-run encoding of (words XOR base)
+    void EncodeWords(const uint32_t* words, const uint32_t* base, size_t count, std::vector<uint8_t>& out) {
+        size_t i = 0;
+        while (i < count) {
+            size_t zeroStart = i;
+            while (i < count && (words[i] ^ (base ? base[i] : 0)) == 0) i++;
+            size_t zeroRun = i - zeroStart;
+
+            size_t literalStart = i;
+            while (i < count && (words[i] ^ (base ? base[i] : 0)) != 0) i++;
+            size_t literalCount = i - literalStart;
+
+            AppendVarint(out, zeroRun);
+            AppendVarint(out, literalCount);
+
+            size_t offset = out.size();
+            out.resize(offset + literalCount * sizeof(uint32_t));
+            for (size_t j = 0; j < literalCount; ++j) {
+                uint32_t delta = words[literalStart + j] ^ (base ? base[literalStart + j] : 0);
+                std::memcpy(out.data() + offset + j * sizeof(uint32_t), &delta, sizeof(uint32_t));
+            }
+        }
+    }
+
+    bool DecodeWords(const uint8_t* data, size_t size, size_t& offset, const uint32_t* base, uint32_t* words, size_t count) {
+        size_t i = 0;
+        while (i < count) {
+            size_t zeroRun = 0, literalCount = 0;
+            if (!ReadVarint(data, size, offset, zeroRun) || !ReadVarint(data, size, offset, literalCount)) return false;
+            if (zeroRun > count - i || literalCount > count - i - zeroRun) return false;
+            if (literalCount * sizeof(uint32_t) > size - offset) return false;
+
+            for (size_t j = 0; j < zeroRun; ++j, ++i) {
+                words[i] = base ? base[i] : 0;
+            }
+            for (size_t j = 0; j < literalCount; ++j, ++i) {
+                uint32_t delta;
+                std::memcpy(&delta, data + offset, sizeof(delta));
+                offset += sizeof(delta);
+                words[i] = delta ^ (base ? base[i] : 0);
+            }
+        }
+        return true;
+    }
+}
+
+// ===== WorldSnapshot =====
+
+void WorldSnapshot::Capture(const Scene& scene, uint64_t frameNumber) {
+    const auto& objects = scene.GetAllGameObjects();
+    size_t count = objects.size();
+    const ComponentFactory& componentFactory = ComponentFactory::GetInstance();
+
+    frame = frameNumber;
+
+    // One column set per schema with fields, in type name order so the
+    // layout stays put from frame to frame
+    columnSets.clear();
+    for (const auto& gameObject : objects) {
+        for (const auto& component : gameObject->GetAllComponents()) {
+            const Component& instance = *component;
+            const ComponentSchema* schema = componentFactory.GetSchema(std::type_index(typeid(instance)));
+            if (!schema || !schema->HasFields() || FindSetIndex(columnSets, schema) != kNoSet) {
+                continue;
+            }
+
+            ColumnSet set;
+            set.schema = schema;
+            set.typeName = schema->GetTypeName();
+            set.wordsPerObject = static_cast<uint32_t>((schema->GetImageSize() + sizeof(uint32_t) - 1) / sizeof(uint32_t));
+            columnSets.push_back(std::move(set));
+        }
+    }
+    std::sort(columnSets.begin(), columnSets.end(), [](const ColumnSet& left, const ColumnSet& right) {
+        return left.typeName < right.typeName;
+        });
+
+    LayoutColumns();
+    Resize(count);
+    std::fill(stateWords.begin(), stateWords.end(), 0);
+
+    std::vector<uint64_t> componentImage;
+
+    for (size_t i = 0; i < count; ++i) {
+        const GameObject* gameObject = objects[i].get();
+        objectIds[i] = gameObject->GetId();
+        stateWords[i] = gameObject->IsActive() ? static_cast<uint32_t>(ObjectActive) : 0u;
+
+        for (const auto& component : gameObject->GetAllComponents()) {
+            const Component& instance = *component;
+            const ComponentSchema* schema = componentFactory.GetSchema(std::type_index(typeid(instance)));
+            size_t setIndex = schema ? FindSetIndex(columnSets, schema) : kNoSet;
+            if (setIndex == kNoSet) {
+                continue;
+            }
+
+            // Only the first component of a type, as GetComponent would find
+            const ColumnSet& set = columnSets[setIndex];
+            uint32_t& presence = stateWords[set.firstColumn * count + i];
+            if (presence & ComponentPresent) {
+                continue;
+            }
+            presence = ComponentPresent | (instance.IsActive() ? static_cast<uint32_t>(ComponentActive) : 0u);
+
+            componentImage.assign(schema->GetImageWords(), 0);
+            schema->InitImage(componentImage.data());
+            schema->CaptureComponent(instance, componentImage.data());
+
+            const uint8_t* imageBytes = reinterpret_cast<const uint8_t*>(componentImage.data());
+            for (size_t w = 0; w < set.wordsPerObject; ++w) {
+                std::memcpy(&stateWords[(set.firstColumn + 1 + w) * count + i], imageBytes + w * sizeof(uint32_t),
+                    sizeof(uint32_t));
+            }
+        }
+    }
+}
+
+size_t WorldSnapshot::Restore(Scene& scene) const {
+    size_t restored = 0;
+    std::vector<uint64_t> componentImage;
+
+    for (size_t i = 0; i < objectIds.size(); ++i) {
+        GameObject* gameObject = scene.FindGameObjectById(static_cast<size_t>(objectIds[i]));
+        if (!gameObject) continue;
+
+        for (const ColumnSet& set : columnSets) {
+            uint32_t componentFlags = GetComponentFlags(set, i);
+            if (!set.schema || !(componentFlags & ComponentPresent)) continue;
+
+            Component* target = nullptr;
+            for (auto& component : gameObject->GetAllComponents()) {
+                Component& instance = *component;
+                if (std::type_index(typeid(instance)) == set.schema->GetTypeIndex()) {
+                    target = &instance;
+                    break;
+                }
+            }
+            if (!target) continue;
+
+            componentImage.assign(set.schema->GetImageWords(), 0);
+            ReadComponentImage(set, i, componentImage.data());
+            set.schema->ApplyToComponent(*target, componentImage.data());
+            target->SetActive((componentFlags & ComponentActive) != 0);
+        }
+
+        gameObject->SetActive((GetFlags(i) & ObjectActive) != 0);
+        restored++;
+    }
+
+    return restored;
+}
+
+const WorldSnapshot::ColumnSet* WorldSnapshot::FindColumnSet(const std::string& typeName) const {
+    for (const ColumnSet& set : columnSets) {
+        if (set.typeName == typeName) {
+            return &set;
+        }
+    }
+    return nullptr;
+}
+
+uint32_t WorldSnapshot::GetComponentFlags(const ColumnSet& set, size_t index) const {
+    return stateWords[set.firstColumn * objectIds.size() + index];
+}
+
+bool WorldSnapshot::ReadComponentImage(const ColumnSet& set, size_t index, void* image) const {
+    if (!(GetComponentFlags(set, index) & ComponentPresent)) return false;
+
+    size_t count = objectIds.size();
+    uint8_t* imageBytes = static_cast<uint8_t*>(image);
+    for (size_t w = 0; w < set.wordsPerObject; ++w) {
+        std::memcpy(imageBytes + w * sizeof(uint32_t), &stateWords[(set.firstColumn + 1 + w) * count + index],
+            sizeof(uint32_t));
+    }
+    return true;
+}
+
+void WorldSnapshot::Clear() {
+    frame = 0;
+    objectIds.clear();
+    columnSets.clear();
+    columnCount = 1;
+    stateWords.clear();
+}
+
+void WorldSnapshot::Resize(size_t objectCount) {
+    objectIds.resize(objectCount);
+    stateWords.resize(objectCount * columnCount);
+}
+
+void WorldSnapshot::LayoutColumns() {
+    columnCount = 1;
+    for (ColumnSet& set : columnSets) {
+        set.firstColumn = columnCount;
+        columnCount += 1 + set.wordsPerObject;
+    }
+}
+
+// ===== SnapshotCodec =====
+
+void SnapshotCodec::Encode(const WorldSnapshot& snapshot, const WorldSnapshot* base, std::vector<uint8_t>& out,
+    bool compress) {
+    bool keyframe = !base || !snapshot.HasSameLayout(*base);
+    const std::vector<uint32_t>& words = snapshot.GetStateWords();
+    size_t start = out.size();
+
+    out.reserve(out.size() + kHeaderSize + (keyframe ? snapshot.GetObjectCount() * sizeof(uint64_t) : 0));
+    out.insert(out.end(), kSnapshotMagic, kSnapshotMagic + sizeof(kSnapshotMagic));
+    AppendPod(out, keyframe ? kKeyframeFlag : 0u);
+    AppendPod(out, snapshot.GetFrame());
+    AppendPod(out, static_cast<uint32_t>(snapshot.GetObjectCount()));
+    AppendPod(out, static_cast<uint32_t>(words.size()));
+
+    if (keyframe) {
+        const std::vector<uint64_t>& ids = snapshot.GetObjectIds();
+        size_t offset = out.size();
+        out.resize(offset + ids.size() * sizeof(uint64_t));
+        if (!ids.empty()) {
+            std::memcpy(out.data() + offset, ids.data(), ids.size() * sizeof(uint64_t));
+        }
+
+        // Column sets by type name, resolved to schemas again on decode
+        AppendPod(out, static_cast<uint32_t>(snapshot.GetColumnSets().size()));
+        for (const WorldSnapshot::ColumnSet& set : snapshot.GetColumnSets()) {
+            AppendPod(out, set.wordsPerObject);
+            AppendPod(out, static_cast<uint32_t>(set.typeName.size()));
+            out.insert(out.end(), set.typeName.begin(), set.typeName.end());
+        }
+    }
+
+    EncodeWords(words.data(), keyframe ? nullptr : base->GetStateWords().data(), words.size(), out);
+
+    if (compress) {
+        size_t payloadStart = start + kHeaderSize;
+        std::vector<uint8_t> frame;
+        BlockCompression::CompressFrame(out.data() + payloadStart, out.size() - payloadStart, frame);
+
+        if (frame.size() < out.size() - payloadStart) {
+            out.resize(payloadStart);
+            out.insert(out.end(), frame.begin(), frame.end());
+
+            uint32_t flags = (keyframe ? kKeyframeFlag : 0u) | kCompressedFlag;
+            std::memcpy(out.data() + start + sizeof(kSnapshotMagic), &flags, sizeof(flags));
+        }
+    }
+}
+
+bool SnapshotCodec::Decode(const uint8_t* data, size_t size, const WorldSnapshot* base, WorldSnapshot& out) {
+    size_t offset = 0;
+    uint32_t flags = 0, objectCount = 0, wordCount = 0;
+    uint64_t frame = 0;
+
+    if (size < kHeaderSize || std::memcmp(data, kSnapshotMagic, sizeof(kSnapshotMagic)) != 0) {
+        std::cerr << "Invalid snapshot data" << std::endl;
+        return false;
+    }
+    offset += sizeof(kSnapshotMagic);
+
+    ReadPod(data, size, offset, flags);
+    ReadPod(data, size, offset, frame);
+    ReadPod(data, size, offset, objectCount);
+    ReadPod(data, size, offset, wordCount);
+
+    bool keyframe = (flags & kKeyframeFlag) != 0;
+    if (!keyframe && (!base || base->GetObjectCount() != objectCount || &out == base)) {
+        std::cerr << "Snapshot delta needs its base snapshot" << std::endl;
+        return false;
+    }
+
+    // Continue on the expanded payload
+    std::vector<uint8_t> payload;
+    if (flags & kCompressedFlag) {
+        if (!BlockCompression::DecompressFrame(data + offset, size - offset, payload)) {
+            std::cerr << "Corrupt compressed snapshot" << std::endl;
+            return false;
+        }
+        data = payload.data();
+        size = payload.size();
+        offset = 0;
+    }
+
+    out.frame = frame;
+
+    if (keyframe) {
+        if (static_cast<size_t>(objectCount) * sizeof(uint64_t) > size - offset) return false;
+        out.objectIds.resize(objectCount);
+        if (objectCount > 0) {
+            std::memcpy(out.objectIds.data(), data + offset, objectCount * sizeof(uint64_t));
+        }
+        offset += objectCount * sizeof(uint64_t);
+
+        uint32_t setCount = 0;
+        if (!ReadPod(data, size, offset, setCount) || setCount > (size - offset) / (2 * sizeof(uint32_t))) {
+            std::cerr << "Corrupt snapshot column sets" << std::endl;
+            return false;
+        }
+
+        const ComponentFactory& componentFactory = ComponentFactory::GetInstance();
+        out.columnSets.resize(setCount);
+        for (WorldSnapshot::ColumnSet& set : out.columnSets) {
+            uint32_t nameLength = 0;
+            if (!ReadPod(data, size, offset, set.wordsPerObject) || !ReadPod(data, size, offset, nameLength) ||
+                nameLength > size - offset) {
+                std::cerr << "Corrupt snapshot column sets" << std::endl;
+                return false;
+            }
+            set.typeName.assign(reinterpret_cast<const char*>(data + offset), nameLength);
+            offset += nameLength;
+
+            // Sets whose schema is gone or changed shape still decode, but restore skips them
+            set.schema = componentFactory.GetSchema(set.typeName);
+            if (set.schema && (set.schema->GetImageSize() + sizeof(uint32_t) - 1) / sizeof(uint32_t) != set.wordsPerObject) {
+                set.schema = nullptr;
+            }
+        }
+        out.LayoutColumns();
+    }
+    else {
+        out.objectIds = base->objectIds;
+        out.columnSets = base->columnSets;
+        out.columnCount = base->columnCount;
+    }
+
+    if (wordCount % out.columnCount != 0 || wordCount / out.columnCount != objectCount) {
+        std::cerr << "Corrupt snapshot header" << std::endl;
+        return false;
+    }
+    out.stateWords.resize(wordCount);
+
+    if (!DecodeWords(data, size, offset, keyframe ? nullptr : base->stateWords.data(), out.stateWords.data(), wordCount)) {
+        std::cerr << "Corrupt snapshot payload" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool SnapshotCodec::IsKeyframe(const uint8_t* data, size_t size) {
+    if (size < kHeaderSize) return false;
+    uint32_t flags;
+    std::memcpy(&flags, data + sizeof(kSnapshotMagic), sizeof(flags));
+    return (flags & kKeyframeFlag) != 0;
+}
+
+// ===== SnapshotHistory =====
+
+SnapshotHistory::SnapshotHistory(size_t maxFrames, size_t keyframeEvery)
+    : capacity(std::max(maxFrames, static_cast<size_t>(1)))
+    , keyframeInterval(std::max(keyframeEvery, static_cast<size_t>(1))) {
+}
+
+void SnapshotHistory::Record(const Scene& scene, uint64_t frameNumber) {
+    scratch.Capture(scene, frameNumber);
+
+    bool forceKeyframe = !hasLast || framesSinceKeyframe + 1 >= keyframeInterval;
+
+    Entry entry;
+    entry.frame = frameNumber;
+    SnapshotCodec::Encode(scratch, forceKeyframe ? nullptr : &lastSnapshot, entry.bytes, compressFrames);
+    entry.keyframe = SnapshotCodec::IsKeyframe(entry.bytes.data(), entry.bytes.size());
+
+    framesSinceKeyframe = entry.keyframe ? 0 : framesSinceKeyframe + 1;
+    totalBytes += entry.bytes.size();
+    entries.push_back(std::move(entry));
+
+    std::swap(lastSnapshot, scratch);
+    hasLast = true;
+
+    TrimToCapacity();
+}
+
+bool SnapshotHistory::GetSnapshot(uint64_t frameNumber, WorldSnapshot& out) const {
+    auto target = std::find_if(entries.begin(), entries.end(), [frameNumber](const Entry& entry) {
+        return entry.frame == frameNumber;
+        });
+    if (target == entries.end()) return false;
+
+    // Walk back to the keyframe the delta chain starts from
+    auto keyframe = target;
+    while (!keyframe->keyframe) {
+        if (keyframe == entries.begin()) return false;
+        --keyframe;
+    }
+
+    WorldSnapshot buffers[2];
+    size_t current = 0;
+    if (!SnapshotCodec::Decode(keyframe->bytes.data(), keyframe->bytes.size(), nullptr, buffers[current])) {
+        return false;
+    }
+
+    for (auto it = keyframe + 1; it != target + 1; ++it) {
+        size_t next = current ^ 1;
+        if (!SnapshotCodec::Decode(it->bytes.data(), it->bytes.size(), &buffers[current], buffers[next])) {
+            return false;
+        }
+        current = next;
+    }
+
+    out = std::move(buffers[current]);
+    return true;
+}
+
+bool SnapshotHistory::Rollback(Scene& scene, uint64_t frameNumber) {
+    WorldSnapshot snapshot;
+    if (!GetSnapshot(frameNumber, snapshot)) {
+        std::cerr << "Snapshot not available for frame: " << frameNumber << std::endl;
+        return false;
+    }
+
+    snapshot.Restore(scene);
+
+    // Frames after the rollback point are no longer valid history
+    while (!entries.empty() && entries.back().frame != frameNumber) {
+        totalBytes -= entries.back().bytes.size();
+        entries.pop_back();
+    }
+
+    framesSinceKeyframe = 0;
+    for (auto it = entries.rbegin(); it != entries.rend() && !it->keyframe; ++it) {
+        framesSinceKeyframe++;
+    }
+
+    lastSnapshot = std::move(snapshot);
+    hasLast = true;
+    return true;
+}
+
+void SnapshotHistory::Clear() {
+    entries.clear();
+    lastSnapshot.Clear();
+    hasLast = false;
+    framesSinceKeyframe = 0;
+    totalBytes = 0;
+}
+
+bool SnapshotHistory::HasFrame(uint64_t frameNumber) const {
+    return std::any_of(entries.begin(), entries.end(), [frameNumber](const Entry& entry) {
+        return entry.frame == frameNumber;
+        });
+}
+
+void SnapshotHistory::TrimToCapacity() {
+    if (entries.size() <= capacity) return;
+
+    // Deltas are useless without their keyframe, so drop whole chains
+    do {
+        totalBytes -= entries.front().bytes.size();
+        entries.pop_front();
+    } while (!entries.empty() && !entries.front().keyframe);
+}
@@ -115,7 +115,13 @@ std::vector<Component*> ComponentManager::GetComponentsOfType(const std::string&
 
 // Component registration for tracking
 void ComponentManager::RegisterComponentInstance(Component* component) {
-    if (!component) return;
+    if (!component || component->IsTracked()) return;
+
+    component->SetTracked(true);
+    ++instanceCount;
+    if (component->IsActive()) {
+        activeInstanceCount.fetch_add(1, std::memory_order_relaxed);
+    }
 
     std::type_index typeIndex = std::type_index(typeid(*component));
 
@@ -129,7 +135,13 @@ void ComponentManager::RegisterComponentInstance(Component* component) {
 }
 
 void ComponentManager::UnregisterComponentInstance(Component* component) {
-    if (!component) return;
+    if (!component || !component->IsTracked()) return;
+
+    component->SetTracked(false);
+    --instanceCount;
+    if (component->IsActive()) {
+        activeInstanceCount.fetch_sub(1, std::memory_order_relaxed);
+    }
 
     std::type_index typeIndex = std::type_index(typeid(*component));
 
@@ -171,19 +183,18 @@ void ComponentManager::RefreshComponentCache() {
     componentsDirty = false;
 }
 
-// Component statistics
-size_t ComponentManager::GetActiveComponentCount() const {
-    size_t count = 0;
-    for (const auto& pair : componentsByType) {
-        for (Component* component : pair.second) {
-            if (component && component->IsActive()) {
-                count++;
-            }
-        }
+void ComponentManager::OnInstanceActiveChanged(bool isActive) {
+    if (!instance) return;
+
+    if (isActive) {
+        instance->activeInstanceCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    else {
+        instance->activeInstanceCount.fetch_sub(1, std::memory_order_relaxed);
     }
-    return count;
 }
 
+// Component statistics
 size_t ComponentManager::GetComponentCountOfType(const std::type_index& typeIndex) const {
     auto it = componentsByType.find(typeIndex);
     if (it != componentsByType.end()) {
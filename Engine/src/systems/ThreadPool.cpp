@@ -3,6 +3,7 @@
 #include "../include/components/Behavior.h"
 #include <iostream>
 #include <algorithm>
+#include <exception>
 
 ThreadPool::ThreadPool(size_t threads) : numThreads(threads) {
     // Ensure we have at least 1 thread
@@ -158,6 +159,39 @@ size_t ThreadPool::CalculateOptimalBatchSize(size_t totalItems) const {
     return batchSize;
 }
 
+void ParallelFor(ThreadPool* pool, size_t count, size_t chunkCount, const std::function<void(size_t, size_t)>& work) {
+    chunkCount = std::min(chunkCount, count);
+    if (!pool || chunkCount < 2) {
+        work(0, count);
+        return;
+    }
+
+    size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+
+    std::vector<std::future<void>> futures;
+    futures.reserve(chunkCount - 1);
+    for (size_t begin = chunkSize; begin < count; begin += chunkSize) {
+        futures.push_back(pool->Enqueue(work, begin, std::min(begin + chunkSize, count)));
+    }
+
+    std::exception_ptr error;
+    try {
+        work(0, chunkSize);
+    }
+    catch (...) {
+        error = std::current_exception();
+    }
+    for (auto& future : futures) {
+        future.wait();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    for (auto& future : futures) {
+        future.get();
+    }
+}
+
 // Specialized batch processing functions
 namespace BatchProcessing {
 
@@ -219,6 +219,11 @@ static void PrintRealTimeStats() {
         << " (Avg: " << stats.averageFPS << ")" << std::endl;
     std::cout << "Frame Time: " << std::setprecision(2) << stats.frameTime
         << "ms (Avg: " << stats.averageFrameTime << "ms)" << std::endl;
+
+    // The histograms are safe to read while the engine thread records
+    FrameTimeSummary frameTimes = ENGINE.GetFrameTimes(FramePhase::Frame).GetWindowSummary();
+    std::cout << "Frame Time p50/p99/p99.9: " << frameTimes.p50 << " / " << frameTimes.p99
+        << " / " << frameTimes.p999 << "ms (" << frameTimes.spikes << " over budget)" << std::endl;
     std::cout << "Active GameObjects: " << stats.activeGameObjects << std::endl;
     std::cout << "Active Components: " << stats.activeComponents << std::endl;
     std::cout << "Memory Usage: " << stats.memoryUsage << " bytes" << std::endl;
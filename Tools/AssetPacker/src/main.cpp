@@ -0,0 +1,99 @@
+#include "io/AssetArchive.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+// AssetPacker: builds and inspects asset archives
+//
+//   AssetPacker pack <archive> <directory>... [--ext .template] [--prefix path/] [--compress]
+//   AssetPacker list <archive>
+
+namespace {
+    void PrintUsage() {
+        std::cout << "Usage:" << std::endl;
+        std::cout << "  AssetPacker pack <archive> <directory>... [--ext <extension>] [--prefix <path>] [--compress]" << std::endl;
+        std::cout << "  AssetPacker list <archive>" << std::endl;
+    }
+
+    int Pack(const std::vector<std::string>& args) {
+        std::string archivePath;
+        std::vector<std::string> directories;
+        std::string extension;
+        std::string prefix;
+        bool compress = false;
+
+        for (size_t i = 0; i < args.size(); ++i) {
+            if (args[i] == "--compress") {
+                compress = true;
+            }
+            else if ((args[i] == "--ext" || args[i] == "--prefix") && i + 1 < args.size()) {
+                (args[i] == "--ext" ? extension : prefix) = args[i + 1];
+                ++i;
+            }
+            else if (archivePath.empty()) {
+                archivePath = args[i];
+            }
+            else {
+                directories.push_back(args[i]);
+            }
+        }
+
+        if (archivePath.empty() || directories.empty()) {
+            PrintUsage();
+            return 1;
+        }
+
+        AssetArchiveBuilder builder;
+        for (const std::string& directory : directories) {
+            size_t added = builder.AddDirectory(directory, prefix, extension, compress);
+            std::cout << "Added " << added << " files from " << directory << std::endl;
+        }
+
+        if (!builder.Write(archivePath)) {
+            return 1;
+        }
+
+        std::cout << "Wrote " << archivePath << ": " << builder.GetEntryCount() << " entries, "
+            << builder.GetBytesIn() << " bytes in, " << builder.GetBytesStored() << " bytes stored ("
+            << builder.GetEntriesCompressed() << " compressed)" << std::endl;
+        return 0;
+    }
+
+    int List(const std::vector<std::string>& args) {
+        if (args.size() != 1) {
+            PrintUsage();
+            return 1;
+        }
+
+        AssetArchive archive;
+        if (!archive.Open(args[0])) {
+            return 1;
+        }
+
+        std::vector<const ArchiveEntry*> entries = archive.FindByExtension("");
+        for (const ArchiveEntry* entry : entries) {
+            std::cout << std::setw(12) << entry->size << std::setw(12) << entry->storedSize
+                << (entry->compression == ArchiveEntry::Block ? "  lz  " : "      ")
+                << archive.GetEntryPath(*entry) << std::endl;
+        }
+        std::cout << archive.GetEntryCount() << " entries" << std::endl;
+        return 0;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        PrintUsage();
+        return 1;
+    }
+
+    std::string command = argv[1];
+    std::vector<std::string> args(argv + 2, argv + argc);
+
+    if (command == "pack") return Pack(args);
+    if (command == "list") return List(args);
+
+    PrintUsage();
+    return 1;
+}